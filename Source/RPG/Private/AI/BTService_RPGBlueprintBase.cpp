@@ -0,0 +1,17 @@
+// Copyright Druid Mechanics
+
+#include "AI/BTService_RPGBlueprintBase.h"
+#include "AI/RPGAISignificanceSubsystem.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+
+void UBTService_RPGBlueprintBase::ScheduleNextTick(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	Super::ScheduleNextTick(OwnerComp, NodeMemory);
+
+	// OTIMIZAÇÃO: IAs menos relevantes rodam o serviço mais espaçado; o BT reagenda o próprio tick a partir daqui
+	const float IntervalScale = URPGAISignificanceSubsystem::GetServiceIntervalScale(OwnerComp);
+	if (IntervalScale > 1.f)
+	{
+		SetNextTickTime(NodeMemory, GetNextTickRemainingTime(NodeMemory) * IntervalScale);
+	}
+}
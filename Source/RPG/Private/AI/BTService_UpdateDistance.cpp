@@ -2,70 +2,70 @@
 
 
 #include "AI/BTService_UpdateDistance.h"
+#include "AI/RPGAIDistanceSubsystem.h"
+#include "AI/RPGBlackboardKeys.h"
+#include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
 #include "AIController.h"
-#include "Engine/Engine.h"
 
 UBTService_UpdateDistance::UBTService_UpdateDistance()
 {
 	NodeName = "Update Distance To Target";
+
+	// OTIMIZAÇÃO: sem TickNode por IA; o subsistema processa todos os pares de uma vez
+	bNotifyTick = false;
+	bNotifyBecomeRelevant = true;
+	bNotifyCeaseRelevant = true;
+
+	TargetActorSelector.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_UpdateDistance, TargetActorSelector), AActor::StaticClass());
+	DistanceToTargetSelector.AddFloatFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_UpdateDistance, DistanceToTargetSelector));
+	DirectionToTargetSelector.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_UpdateDistance, DirectionToTargetSelector));
+	ClosingSpeedSelector.AddFloatFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_UpdateDistance, ClosingSpeedSelector));
+	DirectionToTargetSelector.AllowNoneAsValue(true);
+	ClosingSpeedSelector.AllowNoneAsValue(true);
 }
 
-void UBTService_UpdateDistance::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+void UBTService_UpdateDistance::InitializeFromAsset(UBehaviorTree& Asset)
 {
-	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
-	
-	DebugTimer += DeltaSeconds;
+	Super::InitializeFromAsset(Asset);
 
-	UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
-	if (Blackboard == nullptr)
+	if (const UBlackboardData* BBAsset = GetBlackboardAsset())
 	{
-		return;
+		TargetActorSelector.ResolveSelectedKey(*BBAsset);
+		DistanceToTargetSelector.ResolveSelectedKey(*BBAsset);
+		DirectionToTargetSelector.ResolveSelectedKey(*BBAsset);
+		ClosingSpeedSelector.ResolveSelectedKey(*BBAsset);
 	}
+}
 
-	AActor* TargetActor = Cast<AActor>(Blackboard->GetValueAsObject(TargetActorSelector.SelectedKeyName));
+void UBTService_UpdateDistance::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	Super::OnBecomeRelevant(OwnerComp, NodeMemory);
+
+	UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
 	AAIController* AIController = OwnerComp.GetAIOwner();
-	
-	if (TargetActor && AIController && AIController->GetPawn())
-	{
-		// Alvo direto disponível
-		const float Distance = AIController->GetPawn()->GetDistanceTo(TargetActor);
-		Blackboard->SetValueAsFloat(DistanceToTargetSelector.SelectedKeyName, Distance);
-		
-		if (GEngine && DebugTimer > 1.f)
-		{
-			GEngine->AddOnScreenDebugMessage(
-				1,
-				2.f, // Display for 2 seconds
-				FColor::Yellow, 
-				FString::Printf(TEXT("Distance to %s: %f"), *TargetActor->GetName(), Distance)
-			);
-			DebugTimer = 0.f;
-		}
-	}
-	else
+	if (!Blackboard || !AIController) return;
+
+	URPGAIDistanceSubsystem* DistanceSubsystem = OwnerComp.GetWorld() ? OwnerComp.GetWorld()->GetSubsystem<URPGAIDistanceSubsystem>() : nullptr;
+	if (!DistanceSubsystem) return;
+
+	FRPGAIDistanceKeys Keys;
+	Keys.TargetActorKey = TargetActorSelector.GetSelectedKeyID();
+	Keys.LastKnownLocationKey = FRPGBlackboardKeys::Get(Blackboard->GetBlackboardAsset()).LastKnownLocation;
+	Keys.DistanceKey = DistanceToTargetSelector.GetSelectedKeyID();
+	Keys.DirectionToTargetKey = DirectionToTargetSelector.GetSelectedKeyID();
+	Keys.ClosingSpeedKey = ClosingSpeedSelector.GetSelectedKeyID();
+
+	DistanceSubsystem->RegisterController(Blackboard, AIController, Keys, this, Interval, RandomDeviation);
+}
+
+void UBTService_UpdateDistance::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	if (URPGAIDistanceSubsystem* DistanceSubsystem = OwnerComp.GetWorld() ? OwnerComp.GetWorld()->GetSubsystem<URPGAIDistanceSubsystem>() : nullptr)
 	{
-		// Verificar se há uma localização conhecida do alvo
-		FVector LastKnownLocation = Blackboard->GetValueAsVector(TEXT("LastKnownLocation"));
-		if (LastKnownLocation != FVector::ZeroVector && AIController && AIController->GetPawn())
-		{
-			const float Distance = FVector::Dist(AIController->GetPawn()->GetActorLocation(), LastKnownLocation);
-			Blackboard->SetValueAsFloat(DistanceToTargetSelector.SelectedKeyName, Distance);
-			
-			if (GEngine && DebugTimer > 1.f)
-			{
-				GEngine->AddOnScreenDebugMessage(
-					1,
-					2.f, // Display for 2 seconds
-					FColor::Orange, 
-					FString::Printf(TEXT("Distance to LastKnownLocation: %f"), Distance)
-				);
-				DebugTimer = 0.f;
-			}
-		}
-		else
-		{
-			Blackboard->ClearValue(DistanceToTargetSelector.SelectedKeyName);
-		}
+		DistanceSubsystem->UnregisterController(OwnerComp.GetBlackboardComponent(), this);
 	}
-} 
\ No newline at end of file
+
+	Super::OnCeaseRelevant(OwnerComp, NodeMemory);
+}
@@ -3,11 +3,20 @@
 #include "AbilitySystemInterface.h"
 #include "AbilitySystem/Core/RPGAbilitySystemComponent.h"
 #include "AIController.h"
+#include "Abilities/GameplayAbility.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 UBTTask_PressInputTag::UBTTask_PressInputTag()
 {
     NodeName = TEXT("Press Input Tag");
-    bNotifyTick = true;
+
+    // OTIMIZAÇÃO: sem TickTask; transições por timers e callbacks do ASC.
+    // Instanciado por IA para guardar os handles de timer/delegate da execução
+    bNotifyTick = false;
+    bNotifyTaskFinished = true;
+    bCreateNodeInstance = true;
     
     // Valores padrão baseados em comportamento humano real:
     // - Tempo de pressão do botão: ~0.05s (50ms) - tempo que um dedo fica pressionando
@@ -36,138 +45,212 @@ UAbilitySystemComponent* UBTTask_PressInputTag::ResolveASC(const UBehaviorTreeCo
 
 EBTNodeResult::Type UBTTask_PressInputTag::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
-    FTaskMemory* Mem = (FTaskMemory*)NodeMemory;
-    Mem->Elapsed = 0.f;
-    Mem->bPressedSent = false;
-    Mem->ClicksDone = 0;
-    Mem->State = FTaskMemory::EState::Holding;
-
     if (!InputTag.IsValid())
     {
         return EBTNodeResult::Failed;
     }
 
-    if (URPGAbilitySystemComponent* ASC = Cast<URPGAbilitySystemComponent>(ResolveASC(OwnerComp)))
+    URPGAbilitySystemComponent* ASC = Cast<URPGAbilitySystemComponent>(ResolveASC(OwnerComp));
+    if (!ASC)
     {
-        // Iniciar primeiro clique
-        ASC->AbilityInputTagPressed(InputTag);
-        Mem->bPressedSent = true;
-        return EBTNodeResult::InProgress;
+        return EBTNodeResult::Failed;
     }
 
-    return EBTNodeResult::Failed;
+    OwnerCompPtr = &OwnerComp;
+    ASCPtr = ASC;
+    ClicksDone = 0;
+
+    // OTIMIZAÇÃO: fim/cancelamento da habilidade chega por callback em vez de polling por frame
+    AbilityActivatedHandle = ASC->AbilityActivatedCallbacks.AddUObject(this, &UBTTask_PressInputTag::HandleAbilityActivated);
+    AbilityEndedHandle = ASC->OnAbilityEnded.AddUObject(this, &UBTTask_PressInputTag::HandleAbilityEnded);
+
+    // Iniciar primeiro clique
+    PressClick();
+    return EBTNodeResult::InProgress;
+}
+
+void UBTTask_PressInputTag::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+    // Cobre também o abort da task pela BT
+    ClearTimersAndDelegates();
+    Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
 }
 
-void UBTTask_PressInputTag::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+void UBTTask_PressInputTag::PressClick()
 {
-    FTaskMemory* Mem = (FTaskMemory*)NodeMemory;
-    if (!Mem->bPressedSent)
+    URPGAbilitySystemComponent* ASC = ASCPtr.Get();
+    if (!ASC)
     {
-        FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+        Finish(EBTNodeResult::Failed);
         return;
     }
 
-    Mem->Elapsed += DeltaSeconds;
+    ASC->AbilityInputTagPressed(InputTag);
+    State = EPressState::Holding;
+    ScheduleStep(StepTimerHandle, HoldTimeSeconds, &UBTTask_PressInputTag::HandleHoldElapsed);
+}
+
+void UBTTask_PressInputTag::HandleHoldElapsed()
+{
+    URPGAbilitySystemComponent* ASC = ASCPtr.Get();
 
-    switch (Mem->State)
+    // Transita para Releasing para dar tempo à habilidade processar
+    if (bReleaseOnFinish && ASC)
     {
-    case FTaskMemory::EState::Holding:
-        if (HoldTimeSeconds <= 0.f || Mem->Elapsed >= HoldTimeSeconds)
-        {
-            // Transita para Releasing para dar tempo à habilidade processar
-            if (bReleaseOnFinish)
-            {
-                if (URPGAbilitySystemComponent* ASC = Cast<URPGAbilitySystemComponent>(ResolveASC(OwnerComp)))
-                {
-                    ASC->AbilityInputTagReleased(InputTag);
-                }
-            }
-            Mem->State = FTaskMemory::EState::Releasing;
-            Mem->Elapsed = 0.f;
-        }
-        break;
-    case FTaskMemory::EState::Releasing:
-        // Verificar se a habilidade realmente terminou antes de continuar
-        if (URPGAbilitySystemComponent* ASC = Cast<URPGAbilitySystemComponent>(ResolveASC(OwnerComp)))
-        {
-            if (!ASC->HasActiveAbilityWithInputTag(InputTag))
-            {
-                // Habilidade terminou, pode continuar
-                Mem->State = FTaskMemory::EState::Gap;
-                Mem->Elapsed = 0.f;
-            }
-            else if (bAutoDetectCombo && Mem->Elapsed >= ComboDetectionDelay)
-            {
-                // Para combos: se habilidade ainda está ativa após delay, assumir que há combo disponível
-                // Reenviar input para continuar o combo
-                ASC->AbilityInputTagPressed(InputTag);
-                Mem->State = FTaskMemory::EState::WaitingForCombo;
-                Mem->Elapsed = 0.f;
-                Mem->bWaitingForCombo = true;
-            }
-            else if (Mem->Elapsed >= 1.0f) // Timeout de 1 segundo para evitar travamento
-            {
-                // Timeout - forçar continuação mesmo se habilidade não terminou
-                Mem->State = FTaskMemory::EState::Gap;
-                Mem->Elapsed = 0.f;
-            }
-        }
-        else
-        {
-            // ASC não encontrado, continuar
-            Mem->State = FTaskMemory::EState::Gap;
-            Mem->Elapsed = 0.f;
-        }
-        break;
-    case FTaskMemory::EState::WaitingForCombo:
-        // Continuar enviando input enquanto a habilidade estiver ativa (para combos)
-        if (Mem->Elapsed >= 0.15f) // Delay entre cada tentativa de input
-        {
-            if (URPGAbilitySystemComponent* ASC = Cast<URPGAbilitySystemComponent>(ResolveASC(OwnerComp)))
-            {
-                if (ASC->HasActiveAbilityWithInputTag(InputTag))
-                {
-                    // Ainda há habilidade ativa, reenviar input para continuar combo
-                    ASC->AbilityInputTagPressed(InputTag);
-                    Mem->Elapsed = 0.f; // Resetar timer para próxima tentativa
-                    // Continuar no mesmo estado para tentar novamente se necessário
-                }
-                else
-                {
-                    // Habilidade terminou, pode continuar
-                    Mem->State = FTaskMemory::EState::Gap;
-                    Mem->Elapsed = 0.f;
-                    Mem->bWaitingForCombo = false;
-                }
-            }
-            else
-            {
-                Mem->State = FTaskMemory::EState::Gap;
-                Mem->Elapsed = 0.f;
-                Mem->bWaitingForCombo = false;
-            }
-        }
-        break;
-    case FTaskMemory::EState::Gap:
-        if (Mem->Elapsed >= InterClickDelaySeconds)
+        ASC->AbilityInputTagReleased(InputTag);
+    }
+    State = EPressState::Releasing;
+
+    // Habilidade já terminou (ou nem ativou): seguir direto para o intervalo
+    if (!ASC || !ASC->HasActiveAbilityWithInputTag(InputTag))
+    {
+        EnterGap();
+        return;
+    }
+
+    // Até a habilidade terminar, nada roda; só os timers de combo e de timeout
+    if (bAutoDetectCombo)
+    {
+        ScheduleStep(StepTimerHandle, ComboDetectionDelay, &UBTTask_PressInputTag::HandleComboCheck);
+    }
+    ScheduleStep(ReleaseTimeoutHandle, RELEASE_TIMEOUT, &UBTTask_PressInputTag::HandleReleaseTimeout);
+}
+
+void UBTTask_PressInputTag::HandleComboCheck()
+{
+    URPGAbilitySystemComponent* ASC = ASCPtr.Get();
+    if (!ASC || !ASC->HasActiveAbilityWithInputTag(InputTag))
+    {
+        EnterGap();
+        return;
+    }
+
+    // Para combos: se habilidade ainda está ativa após o delay, reenviar input para continuar o combo
+    ASC->AbilityInputTagPressed(InputTag);
+
+    if (State != EPressState::WaitingForCombo)
+    {
+        // Em combo não há timeout: o fim da habilidade encerra a espera
+        State = EPressState::WaitingForCombo;
+        if (UWorld* World = GetWorld())
         {
-            Mem->ClicksDone += 1;
-            if (Mem->ClicksDone >= FMath::Max(1, Clicks))
-            {
-                FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
-                return;
-            }
-            // Iniciar próximo clique
-            if (URPGAbilitySystemComponent* ASC = Cast<URPGAbilitySystemComponent>(ResolveASC(OwnerComp)))
-            {
-                ASC->AbilityInputTagPressed(InputTag);
-            }
-            Mem->State = FTaskMemory::EState::Holding;
-            Mem->Elapsed = 0.f;
+            World->GetTimerManager().ClearTimer(ReleaseTimeoutHandle);
         }
-        break;
-    default:
-        break;
+        ScheduleStep(StepTimerHandle, COMBO_RETRY_INTERVAL, &UBTTask_PressInputTag::HandleComboCheck, true);
+    }
+}
+
+void UBTTask_PressInputTag::HandleReleaseTimeout()
+{
+    // Timeout para evitar travamento: forçar continuação mesmo se habilidade não terminou
+    if (State == EPressState::Releasing)
+    {
+        EnterGap();
+    }
+}
+
+void UBTTask_PressInputTag::EnterGap()
+{
+    State = EPressState::Gap;
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(ReleaseTimeoutHandle);
+    }
+    ScheduleStep(StepTimerHandle, InterClickDelaySeconds, &UBTTask_PressInputTag::HandleGapElapsed);
+}
+
+void UBTTask_PressInputTag::HandleGapElapsed()
+{
+    ClicksDone += 1;
+    if (ClicksDone >= FMath::Max(1, Clicks))
+    {
+        Finish(EBTNodeResult::Succeeded);
+        return;
+    }
+
+    // Iniciar próximo clique
+    PressClick();
+}
+
+void UBTTask_PressInputTag::HandleAbilityActivated(UGameplayAbility* Ability)
+{
+    // Próximo golpe do combo ativou: reiniciar a contagem até o próximo reenvio
+    if (State == EPressState::WaitingForCombo && Ability && IsInputTagAbility(Ability->GetCurrentAbilitySpecHandle()))
+    {
+        ScheduleStep(StepTimerHandle, COMBO_RETRY_INTERVAL, &UBTTask_PressInputTag::HandleComboCheck, true);
+    }
+}
+
+void UBTTask_PressInputTag::HandleAbilityEnded(const FAbilityEndedData& EndedData)
+{
+    if (State != EPressState::Releasing && State != EPressState::WaitingForCombo) return;
+    if (!IsInputTagAbility(EndedData.AbilitySpecHandle)) return;
+
+    // Fim ou cancelamento: só avança quando nenhuma habilidade da InputTag continua ativa
+    const URPGAbilitySystemComponent* ASC = ASCPtr.Get();
+    if (!ASC || !ASC->HasActiveAbilityWithInputTag(InputTag))
+    {
+        EnterGap();
+    }
+}
+
+bool UBTTask_PressInputTag::IsInputTagAbility(const FGameplayAbilitySpecHandle& SpecHandle) const
+{
+    const URPGAbilitySystemComponent* ASC = ASCPtr.Get();
+    const FGameplayAbilitySpec* Spec = ASC ? ASC->FindAbilitySpecFromHandle(SpecHandle) : nullptr;
+    return Spec && Spec->GetDynamicSpecSourceTags().HasTagExact(InputTag);
+}
+
+void UBTTask_PressInputTag::ScheduleStep(FTimerHandle& Handle, float Delay, void (UBTTask_PressInputTag::*Callback)(), bool bLoop)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        Finish(EBTNodeResult::Failed);
+        return;
+    }
+
+    FTimerManager& TimerManager = World->GetTimerManager();
+    TimerManager.ClearTimer(Handle);
+
+    const FTimerDelegate Delegate = FTimerDelegate::CreateUObject(this, Callback);
+    if (Delay > 0.f)
+    {
+        TimerManager.SetTimer(Handle, Delegate, Delay, bLoop);
+    }
+    else
+    {
+        Handle = TimerManager.SetTimerForNextTick(Delegate);
+    }
+}
+
+void UBTTask_PressInputTag::ClearTimersAndDelegates()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(StepTimerHandle);
+        World->GetTimerManager().ClearTimer(ReleaseTimeoutHandle);
+    }
+
+    if (URPGAbilitySystemComponent* ASC = ASCPtr.Get())
+    {
+        ASC->AbilityActivatedCallbacks.Remove(AbilityActivatedHandle);
+        ASC->OnAbilityEnded.Remove(AbilityEndedHandle);
+    }
+    AbilityActivatedHandle.Reset();
+    AbilityEndedHandle.Reset();
+    ASCPtr.Reset();
+}
+
+void UBTTask_PressInputTag::Finish(EBTNodeResult::Type Result)
+{
+    UBehaviorTreeComponent* OwnerComp = OwnerCompPtr.Get();
+    ClearTimersAndDelegates();
+    OwnerCompPtr.Reset();
+
+    if (OwnerComp)
+    {
+        FinishLatentTask(*OwnerComp, Result);
     }
 }
 
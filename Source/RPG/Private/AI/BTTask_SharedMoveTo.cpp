@@ -0,0 +1,180 @@
+// Copyright Druid Mechanics
+
+#include "AI/BTTask_SharedMoveTo.h"
+#include "AI/RPGPathSharingSubsystem.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "Engine/World.h"
+#include "Navigation/PathFollowingComponent.h"
+
+UBTTask_SharedMoveTo::UBTTask_SharedMoveTo()
+{
+	NodeName = TEXT("Shared Move To");
+
+	// OTIMIZAÇÃO: sem TickTask; caminho e chegada chegam por callback.
+	// Instanciado por IA para guardar os ids do pedido/movimento da execução
+	bNotifyTick = false;
+	bNotifyTaskFinished = true;
+	bCreateNodeInstance = true;
+
+	BlackboardKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_SharedMoveTo, BlackboardKey), AActor::StaticClass());
+	BlackboardKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_SharedMoveTo, BlackboardKey));
+}
+
+bool UBTTask_SharedMoveTo::ResolveGoal(const UBehaviorTreeComponent& OwnerComp, AActor*& OutGoalActor, FVector& OutGoalLocation) const
+{
+	const UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	if (!BlackboardComp) return false;
+
+	OutGoalActor = nullptr;
+	if (BlackboardKey.SelectedKeyType == UBlackboardKeyType_Object::StaticClass())
+	{
+		OutGoalActor = Cast<AActor>(BlackboardComp->GetValue<UBlackboardKeyType_Object>(BlackboardKey.GetSelectedKeyID()));
+		if (!OutGoalActor) return false;
+		OutGoalLocation = OutGoalActor->GetActorLocation();
+		return true;
+	}
+
+	OutGoalLocation = BlackboardComp->GetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID());
+	return FAISystem::IsValidLocation(OutGoalLocation);
+}
+
+EBTNodeResult::Type UBTTask_SharedMoveTo::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	AAIController* AI = OwnerComp.GetAIOwner();
+	const APawn* Pawn = AI ? AI->GetPawn() : nullptr;
+	UPathFollowingComponent* PathFollowing = AI ? AI->GetPathFollowingComponent() : nullptr;
+	URPGPathSharingSubsystem* PathSharing = GetWorld() ? GetWorld()->GetSubsystem<URPGPathSharingSubsystem>() : nullptr;
+	if (!Pawn || !PathFollowing || !PathSharing)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	AActor* Goal = nullptr;
+	FVector GoalLocation;
+	if (!ResolveGoal(OwnerComp, Goal, GoalLocation))
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	// Já no destino: não gasta consulta ao navmesh
+	if (FVector::Dist2D(Pawn->GetNavAgentLocation(), GoalLocation) <= AcceptableRadius)
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
+	OwnerCompPtr = &OwnerComp;
+	ControllerPtr = AI;
+	GoalActor = Goal;
+	MoveRequestId = FAIRequestID::InvalidRequest;
+
+	MoveFinishedHandle = PathFollowing->OnRequestFinished.AddUObject(this, &UBTTask_SharedMoveTo::HandleMoveFinished);
+	PathRequestId = PathSharing->RequestPath(AI, GoalLocation, FOnSharedPathReady::CreateUObject(this, &UBTTask_SharedMoveTo::HandlePathReady));
+	if (PathRequestId == 0)
+	{
+		ClearRequests(false);
+		return EBTNodeResult::Failed;
+	}
+	return EBTNodeResult::InProgress;
+}
+
+EBTNodeResult::Type UBTTask_SharedMoveTo::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	ClearRequests(true);
+	OwnerCompPtr.Reset();
+	return EBTNodeResult::Aborted;
+}
+
+void UBTTask_SharedMoveTo::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+	ClearRequests(false);
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+void UBTTask_SharedMoveTo::HandlePathReady(uint32 RequestId, FNavPathSharedPtr Path)
+{
+	if (RequestId != PathRequestId) return;
+	PathRequestId = 0;
+
+	AAIController* AI = ControllerPtr.Get();
+	if (!AI || !Path.IsValid() || !Path->IsValid())
+	{
+		Finish(EBTNodeResult::Failed);
+		return;
+	}
+
+	FAIMoveRequest MoveRequest;
+	MoveRequest.SetAcceptanceRadius(AcceptableRadius);
+	if (AActor* Goal = GoalActor.Get())
+	{
+		MoveRequest.SetGoalActor(Goal);
+		Path->SetGoalActorObservation(*Goal, 100.f);
+	}
+	else
+	{
+		MoveRequest.SetGoalLocation(Path->GetEndLocation());
+	}
+	Path->EnableRecalculationOnInvalidation(true);
+
+	MoveRequestId = AI->RequestMove(MoveRequest, Path);
+	if (!MoveRequestId.IsValid())
+	{
+		Finish(EBTNodeResult::Failed);
+	}
+}
+
+void UBTTask_SharedMoveTo::HandleMoveFinished(FAIRequestID RequestID, const FPathFollowingResult& Result)
+{
+	if (!MoveRequestId.IsValid() || !MoveRequestId.IsEquivalent(RequestID)) return;
+
+	MoveRequestId = FAIRequestID::InvalidRequest;
+	Finish(Result.IsSuccess() ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+}
+
+void UBTTask_SharedMoveTo::Finish(EBTNodeResult::Type Result)
+{
+	UBehaviorTreeComponent* OwnerComp = OwnerCompPtr.Get();
+	ClearRequests(false);
+	OwnerCompPtr.Reset();
+
+	if (OwnerComp)
+	{
+		FinishLatentTask(*OwnerComp, Result);
+	}
+}
+
+void UBTTask_SharedMoveTo::ClearRequests(bool bAbortMove)
+{
+	if (PathRequestId != 0)
+	{
+		if (URPGPathSharingSubsystem* PathSharing = GetWorld() ? GetWorld()->GetSubsystem<URPGPathSharingSubsystem>() : nullptr)
+		{
+			PathSharing->CancelRequest(PathRequestId);
+		}
+		PathRequestId = 0;
+	}
+
+	if (AAIController* AI = ControllerPtr.Get())
+	{
+		if (UPathFollowingComponent* PathFollowing = AI->GetPathFollowingComponent())
+		{
+			PathFollowing->OnRequestFinished.Remove(MoveFinishedHandle);
+			if (bAbortMove && MoveRequestId.IsValid())
+			{
+				PathFollowing->AbortMove(*this, FPathFollowingResultFlags::OwnerFinished, MoveRequestId);
+			}
+		}
+	}
+	MoveFinishedHandle.Reset();
+	MoveRequestId = FAIRequestID::InvalidRequest;
+	ControllerPtr.Reset();
+	GoalActor.Reset();
+}
+
+FString UBTTask_SharedMoveTo::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: %s (raio %.0f)"), *Super::GetStaticDescription(), *BlackboardKey.SelectedKeyName.ToString(), AcceptableRadius);
+}
@@ -2,6 +2,8 @@
 
 #include "AI/RPGAIController.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
+#include "AI/RPGBehaviorTreeComponent.h"
+#include "AI/RPGAIStressStats.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Character/RPGCharacter.h"
 #include "Perception/AIPerceptionComponent.h"
@@ -16,12 +18,18 @@
 #include "Character/RPGCharacterBase.h"
 #include "GenericTeamAgentInterface.h"
 #include "Character/RPGEnemy.h"
+#include "AI/RPGAISignificanceSubsystem.h"
+#include "AI/RPGBlackboardKeys.h"
+#include "AI/RPGPathSharingSubsystem.h"
+#include "AI/RPGSquadPerceptionSubsystem.h"
+#include "AI/RPGThreatSubsystem.h"
 
 
 ARPGAIController::ARPGAIController()
 {
 	Blackboard = CreateDefaultSubobject<UBlackboardComponent>("BlackboardComponent");
-	BehaviorTreeComponent = CreateDefaultSubobject<UBehaviorTreeComponent>("BehaviorTreeComponent");
+	BehaviorTreeComponent = CreateDefaultSubobject<URPGBehaviorTreeComponent>("BehaviorTreeComponent");
+	BrainComponent = BehaviorTreeComponent;
 
 	AIPerceptionComponent = CreateDefaultSubobject<UAIPerceptionComponent>("AIPerceptionComponent");
 	SetPerceptionComponent(*AIPerceptionComponent);
@@ -71,7 +79,7 @@ void ARPGAIController::SetTarget(ARPGCharacterBase* NewTarget)
 		TargetCharacter->GetOnDeathDelegate().AddDynamic(this, &ARPGAIController::HandleTargetDeath);
 	}
 	
-	GetBlackboardComponent()->SetValueAsObject(TEXT("TargetActor"), NewTarget);
+	RPGBlackboard::SetObject(GetBlackboardComponent(), GetBlackboardKeys().TargetActor, NewTarget);
 
 	// Atualizar o CombatTarget do inimigo com o novo alvo
 	if (ARPGEnemy* Enemy = Cast<ARPGEnemy>(GetPawn()))
@@ -81,7 +89,7 @@ void ARPGAIController::SetTarget(ARPGCharacterBase* NewTarget)
 		// Se há um alvo válido, atualizar a localização conhecida
 		if (IsValid(NewTarget))
 		{
-			GetBlackboardComponent()->SetValueAsVector(TEXT("LastKnownLocation"), NewTarget->GetActorLocation());
+			RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().LastKnownLocation, NewTarget->GetActorLocation());
 		}
 	}
 }
@@ -93,7 +101,7 @@ void ARPGAIController::ClearTarget()
 		TargetCharacter->GetOnDeathDelegate().RemoveAll(this);
 	}
 	TargetCharacter = nullptr;
-	GetBlackboardComponent()->ClearValue(TEXT("TargetActor"));
+	RPGBlackboard::Clear(GetBlackboardComponent(), GetBlackboardKeys().TargetActor);
 
 	// Limpar o CombatTarget do inimigo
 	if (ARPGEnemy* Enemy = Cast<ARPGEnemy>(GetPawn()))
@@ -105,7 +113,72 @@ void ARPGAIController::ClearTarget()
 void ARPGAIController::OnPossess(APawn* InPawn)
 {
 	Super::OnPossess(InPawn);
-	GetAIPerceptionComponent()->OnTargetPerceptionUpdated.AddDynamic(this, &ARPGAIController::OnTargetPerceptionUpdated);
+	GetAIPerceptionComponent()->OnTargetPerceptionUpdated.AddDynamic(this, &ARPGAIController::HandlePerceptionUpdated);
+
+	// OTIMIZAÇÃO: IDs das chaves resolvidos uma vez (o blackboard é inicializado no PossessedBy do pawn)
+	GetBlackboardKeys();
+
+	// OTIMIZAÇÃO: taxas de BT/percepção/movimento ajustadas pela distância até o membro ativo
+	if (URPGAISignificanceSubsystem* Significance = GetWorld()->GetSubsystem<URPGAISignificanceSubsystem>())
+	{
+		Significance->RegisterController(this);
+	}
+
+	// OTIMIZAÇÃO: inimigos com SquadId compartilham visão/audição do squad
+	if (const ARPGEnemy* Enemy = Cast<ARPGEnemy>(InPawn); Enemy && !Enemy->GetSquadId().IsNone())
+	{
+		if (URPGSquadPerceptionSubsystem* SquadPerception = GetWorld()->GetSubsystem<URPGSquadPerceptionSubsystem>())
+		{
+			SquadPerception->RegisterMember(Enemy->GetSquadId(), this);
+		}
+	}
+}
+
+void ARPGAIController::OnUnPossess()
+{
+	if (URPGThreatSubsystem* Threat = GetWorld()->GetSubsystem<URPGThreatSubsystem>())
+	{
+		ThreatTable.ForEachActor([this, Threat](const AActor* Actor) { Threat->UnregisterEngagement(this, Actor); });
+	}
+	ThreatTable.Reset();
+
+	if (URPGSquadPerceptionSubsystem* SquadPerception = GetWorld()->GetSubsystem<URPGSquadPerceptionSubsystem>())
+	{
+		SquadPerception->UnregisterMember(this);
+	}
+	if (URPGAISignificanceSubsystem* Significance = GetWorld()->GetSubsystem<URPGAISignificanceSubsystem>())
+	{
+		Significance->UnregisterController(this);
+	}
+	Super::OnUnPossess();
+}
+
+void ARPGAIController::FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const
+{
+	// OTIMIZAÇÃO: MoveTo de agentes com destinos próximos reaproveita o mesmo corredor
+	if (!URPGPathSharingSubsystem::FindPathForMoveRequest(this, MoveRequest, Query, OutPath))
+	{
+		Super::FindPathForMoveRequest(MoveRequest, Query, OutPath);
+	}
+}
+
+void ARPGAIController::HandlePerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
+{
+	RPG_AI_STRESS_SCOPE(Perception);
+	if (Stimulus.Type == UAISense::GetSenseID<UAISense_Hearing>())
+	{
+		if (URPGSquadPerceptionSubsystem* SquadPerception = GetWorld()->GetSubsystem<URPGSquadPerceptionSubsystem>())
+		{
+			SquadPerception->ShareHearingStimulus(this, Actor, Stimulus);
+		}
+	}
+	OnTargetPerceptionUpdated(Actor, Stimulus);
+}
+
+void ARPGAIController::ReceiveSquadStimulus(AActor* Actor, const FAIStimulus& Stimulus)
+{
+	RPG_AI_STRESS_SCOPE(Perception);
+	OnTargetPerceptionUpdated(Actor, Stimulus);
 }
 
 void ARPGAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
@@ -126,30 +199,18 @@ void ARPGAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stim
 			return;
 		}
 		
-        if (!IsValid(TargetCharacter))
-		{
-			// Verificar distância antes de definir o alvo
-			const float DistanceToTarget = FVector::Dist(GetPawn()->GetActorLocation(), RPGCharacter->GetActorLocation());
-			const float MaxDamageResponseDistance = 1000.0f; // Igual ao raio de visão para consistência
-			
-            // Não considerar alvos mortos
-            const bool bTargetAlive = !(RPGCharacter->Implements<UCombatInterface>() && ICombatInterface::Execute_IsDead(RPGCharacter));
-            if (DistanceToTarget <= MaxDamageResponseDistance && bTargetAlive)
-			{
-				SetTarget(RPGCharacter);
-			}
-		}
-		else
+		// A ameaça do dano já entrou pela tabela (URPGThreatSubsystem::ReportDamage)
+		if (IsValid(TargetCharacter))
 		{
 			// Se já tem um alvo, atualiza a LastKnownLocation com a posição do dano
-			GetBlackboardComponent()->SetValueAsVector(TEXT("LastKnownLocation"), RPGCharacter->GetActorLocation());
+			RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().LastKnownLocation, RPGCharacter->GetActorLocation());
 		}
 		return;
 	}
 
 	if (Stimulus.Type == UAISense::GetSenseID<UAISense_Hearing>())
 	{
-		GetBlackboardComponent()->SetValueAsVector(TEXT("NoiseLocation"), Stimulus.StimulusLocation);
+		RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().NoiseLocation, Stimulus.StimulusLocation);
 		// Removido: Atualização de LastKnownLocation ao ouvir som
 		return;
 	}
@@ -174,24 +235,35 @@ void ARPGAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stim
 		
         if (Stimulus.WasSuccessfullySensed())
 		{
-            // Não considerar alvos mortos
-            const bool bTargetAlive = !(RPGCharacter->Implements<UCombatInterface>() && ICombatInterface::Execute_IsDead(RPGCharacter));
-            if (!IsValid(TargetCharacter) && bTargetAlive)
+			// De volta à vista: a ameaça que sobrou (decaída) volta a disputar o alvo
+			if (ThreatTable.SetUnseen(RPGCharacter, false))
 			{
-				SetTarget(RPGCharacter);
+				RetargetToTopThreat();
 			}
-			else if (TargetCharacter == RPGCharacter)
+
+			// Ameaça de proximidade: quanto mais perto ao ser avistado, maior
+			const float Distance = FVector::Dist(GetPawn()->GetActorLocation(), RPGCharacter->GetActorLocation());
+			const float Proximity = FMath::Clamp(1.f - Distance / SIGHT_THREAT_RADIUS, 0.25f, 1.f);
+			AddThreat(RPGCharacter, SIGHT_THREAT * Proximity);
+
+			if (TargetCharacter == RPGCharacter)
 			{
 				// Atualizar localização conhecida do alvo atual
-				GetBlackboardComponent()->SetValueAsVector(TEXT("LastKnownLocation"), RPGCharacter->GetActorLocation());
+				RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().LastKnownLocation, RPGCharacter->GetActorLocation());
 			}
 		}
 		else // Alvo de visão perdido
 		{
 			if (TargetCharacter == RPGCharacter)
 			{
-				GetBlackboardComponent()->SetValueAsVector(TEXT("LastKnownLocation"), TargetCharacter->GetActorLocation());
-				ClearTarget();
+				RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().LastKnownLocation, TargetCharacter->GetActorLocation());
+			}
+
+			// Continua na tabela (decaindo), mas fora da disputa enquanto não for visto;
+			// o maior visível (se houver) assume como alvo
+			if (ThreatTable.SetUnseen(RPGCharacter, true))
+			{
+				RetargetToTopThreat();
 			}
 		}
 	}
@@ -199,16 +271,122 @@ void ARPGAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stim
 
 void ARPGAIController::HandleTargetDeath(AActor* DeadActor)
 {
+	RemoveThreat(DeadActor);
+
 	if (TargetCharacter && TargetCharacter == DeadActor)
 	{
 		ClearTarget();
 	}
 }
 
+void ARPGAIController::AddThreat(AActor* Source, float Amount)
+{
+	ARPGCharacterBase* Candidate = Cast<ARPGCharacterBase>(Source);
+	if (!GetPawn() || !IsValidThreatSource(Candidate)) return;
+
+	const bool bNewEntry = !ThreatTable.Contains(Candidate);
+
+	// OTIMIZAÇÃO: atualização incremental; retarget só quando o topo da tabela muda
+	const bool bTopChanged = ThreatTable.AddThreat(Candidate, Amount, GetWorld()->GetTimeSeconds());
+
+	if (bNewEntry && ThreatTable.Contains(Candidate))
+	{
+		if (URPGThreatSubsystem* Threat = GetWorld()->GetSubsystem<URPGThreatSubsystem>())
+		{
+			Threat->RegisterEngagement(this, Candidate);
+		}
+	}
+
+	if (bTopChanged)
+	{
+		RetargetToTopThreat();
+	}
+}
+
+void ARPGAIController::AddDamageThreat(AActor* Instigator, float Amount)
+{
+	if (!GetPawn() || !Instigator) return;
+
+	// Sem ninguém na tabela, só reage a atacantes próximos (mesma regra de antes da tabela de ameaça)
+	if (ThreatTable.IsEmpty() && FVector::Dist(GetPawn()->GetActorLocation(), Instigator->GetActorLocation()) > MAX_DAMAGE_RESPONSE_DISTANCE)
+	{
+		return;
+	}
+
+	// Dano revela o atacante: uma entrada fora de vista volta a disputar o alvo
+	if (ThreatTable.SetUnseen(Instigator, false))
+	{
+		RetargetToTopThreat();
+	}
+
+	AddThreat(Instigator, Amount);
+}
+
+void ARPGAIController::RemoveThreat(AActor* Source)
+{
+	if (!Source || !ThreatTable.Contains(Source)) return;
+
+	if (URPGThreatSubsystem* Threat = GetWorld()->GetSubsystem<URPGThreatSubsystem>())
+	{
+		Threat->UnregisterEngagement(this, Source);
+	}
+
+	if (ThreatTable.RemoveThreat(Source))
+	{
+		RetargetToTopThreat();
+	}
+}
+
+void ARPGAIController::RetargetToTopThreat()
+{
+	while (AActor* Top = ThreatTable.GetTopActor())
+	{
+		ARPGCharacterBase* TopCharacter = Cast<ARPGCharacterBase>(Top);
+		if (IsValidThreatSource(TopCharacter))
+		{
+			if (TargetCharacter != TopCharacter)
+			{
+				SetTarget(TopCharacter);
+			}
+			return;
+		}
+
+		// Entrada morta depois de somada: descartada só quando chega ao topo
+		if (URPGThreatSubsystem* Threat = GetWorld()->GetSubsystem<URPGThreatSubsystem>())
+		{
+			Threat->UnregisterEngagement(this, Top);
+		}
+		ThreatTable.RemoveThreat(Top);
+	}
+
+	if (IsValid(TargetCharacter))
+	{
+		ClearTarget();
+	}
+}
+
+bool ARPGAIController::IsValidThreatSource(const ARPGCharacterBase* Candidate) const
+{
+	if (!Candidate) return false;
+
+	// Não considerar alvos mortos
+	if (Candidate->Implements<UCombatInterface>() && ICombatInterface::Execute_IsDead(Candidate)) return false;
+
+	// Inimigos não geram ameaça uns nos outros
+	if (Cast<ARPGEnemy>(GetPawn()) && Cast<ARPGEnemy>(Candidate)) return false;
+
+	return GetTeamAttitudeTowards(*Candidate) == ETeamAttitude::Hostile;
+}
+
 void ARPGAIController::UpdateTargetLocation(const FVector& NewLocation)
 {
 	if (IsValid(TargetCharacter))
 	{
-		GetBlackboardComponent()->SetValueAsVector(TEXT("LastKnownLocation"), NewLocation);
+		RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().LastKnownLocation, NewLocation);
 	}
-} 
\ No newline at end of file
+}
+
+const FRPGBlackboardKeys& ARPGAIController::GetBlackboardKeys()
+{
+	return BlackboardKeyCache.Resolve(GetBlackboardComponent());
+}
@@ -0,0 +1,222 @@
+// Copyright Druid Mechanics
+
+#include "AI/RPGAIDistanceSubsystem.h"
+#include "AI/RPGAISignificanceSubsystem.h"
+#include "AIController.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<bool> CVarDebugAIDistance(
+	TEXT("rpg.AI.DebugDistance"),
+	false,
+	TEXT("Mostra na tela a distância até o alvo calculada pelo URPGAIDistanceSubsystem."));
+#endif
+
+void URPGAIDistanceSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	Super::Deinitialize();
+}
+
+bool URPGAIDistanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URPGAIDistanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGAIDistanceSubsystem, STATGROUP_Tickables);
+}
+
+void URPGAIDistanceSubsystem::RegisterController(UBlackboardComponent* Blackboard, AAIController* Controller, const FRPGAIDistanceKeys& Keys, const UObject* Owner, float Interval, float RandomDeviation)
+{
+	if (!Blackboard || !Controller || Keys.DistanceKey == FBlackboard::InvalidKey) return;
+
+	FDistanceEntry* Entry = Entries.FindByPredicate([Blackboard, Owner](const FDistanceEntry& Existing)
+	{
+		return Existing.Blackboard == Blackboard && Existing.Owner == Owner;
+	});
+	if (!Entry)
+	{
+		Entry = &Entries.AddDefaulted_GetRef();
+		Entry->Blackboard = Blackboard;
+		Entry->Owner = Owner;
+	}
+
+	Entry->Controller = Controller;
+	Entry->Keys = Keys;
+	Entry->Interval = Interval;
+	Entry->RandomDeviation = RandomDeviation;
+
+	// Primeira atualização já no próximo tick, para o blackboard não ficar sem distância
+	Entry->TimeUntilUpdate = 0.f;
+}
+
+void URPGAIDistanceSubsystem::UnregisterController(const UBlackboardComponent* Blackboard, const UObject* Owner)
+{
+	const int32 EntryIndex = Entries.IndexOfByPredicate([Blackboard, Owner](const FDistanceEntry& Entry)
+	{
+		return Entry.Blackboard == Blackboard && Entry.Owner == Owner;
+	});
+	if (EntryIndex != INDEX_NONE)
+	{
+		Entries.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	}
+}
+
+void URPGAIDistanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Entries.Num() == 0) return;
+
+	GatherPairs(DeltaTime);
+	if (FrameEntryIndices.Num() == 0) return;
+
+	ComputeResults();
+	WriteResults();
+
+#if !UE_BUILD_SHIPPING
+	if (CVarDebugAIDistance.GetValueOnGameThread())
+	{
+		DrawDebugMessages();
+	}
+#endif
+}
+
+void URPGAIDistanceSubsystem::GatherPairs(float DeltaTime)
+{
+	FrameEntryIndices.Reset();
+	FramePawnLocations.Reset();
+	FramePawnVelocities.Reset();
+	FrameTargetLocations.Reset();
+	FrameHasTargetActor.Reset();
+
+	// Controladores/blackboards destruídos sem OnCeaseRelevant
+	Entries.RemoveAllSwap([](const FDistanceEntry& Entry)
+	{
+		return !Entry.Blackboard.IsValid() || !Entry.Controller.IsValid();
+	}, EAllowShrinking::No);
+
+	const URPGAISignificanceSubsystem* Significance = GetWorld()->GetSubsystem<URPGAISignificanceSubsystem>();
+
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		FDistanceEntry& Entry = Entries[EntryIndex];
+		Entry.TimeUntilUpdate -= DeltaTime;
+		if (Entry.TimeUntilUpdate > 0.f) continue;
+
+		UBlackboardComponent* Blackboard = Entry.Blackboard.Get();
+		const AAIController* Controller = Entry.Controller.Get();
+
+		// Mesma agenda do UBTService::ScheduleNextTick, espaçada pela faixa de relevância da IA
+		const float IntervalScale = Significance ? Significance->GetIntervalScale(Controller) : 1.f;
+		Entry.TimeUntilUpdate = FMath::FRandRange(FMath::Max(0.f, Entry.Interval - Entry.RandomDeviation), Entry.Interval + Entry.RandomDeviation) * IntervalScale;
+
+		const APawn* Pawn = Controller->GetPawn();
+		if (!Pawn) continue;
+
+		FVector TargetLocation = FVector::ZeroVector;
+		bool bHasTargetActor = false;
+
+		const AActor* TargetActor = Entry.Keys.TargetActorKey != FBlackboard::InvalidKey
+			? Cast<AActor>(Blackboard->GetValue<UBlackboardKeyType_Object>(Entry.Keys.TargetActorKey))
+			: nullptr;
+		if (TargetActor)
+		{
+			// Alvo direto disponível
+			TargetLocation = TargetActor->GetActorLocation();
+			bHasTargetActor = true;
+		}
+		else
+		{
+			// Verificar se há uma localização conhecida do alvo
+			if (Entry.Keys.LastKnownLocationKey != FBlackboard::InvalidKey)
+			{
+				TargetLocation = Blackboard->GetValue<UBlackboardKeyType_Vector>(Entry.Keys.LastKnownLocationKey);
+			}
+			if (TargetLocation == FVector::ZeroVector)
+			{
+				Blackboard->ClearValue(Entry.Keys.DistanceKey);
+				continue;
+			}
+		}
+
+		FrameEntryIndices.Add(EntryIndex);
+		FramePawnLocations.Add(Pawn->GetActorLocation());
+		FramePawnVelocities.Add(Pawn->GetVelocity());
+		FrameTargetLocations.Add(TargetLocation);
+		FrameHasTargetActor.Add(bHasTargetActor);
+	}
+}
+
+void URPGAIDistanceSubsystem::ComputeResults()
+{
+	// OTIMIZAÇÃO: passada única sobre arrays contíguos, sem chamadas virtuais nem buscas de chave
+	const int32 NumPairs = FrameEntryIndices.Num();
+	FrameDistances.SetNumUninitialized(NumPairs);
+	FrameDirections.SetNumUninitialized(NumPairs);
+	FrameClosingSpeeds.SetNumUninitialized(NumPairs);
+
+	for (int32 PairIndex = 0; PairIndex < NumPairs; ++PairIndex)
+	{
+		const FVector ToTarget = FrameTargetLocations[PairIndex] - FramePawnLocations[PairIndex];
+		const float Distance = ToTarget.Size();
+		const FVector Direction = Distance > UE_KINDA_SMALL_NUMBER ? ToTarget / Distance : FVector::ZeroVector;
+
+		FrameDistances[PairIndex] = Distance;
+		FrameDirections[PairIndex] = Direction;
+		// Componente da velocidade do pawn na direção do alvo (positivo = aproximando)
+		FrameClosingSpeeds[PairIndex] = FVector::DotProduct(FramePawnVelocities[PairIndex], Direction);
+	}
+}
+
+void URPGAIDistanceSubsystem::WriteResults()
+{
+	for (int32 PairIndex = 0; PairIndex < FrameEntryIndices.Num(); ++PairIndex)
+	{
+		const FDistanceEntry& Entry = Entries[FrameEntryIndices[PairIndex]];
+		UBlackboardComponent* Blackboard = Entry.Blackboard.Get();
+
+		Blackboard->SetValue<UBlackboardKeyType_Float>(Entry.Keys.DistanceKey, FrameDistances[PairIndex]);
+		if (Entry.Keys.DirectionToTargetKey != FBlackboard::InvalidKey)
+		{
+			Blackboard->SetValue<UBlackboardKeyType_Vector>(Entry.Keys.DirectionToTargetKey, FrameDirections[PairIndex]);
+		}
+		if (Entry.Keys.ClosingSpeedKey != FBlackboard::InvalidKey)
+		{
+			Blackboard->SetValue<UBlackboardKeyType_Float>(Entry.Keys.ClosingSpeedKey, FrameClosingSpeeds[PairIndex]);
+		}
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+void URPGAIDistanceSubsystem::DrawDebugMessages() const
+{
+	if (!GEngine) return;
+
+	for (int32 PairIndex = 0; PairIndex < FrameEntryIndices.Num(); ++PairIndex)
+	{
+		const FDistanceEntry& Entry = Entries[FrameEntryIndices[PairIndex]];
+		const AAIController* Controller = Entry.Controller.Get();
+		if (!Controller) continue;
+
+		// Uma linha por controlador, sobrescrita a cada atualização
+		GEngine->AddOnScreenDebugMessage(
+			static_cast<uint64>(Controller->GetUniqueID()),
+			FMath::Max(Entry.Interval + Entry.RandomDeviation, Entry.TimeUntilUpdate) * 2.f,
+			FrameHasTargetActor[PairIndex] ? FColor::Yellow : FColor::Orange,
+			FString::Printf(TEXT("%s -> %s: %.1f (aproximação %.1f)"),
+				*Controller->GetName(),
+				FrameHasTargetActor[PairIndex] ? TEXT("Target") : TEXT("LastKnownLocation"),
+				FrameDistances[PairIndex],
+				FrameClosingSpeeds[PairIndex]));
+	}
+}
+#endif
@@ -0,0 +1,318 @@
+// Copyright Druid Mechanics
+
+#include "AI/RPGAISignificanceSubsystem.h"
+#include "AI/RPGSquadPerceptionSubsystem.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BrainComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "Perception/AISense_Hearing.h"
+#include "Perception/AISense_Sight.h"
+
+// Disponível em todas as builds: comparação de custo com/sem LOD de IA
+static TAutoConsoleVariable<bool> CVarAISignificanceEnabled(
+	TEXT("rpg.AI.Significance"),
+	true,
+	TEXT("Liga o LOD de IA por relevância (URPGAISignificanceSubsystem). Desligado, todas as IAs rodam na taxa original."));
+
+namespace RPGAISignificance
+{
+	struct FBucketSettings
+	{
+		float MaxDistance;
+		float ServiceIntervalScale;
+		float PerceptionTickInterval;
+		float MovementTickInterval;
+		EVisibilityBasedAnimTickOption AnimTickOption;
+		bool bSightAndHearingEnabled;
+	};
+
+	// Indexado por ERPGAISignificance. High usa os valores originais do pawn (ver ApplySignificance)
+	// Dormant: BT pausado; a escala de serviço só vale para IAs que não podem pausar
+	static const FBucketSettings Buckets[] =
+	{
+		{ 2000.f,  1.f, 0.f,   0.f,   EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones,   true },
+		{ 4000.f,  2.f, 0.1f,  0.f,   EVisibilityBasedAnimTickOption::AlwaysTickPose,                  true },
+		{ 8000.f,  4.f, 0.25f, 0.1f,  EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered, true },
+		{ MAX_flt, 8.f, 0.5f,  0.25f, EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered,        false },
+	};
+
+	// Margem para não alternar de faixa a cada avaliação perto do limite
+	constexpr float HYSTERESIS = 250.f;
+}
+
+void URPGAISignificanceSubsystem::Deinitialize()
+{
+	TrackedControllers.Empty();
+	SignificanceByController.Empty();
+	Super::Deinitialize();
+}
+
+bool URPGAISignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URPGAISignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGAISignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void URPGAISignificanceSubsystem::RegisterController(AAIController* Controller, bool bAllowPause)
+{
+	APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	if (!Pawn) return;
+
+	UnregisterController(Controller);
+
+	FTrackedController& Tracked = TrackedControllers.AddDefaulted_GetRef();
+	Tracked.Controller = Controller;
+	Tracked.Pawn = Pawn;
+	Tracked.bAllowPause = bAllowPause;
+	Tracked.bCanPause = bAllowPause;
+
+	SignificanceByController.Add(Controller, ERPGAISignificance::High);
+
+	if (const UAIPerceptionComponent* Perception = Controller->GetAIPerceptionComponent())
+	{
+		Tracked.PerceptionTickInterval = Perception->GetComponentTickInterval();
+	}
+	if (const ACharacter* Character = Cast<ACharacter>(Pawn))
+	{
+		if (const UCharacterMovementComponent* Movement = Character->GetCharacterMovement())
+		{
+			Tracked.MovementTickInterval = Movement->GetComponentTickInterval();
+		}
+		if (const USkeletalMeshComponent* Mesh = Character->GetMesh())
+		{
+			Tracked.AnimTickOption = Mesh->VisibilityBasedAnimTickOption;
+		}
+	}
+}
+
+void URPGAISignificanceSubsystem::UnregisterController(AAIController* Controller)
+{
+	const int32 TrackedIndex = TrackedControllers.IndexOfByPredicate([Controller](const FTrackedController& Tracked)
+	{
+		return Tracked.Controller == Controller;
+	});
+	if (TrackedIndex == INDEX_NONE) return;
+
+	// Devolver a taxa original antes de soltar o pawn
+	ApplySignificance(TrackedControllers[TrackedIndex], ERPGAISignificance::High);
+	TrackedControllers.RemoveAtSwap(TrackedIndex, 1, EAllowShrinking::No);
+	SignificanceByController.Remove(Controller);
+}
+
+ERPGAISignificance URPGAISignificanceSubsystem::GetSignificance(const AAIController* Controller) const
+{
+	const ERPGAISignificance* Significance = SignificanceByController.Find(Controller);
+	return Significance ? *Significance : ERPGAISignificance::High;
+}
+
+float URPGAISignificanceSubsystem::GetServiceIntervalScale(const UBehaviorTreeComponent& OwnerComp)
+{
+	const UWorld* World = OwnerComp.GetWorld();
+	const URPGAISignificanceSubsystem* Significance = World ? World->GetSubsystem<URPGAISignificanceSubsystem>() : nullptr;
+	return Significance ? Significance->GetIntervalScale(OwnerComp.GetAIOwner()) : 1.f;
+}
+
+float URPGAISignificanceSubsystem::GetIntervalScale(const AAIController* Controller) const
+{
+	return RPGAISignificance::Buckets[static_cast<uint8>(GetSignificance(Controller))].ServiceIntervalScale;
+}
+
+int32 URPGAISignificanceSubsystem::GetNumControllersInBucket(ERPGAISignificance Significance) const
+{
+	int32 Count = 0;
+	for (const FTrackedController& Tracked : TrackedControllers)
+	{
+		Count += Tracked.Significance == Significance ? 1 : 0;
+	}
+	return Count;
+}
+
+void URPGAISignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!CVarAISignificanceEnabled.GetValueOnGameThread())
+	{
+		RestoreAllToHigh();
+		return;
+	}
+
+	TimeSinceEvaluation += DeltaTime;
+	if (TimeSinceEvaluation < EVALUATION_INTERVAL || TrackedControllers.Num() == 0) return;
+	TimeSinceEvaluation = 0.f;
+
+	TrackedControllers.RemoveAllSwap([](const FTrackedController& Tracked)
+	{
+		return !Tracked.Controller.IsValid() || !Tracked.Pawn.IsValid();
+	}, EAllowShrinking::No);
+	if (SignificanceByController.Num() != TrackedControllers.Num())
+	{
+		for (auto It = SignificanceByController.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr()) It.RemoveCurrent();
+		}
+	}
+
+	TArray<FVector, TInlineAllocator<4>> ReferenceLocations;
+	if (!GetReferenceLocations(ReferenceLocations)) return;
+
+	// Servidor dedicado não renderiza: visibilidade não entra na avaliação
+	const bool bUseVisibility = GetWorld()->GetNetMode() != NM_DedicatedServer;
+
+	for (FTrackedController& Tracked : TrackedControllers)
+	{
+		const APawn* Pawn = Tracked.Pawn.Get();
+
+		// Pawn possuído pelo jogador (membro ativo) não é mais IA
+		if (Tracked.Controller->GetPawn() != Pawn) continue;
+
+		const ERPGAISignificance NewSignificance = EvaluateSignificance(Pawn, ReferenceLocations, bUseVisibility, Tracked.Significance);
+		const bool bCanPause = CanPauseLogic(Tracked);
+		if (NewSignificance != Tracked.Significance || bCanPause != Tracked.bCanPause)
+		{
+			Tracked.bCanPause = bCanPause;
+			ApplySignificance(Tracked, NewSignificance);
+		}
+	}
+}
+
+void URPGAISignificanceSubsystem::RestoreAllToHigh()
+{
+	for (FTrackedController& Tracked : TrackedControllers)
+	{
+		if (Tracked.Significance != ERPGAISignificance::High)
+		{
+			ApplySignificance(Tracked, ERPGAISignificance::High);
+		}
+	}
+	TimeSinceEvaluation = EVALUATION_INTERVAL;
+}
+
+bool URPGAISignificanceSubsystem::CanPauseLogic(FTrackedController& Tracked) const
+{
+	if (!Tracked.bAllowPause) return false;
+
+	const UBlackboardComponent* Blackboard = Tracked.Controller->GetBlackboardComponent();
+	if (!Blackboard) return true;
+
+	const FBlackboard::FKey TargetActorKey = Tracked.BlackboardKeys.Resolve(Blackboard).TargetActor;
+	return TargetActorKey == FBlackboard::InvalidKey || Blackboard->GetValue<UBlackboardKeyType_Object>(TargetActorKey) == nullptr;
+}
+
+bool URPGAISignificanceSubsystem::GetReferenceLocations(TArray<FVector, TInlineAllocator<4>>& OutLocations) const
+{
+	// Membro ativo da party é o pawn do jogador local; em multiplayer, cada jogador conta
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr)
+		{
+			OutLocations.Add(PlayerPawn->GetActorLocation());
+		}
+	}
+	return OutLocations.Num() > 0;
+}
+
+ERPGAISignificance URPGAISignificanceSubsystem::EvaluateSignificance(const APawn* Pawn, TArrayView<const FVector> ReferenceLocations, bool bUseVisibility, ERPGAISignificance CurrentSignificance) const
+{
+	const FVector PawnLocation = Pawn->GetActorLocation();
+	float DistanceSq = MAX_flt;
+	for (const FVector& ReferenceLocation : ReferenceLocations)
+	{
+		DistanceSq = FMath::Min(DistanceSq, static_cast<float>(FVector::DistSquared(PawnLocation, ReferenceLocation)));
+	}
+
+	uint8 Bucket = 0;
+	while (Bucket < static_cast<uint8>(ERPGAISignificance::Dormant))
+	{
+		// Faixas a partir da atual só são deixadas depois da margem de histerese
+		const float Margin = Bucket >= static_cast<uint8>(CurrentSignificance) ? RPGAISignificance::HYSTERESIS : 0.f;
+		if (DistanceSq <= FMath::Square(RPGAISignificance::Buckets[Bucket].MaxDistance + Margin))
+		{
+			break;
+		}
+		++Bucket;
+	}
+
+	// Fora da tela: uma faixa abaixo
+	if (bUseVisibility && Bucket < static_cast<uint8>(ERPGAISignificance::Dormant) && !Pawn->WasRecentlyRendered(EVALUATION_INTERVAL))
+	{
+		++Bucket;
+	}
+
+	return static_cast<ERPGAISignificance>(Bucket);
+}
+
+void URPGAISignificanceSubsystem::ApplySignificance(FTrackedController& Tracked, ERPGAISignificance Significance)
+{
+	Tracked.Significance = Significance;
+
+	AAIController* Controller = Tracked.Controller.Get();
+	APawn* Pawn = Tracked.Pawn.Get();
+	if (!Controller || !Pawn) return;
+
+	SignificanceByController.Add(Controller, Significance);
+
+	const RPGAISignificance::FBucketSettings& Settings = RPGAISignificance::Buckets[static_cast<uint8>(Significance)];
+	const bool bFullRate = Significance == ERPGAISignificance::High;
+
+	// O BT agenda o próprio tick (sobrescreveria um intervalo de componente): Dormant pausa a lógica
+	// de IAs sem alvo; as demais faixas (e IAs engajadas em Dormant) espaçam os serviços via GetIntervalScale
+	if (UBrainComponent* Brain = Controller->GetBrainComponent())
+	{
+		const bool bShouldPause = Significance == ERPGAISignificance::Dormant && Tracked.bCanPause;
+		if (bShouldPause && !Tracked.bLogicPaused && Brain->IsRunning())
+		{
+			Brain->PauseLogic(TEXT("Significance"));
+			Tracked.bLogicPaused = true;
+		}
+		else if (!bShouldPause && Tracked.bLogicPaused)
+		{
+			if (Brain->IsPaused())
+			{
+				Brain->ResumeLogic(TEXT("Significance"));
+			}
+			Tracked.bLogicPaused = false;
+		}
+	}
+
+	// Estímulos são processados no tick do componente de percepção
+	if (UAIPerceptionComponent* Perception = Controller->GetAIPerceptionComponent())
+	{
+		Perception->SetComponentTickInterval(bFullRate ? Tracked.PerceptionTickInterval : FMath::Max(Tracked.PerceptionTickInterval, Settings.PerceptionTickInterval));
+		// Membros de squad: visão/audição ficam a cargo do URPGSquadPerceptionSubsystem
+		const URPGSquadPerceptionSubsystem* SquadPerception = GetWorld()->GetSubsystem<URPGSquadPerceptionSubsystem>();
+		if (!SquadPerception || !SquadPerception->IsSquadMember(Controller))
+		{
+			// IA engajada em Dormant continua enxergando o alvo (não pausa, então precisa dos estímulos)
+			const bool bSightAndHearingEnabled = Settings.bSightAndHearingEnabled || !Tracked.bCanPause;
+			Perception->SetSenseEnabled(UAISense_Sight::StaticClass(), bSightAndHearingEnabled);
+			Perception->SetSenseEnabled(UAISense_Hearing::StaticClass(), bSightAndHearingEnabled);
+		}
+	}
+
+	if (ACharacter* Character = Cast<ACharacter>(Pawn))
+	{
+		if (UCharacterMovementComponent* Movement = Character->GetCharacterMovement())
+		{
+			Movement->SetComponentTickInterval(bFullRate ? Tracked.MovementTickInterval : FMath::Max(Tracked.MovementTickInterval, Settings.MovementTickInterval));
+		}
+		if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+		{
+			Mesh->VisibilityBasedAnimTickOption = bFullRate ? Tracked.AnimTickOption : Settings.AnimTickOption;
+		}
+	}
+}
@@ -0,0 +1,325 @@
+// Copyright Druid Mechanics
+
+#include "AI/RPGAIStressHarnessSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "NavigationSystem.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DEFINE_CATEGORY(RPGAIStress, true);
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs CmdAIStress(
+	TEXT("rpg.AI.Stress"),
+	TEXT("Roda o harness de carga de IA: Enemies=N Party=M Frames=F Seed=S EnemyClass=<path> [PartyClass=<path>] [EnemyController=<path>] [PartyController=<path>] [Spacing=cm] [FixedFPS=30] [Quit]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		URPGAIStressHarnessSubsystem* Harness = World ? World->GetSubsystem<URPGAIStressHarnessSubsystem>() : nullptr;
+		if (!Harness) return;
+
+		const FString Params = FString::Join(Args, TEXT(" "));
+		URPGAIStressHarnessSubsystem::FStressSettings Settings;
+		FParse::Value(*Params, TEXT("Enemies="), Settings.NumEnemies);
+		FParse::Value(*Params, TEXT("Party="), Settings.NumPartyMembers);
+		FParse::Value(*Params, TEXT("Frames="), Settings.NumFrames);
+		FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+		FParse::Value(*Params, TEXT("Spacing="), Settings.Spacing);
+		FParse::Value(*Params, TEXT("FixedFPS="), Settings.FixedFPS);
+		// Token solto "Quit" (FParse::Param só reconhece -Quit)
+		Settings.bQuitWhenDone = Args.ContainsByPredicate([](const FString& Arg)
+		{
+			return Arg.Equals(TEXT("Quit"), ESearchCase::IgnoreCase) || Arg.Equals(TEXT("-Quit"), ESearchCase::IgnoreCase);
+		});
+
+		FString ClassPath;
+		if (FParse::Value(*Params, TEXT("EnemyClass="), ClassPath))
+		{
+			Settings.EnemyClass = LoadClass<APawn>(nullptr, *ClassPath);
+		}
+		if (FParse::Value(*Params, TEXT("PartyClass="), ClassPath))
+		{
+			Settings.PartyClass = LoadClass<APawn>(nullptr, *ClassPath);
+		}
+		if (FParse::Value(*Params, TEXT("EnemyController="), ClassPath))
+		{
+			Settings.EnemyControllerClass = LoadClass<AController>(nullptr, *ClassPath);
+		}
+		if (FParse::Value(*Params, TEXT("PartyController="), ClassPath))
+		{
+			Settings.PartyControllerClass = LoadClass<AController>(nullptr, *ClassPath);
+		}
+
+		Harness->StartRun(Settings);
+	}));
+#endif
+
+void URPGAIStressHarnessSubsystem::Deinitialize()
+{
+	StopRun();
+	Super::Deinitialize();
+}
+
+bool URPGAIStressHarnessSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 URPGAIStressHarnessSubsystem::GetNumSamples() const
+{
+	// Durante a execução a última amostra ainda espera o tempo de game thread do seu frame
+	return bRunning ? FMath::Max(0, Samples.Num() - 1) : Samples.Num();
+}
+
+bool URPGAIStressHarnessSubsystem::StartRun(const FStressSettings& InSettings)
+{
+	if (bRunning)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AIStress: já existe uma execução em andamento"));
+		return false;
+	}
+	if (!InSettings.EnemyClass && !InSettings.PartyClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AIStress: informe EnemyClass e/ou PartyClass"));
+		return false;
+	}
+
+	Settings = InSettings;
+	Settings.NumFrames = FMath::Max(1, Settings.NumFrames);
+	Settings.FixedFPS = FMath::Max(1.f, Settings.FixedFPS);
+	RunName = FString::Printf(TEXT("AIStress_E%d_P%d_S%d_%s"), Settings.NumEnemies, Settings.NumPartyMembers, Settings.Seed, *FDateTime::Now().ToString());
+
+	// Determinismo: sementes globais e timestep fixo
+	FMath::RandInit(Settings.Seed);
+	FMath::SRandInit(Settings.Seed);
+	bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / Settings.FixedFPS);
+
+	// Grade ao redor do jogador (ou da origem), projetada no navmesh
+	FVector Origin = FVector::ZeroVector;
+	if (const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0))
+	{
+		Origin = PlayerPawn->GetActorLocation();
+	}
+
+	FRandomStream Stream(Settings.Seed);
+	const int32 NumPawns = Settings.NumEnemies + Settings.NumPartyMembers;
+	const int32 GridSide = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumPawns)));
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	for (int32 PawnIndex = 0; PawnIndex < NumPawns; ++PawnIndex)
+	{
+		const int32 Row = PawnIndex / GridSide;
+		const int32 Column = PawnIndex % GridSide;
+		FVector Location = Origin + FVector((Row - GridSide * 0.5f) * Settings.Spacing, (Column - GridSide * 0.5f) * Settings.Spacing, 0.f);
+		Location += FVector(Stream.FRandRange(-0.25f, 0.25f), Stream.FRandRange(-0.25f, 0.25f), 0.f) * Settings.Spacing;
+
+		FNavLocation NavLocation;
+		if (NavSys && NavSys->ProjectPointToNavigation(Location, NavLocation, FVector(Settings.Spacing, Settings.Spacing, 500.f)))
+		{
+			Location = NavLocation.Location + FVector(0.f, 0.f, 100.f);
+		}
+
+		const bool bEnemy = PawnIndex < Settings.NumEnemies;
+		const FRotator Rotation(0.f, Stream.FRandRange(0.f, 360.f), 0.f);
+		if (APawn* Pawn = SpawnStressPawn(bEnemy ? Settings.EnemyClass : Settings.PartyClass,
+			bEnemy ? Settings.EnemyControllerClass : Settings.PartyControllerClass, Location, Rotation))
+		{
+			SpawnedPawns.Add(Pawn);
+		}
+	}
+
+	// Os ticks do jogo rodam intactos (intervalos, tick groups, agendamento próprio do BT);
+	// o harness só cronometra o frame pelas bordas do tick do mundo
+	Samples.Reset(Settings.NumFrames + 1);
+	TickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &URPGAIStressHarnessSubsystem::HandleWorldTickStart);
+	TickEndHandle = FWorldDelegates::OnWorldTickEnd.AddUObject(this, &URPGAIStressHarnessSubsystem::HandleWorldTickEnd);
+
+#if !UE_BUILD_SHIPPING
+	// Colunas por categoria: escopos exclusivos nos ticks do RPG (BT, percepção, movimento, GAS)
+	FRPGAIStressScope::SetEnabled(true);
+#endif
+
+#if CSV_PROFILER
+	// Captura complementar com os stat scopes da engine (detalhe dentro de cada categoria)
+	FCsvProfiler* CsvProfiler = FCsvProfiler::Get();
+	if (CsvProfiler && !CsvProfiler->IsCapturing())
+	{
+		CsvProfiler->BeginCapture(-1, FPaths::ProfilingDir() / TEXT("AIStress"), RunName + TEXT("_Engine.csv"));
+		CSV_METADATA(TEXT("AIStressSeed"), *FString::FromInt(Settings.Seed));
+		bOwnsCsvCapture = true;
+	}
+#endif
+
+	bRunning = true;
+
+	UE_LOG(LogTemp, Log, TEXT("AIStress: %d pawns, %d frames, seed %d, %.0f FPS fixo"), SpawnedPawns.Num(), Settings.NumFrames, Settings.Seed, Settings.FixedFPS);
+	return true;
+}
+
+APawn* URPGAIStressHarnessSubsystem::SpawnStressPawn(TSubclassOf<APawn> PawnClass, TSubclassOf<AController> ControllerClass, const FVector& Location, const FRotator& Rotation)
+{
+	if (!PawnClass) return nullptr;
+
+	const FTransform SpawnTransform(Rotation, Location);
+	APawn* Pawn = GetWorld()->SpawnActorDeferred<APawn>(PawnClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!Pawn) return nullptr;
+
+	if (ControllerClass)
+	{
+		Pawn->AIControllerClass = ControllerClass;
+	}
+	Pawn->FinishSpawning(SpawnTransform);
+	if (!Pawn->GetController())
+	{
+		Pawn->SpawnDefaultController();
+	}
+	return Pawn;
+}
+
+void URPGAIStressHarnessSubsystem::HandleWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (!bRunning || TickedWorld != GetWorld()) return;
+
+	// GGameThreadTime só é fechado pelo loop da engine depois do frame: no início deste frame
+	// ele pertence à amostra anterior. Sem o loop (UWorld::Tick manual) o frame não avança e ele não vale
+	if (Samples.Num() > 0 && GFrameCounter != WorldTickStartFrame)
+	{
+		Samples.Last().GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	}
+	if (Samples.Num() >= Settings.NumFrames)
+	{
+		FinishRun();
+		return;
+	}
+
+	Samples.AddDefaulted_GetRef().DeltaTime = DeltaSeconds;
+	WorldTickStartFrame = GFrameCounter;
+
+#if !UE_BUILD_SHIPPING
+	// Descarta o que rodou fora do tick do mundo (ex.: entre frames)
+	double Discarded[static_cast<int32>(ERPGAIStressCategory::Num)];
+	FRPGAIStressScope::ConsumeFrame(Discarded);
+#endif
+	WorldTickStartCycles = FPlatformTime::Cycles64();
+}
+
+void URPGAIStressHarnessSubsystem::HandleWorldTickEnd(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (!bRunning || TickedWorld != GetWorld() || Samples.Num() == 0) return;
+
+	const double WorldTickMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - WorldTickStartCycles);
+	FFrameSample& Sample = Samples.Last();
+	Sample.WorldTickMs = WorldTickMs;
+#if !UE_BUILD_SHIPPING
+	FRPGAIStressScope::ConsumeFrame(Sample.CategoryMs);
+#endif
+
+	CSV_CUSTOM_STAT(RPGAIStress, WorldTickMs, static_cast<float>(WorldTickMs), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(RPGAIStress, BehaviorTreeMs, static_cast<float>(Sample.CategoryMs[static_cast<int32>(ERPGAIStressCategory::BehaviorTree)]), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(RPGAIStress, PerceptionMs, static_cast<float>(Sample.CategoryMs[static_cast<int32>(ERPGAIStressCategory::Perception)]), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(RPGAIStress, MovementMs, static_cast<float>(Sample.CategoryMs[static_cast<int32>(ERPGAIStressCategory::Movement)]), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(RPGAIStress, AbilitySystemMs, static_cast<float>(Sample.CategoryMs[static_cast<int32>(ERPGAIStressCategory::AbilitySystem)]), ECsvCustomStatOp::Set);
+}
+
+void URPGAIStressHarnessSubsystem::FinishRun()
+{
+	WriteCsv();
+	const bool bQuit = Settings.bQuitWhenDone;
+	StopRun();
+	if (bQuit)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void URPGAIStressHarnessSubsystem::StopRun()
+{
+	if (!bRunning) return;
+	bRunning = false;
+
+	FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+	FWorldDelegates::OnWorldTickEnd.Remove(TickEndHandle);
+	TickStartHandle.Reset();
+	TickEndHandle.Reset();
+
+#if !UE_BUILD_SHIPPING
+	FRPGAIStressScope::SetEnabled(false);
+#endif
+
+#if CSV_PROFILER
+	if (bOwnsCsvCapture)
+	{
+		bOwnsCsvCapture = false;
+		if (FCsvProfiler* CsvProfiler = FCsvProfiler::Get(); CsvProfiler && CsvProfiler->IsCapturing())
+		{
+			CsvProfiler->EndCapture();
+		}
+	}
+#endif
+
+	for (const TWeakObjectPtr<APawn>& Pawn : SpawnedPawns)
+	{
+		if (APawn* SpawnedPawn = Pawn.Get())
+		{
+			if (AController* Controller = SpawnedPawn->GetController())
+			{
+				Controller->Destroy();
+			}
+			SpawnedPawn->Destroy();
+		}
+	}
+	SpawnedPawns.Reset();
+
+	FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+}
+
+void URPGAIStressHarnessSubsystem::WriteCsv()
+{
+#if !UE_BUILD_SHIPPING
+	const int32 NumCategories = static_cast<int32>(ERPGAIStressCategory::Num);
+#endif
+
+	FString Csv = TEXT("Frame,DeltaTime,WorldTickMs");
+#if !UE_BUILD_SHIPPING
+	for (int32 Category = 0; Category < NumCategories; ++Category)
+	{
+		Csv += TEXT(",");
+		Csv += FRPGAIStressScope::GetCategoryName(static_cast<ERPGAIStressCategory>(Category));
+	}
+#endif
+	Csv += TEXT(",GameThreadMs\n");
+
+	for (int32 FrameIndex = 0; FrameIndex < Samples.Num(); ++FrameIndex)
+	{
+		const FFrameSample& Sample = Samples[FrameIndex];
+		Csv += FString::Printf(TEXT("%d,%.5f,%.4f"), FrameIndex, Sample.DeltaTime, Sample.WorldTickMs);
+#if !UE_BUILD_SHIPPING
+		for (int32 Category = 0; Category < NumCategories; ++Category)
+		{
+			Csv += FString::Printf(TEXT(",%.4f"), Sample.CategoryMs[Category]);
+		}
+#endif
+		// Coluna vazia quando o frame não veio do loop da engine
+		Csv += Sample.GameThreadMs >= 0.0 ? FString::Printf(TEXT(",%.4f\n"), Sample.GameThreadMs) : FString(TEXT(",\n"));
+	}
+
+	const FString FilePath = FPaths::ProfilingDir() / TEXT("AIStress") / RunName + TEXT(".csv");
+	if (FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		LastCsvPath = FilePath;
+		UE_LOG(LogTemp, Log, TEXT("AIStress: CSV gravado em %s"), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("AIStress: falha ao gravar %s"), *FilePath);
+	}
+}
@@ -0,0 +1,71 @@
+// Copyright Druid Mechanics
+
+#include "AI/RPGAIStressStats.h"
+
+#if !UE_BUILD_SHIPPING
+
+bool FRPGAIStressScope::bEnabled = false;
+FRPGAIStressScope* FRPGAIStressScope::Current = nullptr;
+uint64 FRPGAIStressScope::CategoryCycles[static_cast<int32>(ERPGAIStressCategory::Num)] = {};
+
+FRPGAIStressScope::FRPGAIStressScope(ERPGAIStressCategory InCategory)
+	: Category(InCategory)
+{
+	// Os acumuladores são do game thread (ticks de componentes em paralelo ficam de fora)
+	if (!bEnabled || !IsInGameThread()) return;
+
+	bActive = true;
+	StartCycles = FPlatformTime::Cycles64();
+
+	// Tempo exclusivo: o escopo de fora para de contar enquanto este estiver aberto
+	Parent = Current;
+	if (Parent)
+	{
+		CategoryCycles[static_cast<int32>(Parent->Category)] += StartCycles - Parent->StartCycles;
+	}
+	Current = this;
+}
+
+FRPGAIStressScope::~FRPGAIStressScope()
+{
+	if (!bActive) return;
+
+	const uint64 EndCycles = FPlatformTime::Cycles64();
+	CategoryCycles[static_cast<int32>(Category)] += EndCycles - StartCycles;
+
+	Current = Parent;
+	if (Parent)
+	{
+		Parent->StartCycles = EndCycles;
+	}
+}
+
+void FRPGAIStressScope::SetEnabled(bool bInEnabled)
+{
+	check(IsInGameThread());
+	bEnabled = bInEnabled;
+	FMemory::Memzero(CategoryCycles);
+}
+
+void FRPGAIStressScope::ConsumeFrame(double (&OutCategoryMs)[static_cast<int32>(ERPGAIStressCategory::Num)])
+{
+	for (int32 Index = 0; Index < static_cast<int32>(ERPGAIStressCategory::Num); ++Index)
+	{
+		OutCategoryMs[Index] = FPlatformTime::ToMilliseconds64(CategoryCycles[Index]);
+		CategoryCycles[Index] = 0;
+	}
+}
+
+const TCHAR* FRPGAIStressScope::GetCategoryName(ERPGAIStressCategory Category)
+{
+	switch (Category)
+	{
+	case ERPGAIStressCategory::BehaviorTree: return TEXT("BehaviorTreeMs");
+	case ERPGAIStressCategory::Perception: return TEXT("PerceptionMs");
+	case ERPGAIStressCategory::Movement: return TEXT("MovementMs");
+	case ERPGAIStressCategory::AbilitySystem: return TEXT("AbilitySystemMs");
+	default: return TEXT("UnknownMs");
+	}
+}
+
+#endif
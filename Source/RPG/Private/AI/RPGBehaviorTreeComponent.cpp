@@ -0,0 +1,10 @@
+// Copyright Druid Mechanics
+
+#include "AI/RPGBehaviorTreeComponent.h"
+#include "AI/RPGAIStressStats.h"
+
+void URPGBehaviorTreeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	RPG_AI_STRESS_SCOPE(BehaviorTree);
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
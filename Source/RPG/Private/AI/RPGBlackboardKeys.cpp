@@ -0,0 +1,104 @@
+// Copyright Druid Mechanics
+
+#include "AI/RPGBlackboardKeys.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+
+namespace RPGBlackboardKeyRegistry
+{
+	// Acessado apenas na game thread (controladores, tasks e serviços de BT)
+	static TMap<TWeakObjectPtr<const UBlackboardData>, FRPGBlackboardKeys> KeysByAsset;
+
+	static FRPGBlackboardKeys ResolveKeys(const UBlackboardData& BlackboardAsset)
+	{
+		FRPGBlackboardKeys Keys;
+		Keys.TargetActor = BlackboardAsset.GetKeyID(TEXT("TargetActor"));
+		Keys.LastKnownLocation = BlackboardAsset.GetKeyID(TEXT("LastKnownLocation"));
+		Keys.NoiseLocation = BlackboardAsset.GetKeyID(TEXT("NoiseLocation"));
+		Keys.PartyMember = BlackboardAsset.GetKeyID(TEXT("PartyMember"));
+		Keys.ActivePlayerLocation = BlackboardAsset.GetKeyID(TEXT("ActivePlayerLocation"));
+		Keys.HitReacting = BlackboardAsset.GetKeyID(TEXT("HitReacting"));
+		Keys.Dead = BlackboardAsset.GetKeyID(TEXT("Dead"));
+		return Keys;
+	}
+}
+
+const FRPGBlackboardKeys& FRPGBlackboardKeys::Get(const UBlackboardData* BlackboardAsset)
+{
+	static const FRPGBlackboardKeys InvalidKeys;
+	if (!BlackboardAsset) return InvalidKeys;
+
+	check(IsInGameThread());
+
+#if WITH_EDITOR
+	// Chaves editadas no asset invalidam os IDs já resolvidos
+	static const FDelegateHandle UpdateKeysHandle = UBlackboardData::OnUpdateKeys.AddLambda([](UBlackboardData* ChangedAsset)
+	{
+		RPGBlackboardKeyRegistry::KeysByAsset.Remove(ChangedAsset);
+	});
+#endif
+
+	if (const FRPGBlackboardKeys* Found = RPGBlackboardKeyRegistry::KeysByAsset.Find(BlackboardAsset))
+	{
+		return *Found;
+	}
+
+	// Assets descarregados não são mais encontrados; descartar antes de crescer o mapa
+	for (auto It = RPGBlackboardKeyRegistry::KeysByAsset.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return RPGBlackboardKeyRegistry::KeysByAsset.Add(BlackboardAsset, RPGBlackboardKeyRegistry::ResolveKeys(*BlackboardAsset));
+}
+
+const FRPGBlackboardKeys& FRPGBlackboardKeyCache::Resolve(const UBlackboardComponent* Blackboard)
+{
+	const UBlackboardData* BlackboardAsset = Blackboard ? Blackboard->GetBlackboardAsset() : nullptr;
+	if (CachedAsset.Get() != BlackboardAsset)
+	{
+		CachedKeys = FRPGBlackboardKeys::Get(BlackboardAsset);
+		CachedAsset = BlackboardAsset;
+	}
+	return CachedKeys;
+}
+
+namespace RPGBlackboard
+{
+	void SetObject(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, UObject* Value)
+	{
+		if (Blackboard && Key != FBlackboard::InvalidKey)
+		{
+			Blackboard->SetValue<UBlackboardKeyType_Object>(Key, Value);
+		}
+	}
+
+	void SetVector(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, const FVector& Value)
+	{
+		if (Blackboard && Key != FBlackboard::InvalidKey)
+		{
+			Blackboard->SetValue<UBlackboardKeyType_Vector>(Key, Value);
+		}
+	}
+
+	void SetBool(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, bool bValue)
+	{
+		if (Blackboard && Key != FBlackboard::InvalidKey)
+		{
+			Blackboard->SetValue<UBlackboardKeyType_Bool>(Key, bValue);
+		}
+	}
+
+	void Clear(UBlackboardComponent* Blackboard, FBlackboard::FKey Key)
+	{
+		if (Blackboard && Key != FBlackboard::InvalidKey)
+		{
+			Blackboard->ClearValue(Key);
+		}
+	}
+}
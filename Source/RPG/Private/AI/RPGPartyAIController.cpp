@@ -2,6 +2,8 @@
 
 #include "AI/RPGPartyAIController.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
+#include "AI/RPGBehaviorTreeComponent.h"
+#include "AI/RPGAIStressStats.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "Character/RPGCharacter.h"
@@ -18,12 +20,16 @@
 #include "GenericTeamAgentInterface.h"
 #include "Character/RPGEnemy.h"
 #include "Party/PartySubsystem.h"
+#include "AI/RPGAISignificanceSubsystem.h"
+#include "AI/RPGBlackboardKeys.h"
+#include "AI/RPGPathSharingSubsystem.h"
 
 
 ARPGPartyAIController::ARPGPartyAIController()
 {
 	Blackboard = CreateDefaultSubobject<UBlackboardComponent>("BlackboardComponent");
-	BehaviorTreeComponent = CreateDefaultSubobject<UBehaviorTreeComponent>("BehaviorTreeComponent");
+	BehaviorTreeComponent = CreateDefaultSubobject<URPGBehaviorTreeComponent>("BehaviorTreeComponent");
+	BrainComponent = BehaviorTreeComponent;
 
 	AIPerceptionComponent = CreateDefaultSubobject<UAIPerceptionComponent>("AIPerceptionComponent");
 	SetPerceptionComponent(*AIPerceptionComponent);
@@ -71,7 +77,7 @@ void ARPGPartyAIController::SetTarget(ARPGCharacterBase* NewTarget)
 		TargetCharacter->GetOnDeathDelegate().AddDynamic(this, &ARPGPartyAIController::HandleTargetDeath);
 	}
 	
-	GetBlackboardComponent()->SetValueAsObject(TEXT("TargetActor"), EnemyTarget);
+	RPGBlackboard::SetObject(GetBlackboardComponent(), GetBlackboardKeys().TargetActor, EnemyTarget);
 
 	// Atualizar o CombatTarget do membro da party com o novo alvo usando a interface
 	if (ARPGCharacter* PartyMember = Cast<ARPGCharacter>(GetPawn()))
@@ -83,9 +89,12 @@ void ARPGPartyAIController::SetTarget(ARPGCharacterBase* NewTarget)
 		// Se há um alvo válido, atualizar a localização conhecida
 		if (IsValid(EnemyTarget))
 		{
-			GetBlackboardComponent()->SetValueAsVector(TEXT("LastKnownLocation"), EnemyTarget->GetActorLocation());
+			RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().LastKnownLocation, EnemyTarget->GetActorLocation());
 		}
 	}
+
+	// Em combate: parar de seguir o líder
+	RefreshFollowState();
 }
 
 void ARPGPartyAIController::ClearTarget()
@@ -95,7 +104,7 @@ void ARPGPartyAIController::ClearTarget()
 		TargetCharacter->GetOnDeathDelegate().RemoveAll(this);
 	}
 	TargetCharacter = nullptr;
-	GetBlackboardComponent()->ClearValue(TEXT("TargetActor"));
+	RPGBlackboard::Clear(GetBlackboardComponent(), GetBlackboardKeys().TargetActor);
 
 	// Limpar o CombatTarget do membro da party usando a interface
 	if (ARPGCharacter* PartyMember = Cast<ARPGCharacter>(GetPawn()))
@@ -105,20 +114,15 @@ void ARPGPartyAIController::ClearTarget()
 			IPartyInterface::Execute_SetCombatTarget(PartyMember, nullptr);
 		}
 	}
+
+	// Sem alvo: voltar a seguir o membro ativo
+	RefreshFollowState();
 }
 
 void ARPGPartyAIController::OnPossess(APawn* InPawn)
 {
 	Super::OnPossess(InPawn);
 	GetAIPerceptionComponent()->OnTargetPerceptionUpdated.AddDynamic(this, &ARPGPartyAIController::OnTargetPerceptionUpdated);
-	
-	// Configurar timer para verificar se está seguro e atualizar PartyMember
-	GetWorld()->GetTimerManager().SetTimer(
-		UpdatePartyMemberTimerHandle,
-		FTimerDelegate::CreateUObject(this, &ARPGPartyAIController::UpdatePartyMemberWhenSafe),
-		0.2f, // Verificar a cada 0.2 segundos (mais frequente)
-		true   // Repetir
-	);
 
     // Vincular aos eventos do PartySubsystem para acompanhar o membro ativo
     if (UWorld* World = GetWorld())
@@ -144,10 +148,25 @@ void ARPGPartyAIController::OnPossess(APawn* InPawn)
     {
         OwnerChar->GetOnDeathDelegate().AddDynamic(this, &ARPGPartyAIController::HandleOwnerDeath);
     }
+
+    // OTIMIZAÇÃO: taxas de BT/percepção/movimento ajustadas pela distância até o membro ativo
+    // (sem pausa: um seguidor longe e fora da tela precisa continuar alcançando o líder)
+    if (URPGAISignificanceSubsystem* Significance = GetWorld()->GetSubsystem<URPGAISignificanceSubsystem>())
+    {
+        Significance->RegisterController(this, false);
+    }
 }
 
 void ARPGPartyAIController::OnUnPossess()
 {
+    // Restaurar as taxas originais antes de soltar o pawn
+    if (URPGAISignificanceSubsystem* Significance = GetWorld()->GetSubsystem<URPGAISignificanceSubsystem>())
+    {
+        Significance->UnregisterController(this);
+    }
+
+    UnbindLeaderMovement();
+
     Super::OnUnPossess();
     // Pausar lógica de BT quando não estiver controlando ninguém
     if (UBrainComponent* Brain = BrainComponent)
@@ -165,6 +184,15 @@ void ARPGPartyAIController::OnUnPossess()
     }
 }
 
+void ARPGPartyAIController::FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const
+{
+	// OTIMIZAÇÃO: MoveTo de agentes com destinos próximos reaproveita o mesmo corredor
+	if (!URPGPathSharingSubsystem::FindPathForMoveRequest(this, MoveRequest, Query, OutPath))
+	{
+		Super::FindPathForMoveRequest(MoveRequest, Query, OutPath);
+	}
+}
+
 void ARPGPartyAIController::RefreshActiveState()
 {
     UWorld* World = GetWorld();
@@ -204,11 +232,14 @@ void ARPGPartyAIController::RefreshActiveState()
             Brain->StopLogic(TEXT("IsActivePlayer"));
         }
     }
+
+    // Seguir (ou não) o novo membro ativo
+    RefreshFollowState();
 }
 
 void ARPGPartyAIController::HandleActiveMemberChanged(ARPGCharacter* NewActive)
 {
-    // Reavaliar se devemos rodar/parar a BT baseado no novo ativo
+    // Reavaliar se devemos rodar/parar a BT baseado no novo ativo (inclui o estado de seguir)
     RefreshActiveState();
 }
 
@@ -230,19 +261,24 @@ void ARPGPartyAIController::HandleOwnerDeath(AActor* DeadActor)
         Brain->StopLogic(TEXT("OwnerDead"));
     }
 
+    UnbindLeaderMovement();
+
     // Limpar dados do blackboard relevantes
     if (UBlackboardComponent* BB = GetBlackboardComponent())
     {
-        BB->ClearValue(TEXT("TargetActor"));
-        BB->ClearValue(TEXT("LastKnownLocation"));
-        BB->ClearValue(TEXT("NoiseLocation"));
-        BB->ClearValue(TEXT("PartyMember"));
-        BB->ClearValue(TEXT("ActivePlayerLocation"));
+        const FRPGBlackboardKeys& Keys = GetBlackboardKeys();
+        RPGBlackboard::Clear(BB, Keys.TargetActor);
+        RPGBlackboard::Clear(BB, Keys.LastKnownLocation);
+        RPGBlackboard::Clear(BB, Keys.NoiseLocation);
+        RPGBlackboard::Clear(BB, Keys.PartyMember);
+        RPGBlackboard::Clear(BB, Keys.ActivePlayerLocation);
     }
+    bFollowKeysWritten = false;
 }
 
 void ARPGPartyAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
 {
+	RPG_AI_STRESS_SCOPE(Perception);
 	if (!Actor) return;
 	
 	// Verificar se o Blackboard está inicializado
@@ -268,7 +304,7 @@ void ARPGPartyAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus
 		}
 		else
 		{
-			GetBlackboardComponent()->SetValueAsVector(TEXT("LastKnownLocation"), EnemyTarget->GetActorLocation());
+			RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().LastKnownLocation, EnemyTarget->GetActorLocation());
 		}
 		return;
 	}
@@ -284,11 +320,10 @@ void ARPGPartyAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus
 			return;
 		}
 		
-		GetBlackboardComponent()->SetValueAsVector(TEXT("NoiseLocation"), Stimulus.StimulusLocation);
+		RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().NoiseLocation, Stimulus.StimulusLocation);
 		
-		// Limpar PartyMember quando ouvir som (ficar alerta)
-		GetBlackboardComponent()->ClearValue(TEXT("PartyMember"));
-		GetBlackboardComponent()->ClearValue(TEXT("ActivePlayerLocation"));
+		// Limpar PartyMember quando ouvir som (ficar alerta); volta a seguir quando o líder se mover
+		ClearFollowKeys();
 		
 		return;
 	}
@@ -310,31 +345,18 @@ void ARPGPartyAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus
 			}
 			else if (TargetCharacter == EnemyTarget)
 			{
-				GetBlackboardComponent()->SetValueAsVector(TEXT("LastKnownLocation"), EnemyTarget->GetActorLocation());
+				RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().LastKnownLocation, EnemyTarget->GetActorLocation());
 			}
 		}
 		else // Alvo de visão perdido
 		{
 			if (TargetCharacter == EnemyTarget)
 			{
-				GetBlackboardComponent()->SetValueAsVector(TEXT("LastKnownLocation"), TargetCharacter->GetActorLocation());
+				RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().LastKnownLocation, TargetCharacter->GetActorLocation());
+				RPGBlackboard::Clear(GetBlackboardComponent(), GetBlackboardKeys().NoiseLocation);
+
+				// Limpa TargetActor e volta a seguir o membro ativo
 				ClearTarget();
-				
-				// Limpar todas as outras chaves e setar PartyMember imediatamente
-				GetBlackboardComponent()->ClearValue(TEXT("NoiseLocation"));
-				GetBlackboardComponent()->ClearValue(TEXT("TargetActor"));
-				
-				// Atualizar PartyMember imediatamente
-				UPartySubsystem* PartySubsystem = GetGameInstance()->GetSubsystem<UPartySubsystem>();
-				if (PartySubsystem)
-				{
-					ARPGCharacter* ActiveCharacter = PartySubsystem->GetActivePartyMember();
-					if (IsValid(ActiveCharacter))
-					{
-						GetBlackboardComponent()->SetValueAsObject(TEXT("PartyMember"), ActiveCharacter);
-						GetBlackboardComponent()->SetValueAsVector(TEXT("ActivePlayerLocation"), ActiveCharacter->GetActorLocation());
-					}
-				}
 			}
 		}
 		return;
@@ -343,7 +365,7 @@ void ARPGPartyAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus
 	// --- Outros estímulos: ignorar ---
 }
 
-void ARPGPartyAIController::UpdatePartyMemberWhenSafe()
+void ARPGPartyAIController::HandleTargetDeath(AActor* DeadActor)
 {
 	// Verificar se o Blackboard está inicializado
 	if (!GetBlackboardComponent() || !GetBlackboardComponent()->GetBlackboardAsset())
@@ -353,101 +375,143 @@ void ARPGPartyAIController::UpdatePartyMemberWhenSafe()
 	
 	// Log removed for cleanup
 	
-	// Só atualizar PartyMember se estiver completamente em paz
-	if (IsValid(TargetCharacter)) 
+	// Verificar se o alvo está realmente morto usando a interface
+	ARPGEnemy* EnemyTarget = Cast<ARPGEnemy>(DeadActor);
+	if (EnemyTarget && ICombatInterface::Execute_IsDead(EnemyTarget))
+	{
+		RPGBlackboard::Clear(GetBlackboardComponent(), GetBlackboardKeys().NoiseLocation);
+
+		// Limpa TargetActor e volta a seguir o membro ativo
+		ClearTarget();
+	}
+	// Log removed for cleanup
+}
+
+void ARPGPartyAIController::UpdateTargetLocation(const FVector& NewLocation)
+{
+	if (IsValid(TargetCharacter))
+	{
+		RPGBlackboard::SetVector(GetBlackboardComponent(), GetBlackboardKeys().LastKnownLocation, NewLocation);
+	}
+}
+
+// === SEGUIR O MEMBRO ATIVO ===
+
+UPartySubsystem* ARPGPartyAIController::GetPartySubsystem() const
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+	return GameInstance ? GameInstance->GetSubsystem<UPartySubsystem>() : nullptr;
+}
+
+void ARPGPartyAIController::RefreshFollowState()
+{
+	UBlackboardComponent* BB = GetBlackboardComponent();
+	if (!BB || !BB->GetBlackboardAsset())
 	{
-		// Verificar se o alvo está morto usando a interface
-		ARPGEnemy* EnemyTarget = Cast<ARPGEnemy>(TargetCharacter);
-		if (EnemyTarget && ICombatInterface::Execute_IsDead(EnemyTarget))
-		{
-			// Se o alvo está morto, limpar tudo e setar PartyMember
-			ClearTarget();
-			GetBlackboardComponent()->ClearValue(TEXT("NoiseLocation"));
-			GetBlackboardComponent()->ClearValue(TEXT("TargetActor"));
-			
-			// Atualizar PartyMember imediatamente
-			UPartySubsystem* PartySubsystem = GetGameInstance()->GetSubsystem<UPartySubsystem>();
-			if (PartySubsystem)
-			{
-				ARPGCharacter* ActiveCharacter = PartySubsystem->GetActivePartyMember();
-				if (IsValid(ActiveCharacter))
-				{
-					GetBlackboardComponent()->SetValueAsObject(TEXT("PartyMember"), ActiveCharacter);
-					GetBlackboardComponent()->SetValueAsVector(TEXT("ActivePlayerLocation"), ActiveCharacter->GetActorLocation());
-				}
-			}
-			return;
-		}
-		
-		// Se tem alvo vivo, limpar PartyMember
-		GetBlackboardComponent()->ClearValue(TEXT("PartyMember"));
-		GetBlackboardComponent()->ClearValue(TEXT("ActivePlayerLocation"));
 		return;
 	}
-	
-	// Se chegou até aqui, está em paz - atualizar PartyMember
-	UPartySubsystem* PartySubsystem = GetGameInstance()->GetSubsystem<UPartySubsystem>();
-	if (!PartySubsystem) 
+
+	const UPartySubsystem* PartySubsystem = GetPartySubsystem();
+	ARPGCharacter* ActiveCharacter = PartySubsystem ? PartySubsystem->GetActivePartyMember() : nullptr;
+	const APawn* Controlled = GetPawn();
+
+	// Só segue quando está em paz e não é o próprio membro ativo
+	const bool bShouldFollow = !IsValid(TargetCharacter) && IsValid(ActiveCharacter) && Controlled && Controlled != ActiveCharacter;
+	if (!bShouldFollow)
 	{
+		UnbindLeaderMovement();
+		ClearFollowKeys();
 		return;
 	}
-	
-	ARPGCharacter* ActiveCharacter = PartySubsystem->GetActivePartyMember();
-	if (IsValid(ActiveCharacter))
+
+	// OTIMIZAÇÃO: só grava quando há transição (entrada no estado ou troca de líder)
+	const bool bLeaderChanged = FollowedLeader != ActiveCharacter;
+	BindLeaderMovement(ActiveCharacter);
+	if (!bFollowKeysWritten || bLeaderChanged)
 	{
-		// Setar o player ativo como PartyMember no blackboard
-		GetBlackboardComponent()->SetValueAsObject(TEXT("PartyMember"), ActiveCharacter);
-		// Atualizar a localização do player ativo
-		GetBlackboardComponent()->SetValueAsVector(TEXT("ActivePlayerLocation"), ActiveCharacter->GetActorLocation());
+		WriteFollowKeys(ActiveCharacter);
 	}
-	else
+}
+
+void ARPGPartyAIController::WriteFollowKeys(ARPGCharacter* Leader)
+{
+	UBlackboardComponent* BB = GetBlackboardComponent();
+	if (!BB || !Leader) return;
+
+	LastWrittenLeaderLocation = Leader->GetActorLocation();
+	const FRPGBlackboardKeys& Keys = GetBlackboardKeys();
+	RPGBlackboard::SetObject(BB, Keys.PartyMember, Leader);
+	RPGBlackboard::SetVector(BB, Keys.ActivePlayerLocation, LastWrittenLeaderLocation);
+	bFollowKeysWritten = true;
+}
+
+void ARPGPartyAIController::ClearFollowKeys()
+{
+	if (!bFollowKeysWritten) return;
+	bFollowKeysWritten = false;
+
+	if (UBlackboardComponent* BB = GetBlackboardComponent())
 	{
-		// Limpar se não há player ativo
-		GetBlackboardComponent()->ClearValue(TEXT("PartyMember"));
-		GetBlackboardComponent()->ClearValue(TEXT("ActivePlayerLocation"));
+		const FRPGBlackboardKeys& Keys = GetBlackboardKeys();
+		RPGBlackboard::Clear(BB, Keys.PartyMember);
+		RPGBlackboard::Clear(BB, Keys.ActivePlayerLocation);
 	}
 }
 
-void ARPGPartyAIController::HandleTargetDeath(AActor* DeadActor)
+void ARPGPartyAIController::BindLeaderMovement(ARPGCharacter* Leader)
 {
-	// Verificar se o Blackboard está inicializado
-	if (!GetBlackboardComponent() || !GetBlackboardComponent()->GetBlackboardAsset())
+	USceneComponent* LeaderRoot = Leader ? Leader->GetRootComponent() : nullptr;
+	if (FollowedLeader == Leader && FollowedLeaderRoot == LeaderRoot && LeaderTransformHandle.IsValid())
 	{
 		return;
 	}
-	
-	// Log removed for cleanup
-	
-	// Verificar se o alvo está realmente morto usando a interface
-	ARPGEnemy* EnemyTarget = Cast<ARPGEnemy>(DeadActor);
-	if (EnemyTarget && ICombatInterface::Execute_IsDead(EnemyTarget))
+
+	UnbindLeaderMovement();
+	if (!LeaderRoot) return;
+
+	FollowedLeader = Leader;
+	FollowedLeaderRoot = LeaderRoot;
+	LeaderTransformHandle = LeaderRoot->TransformUpdated.AddUObject(this, &ARPGPartyAIController::HandleLeaderTransformUpdated);
+}
+
+void ARPGPartyAIController::UnbindLeaderMovement()
+{
+	if (USceneComponent* LeaderRoot = FollowedLeaderRoot.Get())
 	{
-		// Limpar todas as outras chaves e setar PartyMember imediatamente
-		GetBlackboardComponent()->ClearValue(TEXT("NoiseLocation"));
-		GetBlackboardComponent()->ClearValue(TEXT("TargetActor"));
-		
-		// Atualizar PartyMember imediatamente
-		UPartySubsystem* PartySubsystem = GetGameInstance()->GetSubsystem<UPartySubsystem>();
-		if (PartySubsystem)
-		{
-			ARPGCharacter* ActiveCharacter = PartySubsystem->GetActivePartyMember();
-			if (IsValid(ActiveCharacter))
-			{
-				GetBlackboardComponent()->SetValueAsObject(TEXT("PartyMember"), ActiveCharacter);
-				GetBlackboardComponent()->SetValueAsVector(TEXT("ActivePlayerLocation"), ActiveCharacter->GetActorLocation());
-			}
-		}
-		
-		// Limpar o alvo por último para evitar conflitos
-		ClearTarget();
+		LeaderRoot->TransformUpdated.Remove(LeaderTransformHandle);
 	}
-	// Log removed for cleanup
+	LeaderTransformHandle.Reset();
+	FollowedLeaderRoot.Reset();
+	FollowedLeader.Reset();
 }
 
-void ARPGPartyAIController::UpdateTargetLocation(const FVector& NewLocation)
+void ARPGPartyAIController::HandleLeaderTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
 {
-	if (IsValid(TargetCharacter))
+	if (!UpdatedComponent) return;
+
+	// OTIMIZAÇÃO: deslocamentos pequenos do líder não geram escrita no blackboard
+	const FVector LeaderLocation = UpdatedComponent->GetComponentLocation();
+	if (FVector::DistSquared(LeaderLocation, LastWrittenLeaderLocation) < FMath::Square(LEADER_MOVE_THRESHOLD))
+	{
+		return;
+	}
+
+	if (bFollowKeysWritten)
+	{
+		if (UBlackboardComponent* BB = GetBlackboardComponent())
+		{
+			LastWrittenLeaderLocation = FollowedLeader.IsValid() ? FollowedLeader->GetActorLocation() : LeaderLocation;
+			RPGBlackboard::SetVector(BB, GetBlackboardKeys().ActivePlayerLocation, LastWrittenLeaderLocation);
+		}
+	}
+	else
 	{
-		GetBlackboardComponent()->SetValueAsVector(TEXT("LastKnownLocation"), NewLocation);
+		// Alerta por som terminou: o líder seguiu em frente, retomar o seguir
+		RefreshFollowState();
 	}
-} 
\ No newline at end of file
+}
+
+const FRPGBlackboardKeys& ARPGPartyAIController::GetBlackboardKeys()
+{
+	return BlackboardKeyCache.Resolve(GetBlackboardComponent());
+}
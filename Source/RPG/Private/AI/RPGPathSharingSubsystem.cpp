@@ -0,0 +1,265 @@
+// Copyright Druid Mechanics
+
+#include "AI/RPGPathSharingSubsystem.h"
+#include "AIController.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "NavMesh/NavMeshPath.h"
+#include "NavigationSystem.h"
+
+// Ajuste de orçamento disponível em todas as builds (pode ser definido em [ConsoleVariables] ou device profiles)
+static TAutoConsoleVariable<int32> CVarPathQueryBudget(
+	TEXT("rpg.AI.PathQueryBudget"),
+	4,
+	TEXT("Máximo de consultas de caminho ao navmesh por frame para pedidos enfileirados (consultas síncronas do MoveTo também consomem)."));
+
+void URPGPathSharingSubsystem::Deinitialize()
+{
+	Corridors.Empty();
+	PendingRequests.Empty();
+	Super::Deinitialize();
+}
+
+bool URPGPathSharingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URPGPathSharingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGPathSharingSubsystem, STATGROUP_Tickables);
+}
+
+void URPGPathSharingSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+	Corridors.RemoveAllSwap([this, Now](const FCorridor& Corridor) { return Now - Corridor.Time > SHARE_WINDOW || !Corridor.NavData.IsValid(); });
+
+	struct FReadyPath
+	{
+		FPendingRequest Request;
+		FNavPathSharedPtr Path;
+	};
+	TArray<FReadyPath> ReadyPaths;
+
+	if (PendingRequests.Num() > 0)
+	{
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		const int32 Budget = CVarPathQueryBudget.GetValueOnGameThread();
+
+		TArray<FPendingRequest> Queue = MoveTemp(PendingRequests);
+		PendingRequests.Reset();
+
+		for (FPendingRequest& Request : Queue)
+		{
+			AAIController* Controller = Request.Controller.Get();
+			const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+			const ANavigationData* NavData = !Pawn ? nullptr
+				: Request.bExplicitNavData ? Request.NavData.Get()
+				: NavSys ? NavSys->GetNavDataForProps(Controller->GetNavAgentPropertiesRef(), Pawn->GetNavAgentLocation()) : nullptr;
+			if (!NavData)
+			{
+				ReadyPaths.Add({ MoveTemp(Request), nullptr });
+				continue;
+			}
+
+			FPathFindingQuery Query(Controller, *NavData, Pawn->GetNavAgentLocation(), Request.Goal,
+				UNavigationQueryFilter::GetQueryFilter(*NavData, Controller, Controller->GetDefaultNavigationFilterClass()));
+			Query.SetAllowPartialPaths(true);
+
+			// OTIMIZAÇÃO: acerto no corredor compartilhado não consome orçamento; sem orçamento, espera o próximo frame
+			FCorridor* Corridor = FindCorridor(Query);
+			FNavPathSharedPtr Path = Corridor ? BuildAgentPath(*Corridor, Query, true) : nullptr;
+			if (!Path)
+			{
+				if (QueriesThisFrame >= Budget)
+				{
+					PendingRequests.Add(MoveTemp(Request));
+					continue;
+				}
+				Path = QueryNavMesh(Query);
+			}
+			ReadyPaths.Add({ MoveTemp(Request), Path });
+		}
+	}
+
+	QueriesLastFrame = QueriesThisFrame;
+	QueriesThisFrame = 0;
+	SharedLastFrame = SharedThisFrame;
+	SharedThisFrame = 0;
+
+	// Callbacks por último: podem enfileirar ou cancelar pedidos
+	for (FReadyPath& Ready : ReadyPaths)
+	{
+		Ready.Request.OnReady.ExecuteIfBound(Ready.Request.Id, Ready.Path);
+	}
+}
+
+uint32 URPGPathSharingSubsystem::RequestPath(AAIController* Controller, const FVector& Goal, FOnSharedPathReady OnReady, const ANavigationData* NavData)
+{
+	if (!Controller || !Controller->GetPawn()) return 0;
+
+	const uint32 RequestId = NextRequestId++;
+	if (NextRequestId == 0) NextRequestId = 1;
+
+	PendingRequests.Add({ RequestId, Controller, Goal, MoveTemp(OnReady), NavData, NavData != nullptr });
+	return RequestId;
+}
+
+void URPGPathSharingSubsystem::CancelRequest(uint32 RequestId)
+{
+	PendingRequests.RemoveAll([RequestId](const FPendingRequest& Request) { return Request.Id == RequestId; });
+}
+
+bool URPGPathSharingSubsystem::FindPathForMoveRequest(const AAIController* Controller, const FAIMoveRequest& MoveRequest, const FPathFindingQuery& Query, FNavPathSharedPtr& OutPath)
+{
+	UWorld* World = Controller ? Controller->GetWorld() : nullptr;
+	URPGPathSharingSubsystem* PathSharing = World ? World->GetSubsystem<URPGPathSharingSubsystem>() : nullptr;
+	if (!PathSharing || !Query.NavData.IsValid()) return false;
+
+	// Alvo ator: o destino acompanha o ator (observação de objetivo), sem deslocamento por agente
+	OutPath = PathSharing->FindSharedPath(Query, !MoveRequest.IsMoveToActorRequest());
+
+	// Mesmo pós-processamento do AAIController::FindPathForMoveRequest
+	if (OutPath.IsValid())
+	{
+		if (MoveRequest.IsMoveToActorRequest() && MoveRequest.GetGoalActor())
+		{
+			OutPath->SetGoalActorObservation(*MoveRequest.GetGoalActor(), 100.f);
+		}
+		OutPath->EnableRecalculationOnInvalidation(true);
+	}
+	return true;
+}
+
+FNavPathSharedPtr URPGPathSharingSubsystem::FindSharedPath(const FPathFindingQuery& Query, bool bOffsetGoal)
+{
+	FCorridor* Corridor = FindCorridor(Query);
+	FNavPathSharedPtr Path = Corridor ? BuildAgentPath(*Corridor, Query, bOffsetGoal) : nullptr;
+	return Path ? Path : QueryNavMesh(Query);
+}
+
+URPGPathSharingSubsystem::FCorridor* URPGPathSharingSubsystem::FindCorridor(const FPathFindingQuery& Query)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (FCorridor& Corridor : Corridors)
+	{
+		if (Now - Corridor.Time > SHARE_WINDOW) continue;
+		if (Corridor.NavData.Get() != Query.NavData.Get() || Corridor.QueryFilter != Query.QueryFilter) continue;
+		if (Corridor.bPartial && !Query.bAllowPartialPaths) continue;
+		if (FVector::DistSquared(Corridor.Goal, Query.EndLocation) > FMath::Square(GOAL_TOLERANCE)) continue;
+		if (FVector::DistSquared(Corridor.Start, Query.StartLocation) > FMath::Square(START_TOLERANCE)) continue;
+		return &Corridor;
+	}
+	return nullptr;
+}
+
+FNavPathSharedPtr URPGPathSharingSubsystem::BuildAgentPath(FCorridor& Corridor, const FPathFindingQuery& Query, bool bOffsetGoal)
+{
+	const ANavigationData* NavData = Corridor.NavData.Get();
+	if (!NavData) return nullptr;
+
+	// O início do agente substitui o do corredor: o primeiro trecho precisa ser navegável em linha reta,
+	// senão (obstáculo entre os dois inícios) o agente faz a própria consulta
+	FVector StartHitLocation;
+	if (NavData->Raycast(Query.StartLocation, Corridor.Template->GetPathPoints()[1].Location, StartHitLocation, Query.QueryFilter, Query.Owner.Get()))
+	{
+		return nullptr;
+	}
+
+	// Cópia do caminho consultado: NodeRef, flags e CustomNavLinkId dos pontos (e o corredor de polígonos
+	// do FNavMeshPath) continuam valendo para o path following e para a invalidação por mudança no navmesh
+	FNavPathSharedPtr Path = CopyPath(*Corridor.Template);
+	TArray<FNavPathPoint>& Points = Path->GetPathPoints();
+	FNavMeshPath* MeshPath = Path->CastPath<FNavMeshPath>();
+	const FVector ProjectionExtent = NavData->GetConfig().DefaultQueryExtent;
+
+	FNavLocation AgentStart(Query.StartLocation);
+	NavData->ProjectPoint(Query.StartLocation, AgentStart, ProjectionExtent, Query.QueryFilter, Query.Owner.Get());
+	Points[0].Location = Query.StartLocation;
+	Points[0].NodeRef = AgentStart.NodeRef;
+	if (MeshPath && AgentStart.HasNodeRef() && !MeshPath->PathCorridor.Contains(AgentStart.NodeRef))
+	{
+		MeshPath->PathCorridor.Insert(AgentStart.NodeRef, 0);
+		MeshPath->PathCorridorCost.InsertDefaulted(0);
+	}
+
+	// Destino deslocado em espiral (ângulo áureo): quem divide o corredor não disputa o mesmo ponto final
+	if (bOffsetGoal && !Corridor.bPartial)
+	{
+		const int32 Slot = ++Corridor.NumSharers;
+		const float Angle = Slot * 2.3999632f;
+		const float Radius = AGENT_SPACING * FMath::Sqrt(static_cast<float>(Slot));
+		const FVector CorridorEnd = Points.Last().Location;
+		FVector AgentEnd = CorridorEnd + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * Radius;
+
+		// Raycast no navmesh: o deslocamento para na borda em vez de sair da área navegável
+		FVector HitLocation;
+		if (NavData->Raycast(CorridorEnd, AgentEnd, HitLocation, Query.QueryFilter, Query.Owner.Get()))
+		{
+			AgentEnd = HitLocation;
+		}
+
+		FNavLocation AgentGoal(AgentEnd);
+		NavData->ProjectPoint(AgentEnd, AgentGoal, ProjectionExtent, Query.QueryFilter, Query.Owner.Get());
+		Points.Last().Location = AgentEnd;
+		Points.Last().NodeRef = AgentGoal.NodeRef;
+		if (MeshPath && AgentGoal.HasNodeRef() && !MeshPath->PathCorridor.Contains(AgentGoal.NodeRef))
+		{
+			MeshPath->PathCorridor.Add(AgentGoal.NodeRef);
+			MeshPath->PathCorridorCost.AddDefaulted();
+		}
+	}
+
+	// Um repath (invalidação do navmesh, alvo) parte da consulta guardada: ela precisa do destino deste agente
+	FPathFindingQueryData AgentQueryData(Query);
+	AgentQueryData.EndLocation = Points.Last().Location;
+
+	Path->SetNavigationDataUsed(NavData);
+	Path->SetQuerier(Query.Owner.Get());
+	Path->SetFilter(Query.QueryFilter);
+	Path->SetQueryData(AgentQueryData);
+	Path->SetTimeStamp(NavData->GetWorldTimeStamp());
+	Path->SetIsPartial(Corridor.bPartial);
+
+	++SharedThisFrame;
+	return Path;
+}
+
+FNavPathSharedPtr URPGPathSharingSubsystem::QueryNavMesh(const FPathFindingQuery& Query)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys) return nullptr;
+
+	const FPathFindingResult Result = NavSys->FindPathSync(Query);
+	++QueriesThisFrame;
+	if (!Result.IsSuccessful() || !Result.Path.IsValid()) return nullptr;
+
+	if (Result.Path->GetPathPoints().Num() >= 2)
+	{
+		// Cópia tirada antes de o caminho ser entregue: o path following do líder observa e atualiza o original
+		FCorridor& Corridor = Corridors.AddDefaulted_GetRef();
+		Corridor.Start = Query.StartLocation;
+		Corridor.Goal = Query.EndLocation;
+		Corridor.Template = CopyPath(*Result.Path);
+		Corridor.NavData = Query.NavData;
+		Corridor.QueryFilter = Query.QueryFilter;
+		Corridor.Time = GetWorld()->GetTimeSeconds();
+		Corridor.bPartial = Result.Path->IsPartial();
+	}
+
+	return Result.Path;
+}
+
+FNavPathSharedPtr URPGPathSharingSubsystem::CopyPath(const FNavigationPath& Source)
+{
+	if (const FNavMeshPath* MeshPath = Source.CastPath<FNavMeshPath>())
+	{
+		return MakeShared<FNavMeshPath, ESPMode::ThreadSafe>(*MeshPath);
+	}
+	return MakeShared<FNavigationPath, ESPMode::ThreadSafe>(Source);
+}
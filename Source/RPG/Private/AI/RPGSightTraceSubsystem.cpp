@@ -0,0 +1,169 @@
+// Copyright Druid Mechanics
+
+#include "AI/RPGSightTraceSubsystem.h"
+#include "AI/RPGAIStressStats.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// Ajuste de orçamento disponível em todas as builds (pode ser definido em [ConsoleVariables] ou device profiles)
+static TAutoConsoleVariable<int32> CVarSightTraceBudget(
+	TEXT("rpg.AI.SightTraceBudget"),
+	16,
+	TEXT("Máximo de traces assíncronos de linha de visão da IA por frame."));
+
+void URPGSightTraceSubsystem::Deinitialize()
+{
+	Results.Empty();
+	PendingRequests.Empty();
+	TraceDelegate.Unbind();
+	Super::Deinitialize();
+}
+
+bool URPGSightTraceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URPGSightTraceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGSightTraceSubsystem, STATGROUP_Tickables);
+}
+
+void URPGSightTraceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	RPG_AI_STRESS_SCOPE(Perception);
+
+	TracesLastFrame = TracesThisFrame;
+	TracesThisFrame = 0;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now - LastPruneTime >= STALE_RESULT_TIME)
+	{
+		LastPruneTime = Now;
+		PruneStaleResults(Now);
+	}
+}
+
+UAISense_Sight::EVisibilityResult URPGSightTraceSubsystem::QueryVisibility(const FCanBeSeenFromContext& Context, const AActor* Target,
+	TConstArrayView<FVector> TargetPoints, FVector& OutSeenLocation, int32& OutNumAsyncTracesRequested,
+	const int32* UserData, const FOnPendingVisibilityQueryProcessedDelegate* Delegate)
+{
+	OutNumAsyncTracesRequested = 0;
+
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+	const AActor* Observer = Context.IgnoreActor;
+
+	FSightResult& Result = Results.FindOrAdd(FSightPairKey(Observer, Target));
+	Result.Target = Target;
+
+	// OTIMIZAÇÃO: renovação assíncrona, limitada por frame; excedentes esperam com o resultado anterior.
+	// Pares com mais pontos que o orçamento testam só os primeiros, então sempre cabe ao menos um pedido por frame
+	const int32 Budget = FMath::Max(1, CVarSightTraceBudget.GetValueOnGameThread());
+	const int32 NumTraces = FMath::Min(TargetPoints.Num(), Budget);
+	const bool bStale = Result.ResultTime < 0.0 || Now - Result.ResultTime >= RESULT_MAX_AGE;
+	if (bStale && Result.PendingRequestId == 0 && NumTraces > 0 && TracesThisFrame + NumTraces <= Budget)
+	{
+		if (!TraceDelegate.IsBound())
+		{
+			TraceDelegate.BindUObject(this, &URPGSightTraceSubsystem::OnTraceCompleted);
+		}
+
+		const uint32 RequestId = NextRequestId++;
+		if (NextRequestId == 0) NextRequestId = 1;
+
+		Result.PendingRequestId = RequestId;
+		Result.PendingTraces = NumTraces;
+		Result.bPendingVisible = false;
+		PendingRequests.Add(RequestId, FSightPairKey(Observer, Target));
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(RPGAISightTrace), true, Observer);
+		for (int32 Index = 0; Index < NumTraces; ++Index)
+		{
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Context.ObserverLocation, TargetPoints[Index], ECC_Visibility, Params,
+				FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, RequestId);
+		}
+
+		TracesThisFrame += NumTraces;
+		OutNumAsyncTracesRequested = NumTraces;
+
+		// Contrato assíncrono do UAISense_Sight: a consulta fica pendente até OnTraceCompleted chamar o delegate
+		if (Delegate && Delegate->IsBound())
+		{
+			Result.PendingDelegate = *Delegate;
+			Result.PendingQueryID = Context.SightQueryID;
+			Result.PendingUserData = UserData ? TOptional<int32>(*UserData) : TOptional<int32>();
+			return UAISense_Sight::EVisibilityResult::Pending;
+		}
+	}
+
+	// Sem orçamento (ou sem delegate): último resultado conhecido; na primeira consulta do par, o estado anterior
+	const bool bVisible = Result.ResultTime < 0.0 ? Context.bWasVisible && *Context.bWasVisible : Result.bVisible;
+	if (bVisible)
+	{
+		OutSeenLocation = Result.ResultTime < 0.0 && TargetPoints.Num() > 0 ? TargetPoints[0] : Result.SeenLocation;
+		return UAISense_Sight::EVisibilityResult::Visible;
+	}
+	return UAISense_Sight::EVisibilityResult::NotVisible;
+}
+
+void URPGSightTraceSubsystem::OnTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	RPG_AI_STRESS_SCOPE(Perception);
+	const FSightPairKey* PairKey = PendingRequests.Find(TraceDatum.UserData);
+	FSightResult* Result = PairKey ? Results.Find(*PairKey) : nullptr;
+	if (!Result || Result->PendingRequestId != TraceDatum.UserData)
+	{
+		PendingRequests.Remove(TraceDatum.UserData);
+		return;
+	}
+
+	// Ponto visível: nada no caminho ou o primeiro bloqueio é o próprio alvo (ou algo que ele possui, ex.: arma)
+	const FHitResult* Hit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Candidate) { return Candidate.bBlockingHit; });
+	const bool bPointVisible = !Hit || IsHitOnTarget(*Hit, Result->Target.Get());
+	if (bPointVisible && !Result->bPendingVisible)
+	{
+		Result->bPendingVisible = true;
+		Result->PendingSeenLocation = TraceDatum.End;
+	}
+
+	if (--Result->PendingTraces > 0) return;
+
+	Result->bVisible = Result->bPendingVisible;
+	Result->SeenLocation = Result->PendingSeenLocation;
+	Result->ResultTime = GetWorld()->GetTimeSeconds();
+	Result->PendingRequestId = 0;
+	PendingRequests.Remove(TraceDatum.UserData);
+
+	// Consulta que recebeu Pending: entrega o resultado ao UAISense_Sight
+	if (Result->PendingDelegate.IsBound())
+	{
+		const FOnPendingVisibilityQueryProcessedDelegate PendingDelegate = MoveTemp(Result->PendingDelegate);
+		Result->PendingDelegate.Unbind();
+		PendingDelegate.Execute(Result->PendingQueryID, Result->bVisible, Result->bVisible ? 1.f : 0.f, Result->SeenLocation, Result->PendingUserData);
+	}
+}
+
+bool URPGSightTraceSubsystem::IsHitOnTarget(const FHitResult& Hit, const AActor* Target)
+{
+	const AActor* HitActor = Hit.GetActor();
+	return HitActor && Target && HitActor->IsOwnedBy(Target);
+}
+
+void URPGSightTraceSubsystem::PruneStaleResults(double Now)
+{
+	for (auto It = Results.CreateIterator(); It; ++It)
+	{
+		const FSightResult& Result = It.Value();
+		const bool bExpired = Result.PendingRequestId == 0 && Result.ResultTime >= 0.0 && Now - Result.ResultTime > STALE_RESULT_TIME;
+		if (bExpired || !Result.Target.IsValid())
+		{
+			if (Result.PendingRequestId != 0)
+			{
+				PendingRequests.Remove(Result.PendingRequestId);
+			}
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,304 @@
+// Copyright Druid Mechanics
+
+#include "AI/RPGSquadPerceptionSubsystem.h"
+#include "AI/RPGAIStressStats.h"
+#include "AI/RPGAIController.h"
+#include "AI/RPGAISignificanceSubsystem.h"
+#include "AI/RPGSightTraceSubsystem.h"
+#include "Character/RPGCombatantSpatialSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Interaction/CombatInterface.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "Perception/AISenseConfig_Sight.h"
+#include "Perception/AISense_Hearing.h"
+#include "Perception/AISense_Sight.h"
+
+namespace RPGSquadPerception
+{
+	static bool IsAlive(const APawn* Pawn)
+	{
+		return Pawn && !(Pawn->Implements<UCombatInterface>() && ICombatInterface::Execute_IsDead(Pawn));
+	}
+}
+
+void URPGSquadPerceptionSubsystem::Deinitialize()
+{
+	Squads.Empty();
+	SquadByController.Empty();
+	Super::Deinitialize();
+}
+
+bool URPGSquadPerceptionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URPGSquadPerceptionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGSquadPerceptionSubsystem, STATGROUP_Tickables);
+}
+
+// === REGISTRO ===
+
+void URPGSquadPerceptionSubsystem::RegisterMember(FName SquadId, ARPGAIController* Controller)
+{
+	if (SquadId.IsNone() || !Controller) return;
+
+	UnregisterMember(Controller);
+
+	FSquad* Squad = Squads.Find(SquadId);
+	if (!Squad)
+	{
+		Squad = &Squads.Add(SquadId);
+		// Escalonar: cada squad cai em um ponto diferente da janela de atualização
+		const float Offset = UPDATE_INTERVAL * static_cast<float>(GetTypeHash(SquadId) % 100) / 100.f;
+		Squad->NextUpdateTime = GetWorld()->GetTimeSeconds() + Offset;
+	}
+
+	Squad->Members.Add(Controller);
+	SquadByController.Add(Controller, SquadId);
+
+	ConfigureMemberSenses(Controller, false);
+	SelectLeader(*Squad);
+}
+
+void URPGSquadPerceptionSubsystem::UnregisterMember(ARPGAIController* Controller)
+{
+	FName SquadId;
+	if (!SquadByController.RemoveAndCopyValue(Controller, SquadId)) return;
+
+	RestoreMemberSenses(Controller);
+
+	FSquad* Squad = Squads.Find(SquadId);
+	if (!Squad) return;
+
+	Squad->Members.RemoveSwap(Controller, EAllowShrinking::No);
+	if (Squad->Members.Num() == 0)
+	{
+		Squads.Remove(SquadId);
+		return;
+	}
+	if (Squad->Leader == Controller)
+	{
+		Squad->Leader.Reset();
+		SelectLeader(*Squad);
+	}
+}
+
+void URPGSquadPerceptionSubsystem::ConfigureMemberSenses(ARPGAIController* Controller, bool bLeader)
+{
+	if (UAIPerceptionComponent* Perception = Controller ? Controller->GetAIPerceptionComponent() : nullptr)
+	{
+		Perception->SetSenseEnabled(UAISense_Sight::StaticClass(), false);
+		Perception->SetSenseEnabled(UAISense_Hearing::StaticClass(), bLeader);
+	}
+}
+
+void URPGSquadPerceptionSubsystem::RestoreMemberSenses(ARPGAIController* Controller)
+{
+	if (UAIPerceptionComponent* Perception = Controller ? Controller->GetAIPerceptionComponent() : nullptr)
+	{
+		Perception->SetSenseEnabled(UAISense_Sight::StaticClass(), true);
+		Perception->SetSenseEnabled(UAISense_Hearing::StaticClass(), true);
+	}
+}
+
+void URPGSquadPerceptionSubsystem::SelectLeader(FSquad& Squad) const
+{
+	ARPGAIController* CurrentLeader = Squad.Leader.Get();
+	if (CurrentLeader && RPGSquadPerception::IsAlive(CurrentLeader->GetPawn())) return;
+
+	ARPGAIController* NewLeader = nullptr;
+	for (const TWeakObjectPtr<ARPGAIController>& Member : Squad.Members)
+	{
+		if (Member.IsValid() && RPGSquadPerception::IsAlive(Member->GetPawn()))
+		{
+			NewLeader = Member.Get();
+			break;
+		}
+	}
+	if (NewLeader == CurrentLeader) return;
+
+	// Audição migra para o novo líder
+	ConfigureMemberSenses(CurrentLeader, false);
+	ConfigureMemberSenses(NewLeader, true);
+	Squad.Leader = NewLeader;
+}
+
+// === ATUALIZAÇÃO ===
+
+void URPGSquadPerceptionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	RPG_AI_STRESS_SCOPE(Perception);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now - IntervalStartTime >= UPDATE_INTERVAL)
+	{
+		SightTracesLastInterval = SightTracesThisInterval;
+		SightTracesThisInterval = 0;
+		IntervalStartTime = Now;
+	}
+
+	for (TPair<FName, FSquad>& Pair : Squads)
+	{
+		FSquad& Squad = Pair.Value;
+		if (Now < Squad.NextUpdateTime) continue;
+		Squad.NextUpdateTime = Now + UPDATE_INTERVAL;
+
+		Squad.Members.RemoveAllSwap([](const TWeakObjectPtr<ARPGAIController>& Member)
+		{
+			return !Member.IsValid();
+		}, EAllowShrinking::No);
+
+		SelectLeader(Squad);
+		UpdateSquadSight(Squad);
+	}
+}
+
+void URPGSquadPerceptionSubsystem::UpdateSquadSight(FSquad& Squad)
+{
+	ARPGAIController* Leader = Squad.Leader.Get();
+	const APawn* LeaderPawn = Leader ? Leader->GetPawn() : nullptr;
+	if (!LeaderPawn) return;
+
+	// Squad adormecido pela relevância: sem testes de visão, como nas IAs individuais
+	if (const URPGAISignificanceSubsystem* Significance = GetWorld()->GetSubsystem<URPGAISignificanceSubsystem>())
+	{
+		if (Significance->GetSignificance(Leader) == ERPGAISignificance::Dormant) return;
+	}
+
+	// Parâmetros de visão lidos da configuração do líder (mesma config em todos os membros)
+	float SightRadius = 1000.f;
+	float LoseSightRadius = 1300.f;
+	float PeripheralVisionAngleDegrees = 90.f;
+	if (const UAIPerceptionComponent* Perception = Leader->GetAIPerceptionComponent())
+	{
+		if (const UAISenseConfig_Sight* SightConfig = Cast<UAISenseConfig_Sight>(Perception->GetSenseConfig(UAISense::GetSenseID<UAISense_Sight>())))
+		{
+			SightRadius = SightConfig->SightRadius;
+			LoseSightRadius = SightConfig->LoseSightRadius;
+			PeripheralVisionAngleDegrees = SightConfig->PeripheralVisionAngleDegrees;
+		}
+	}
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(PeripheralVisionAngleDegrees));
+
+	// Membros vivos: origem dos testes e atores ignorados nos traces
+	MemberPawnScratch.Reset();
+	FVector Centroid = FVector::ZeroVector;
+	for (const TWeakObjectPtr<ARPGAIController>& Member : Squad.Members)
+	{
+		const APawn* MemberPawn = Member.IsValid() ? Member->GetPawn() : nullptr;
+		if (!RPGSquadPerception::IsAlive(MemberPawn)) continue;
+		MemberPawnScratch.Add(MemberPawn);
+		Centroid += MemberPawn->GetActorLocation();
+	}
+	if (MemberPawnScratch.Num() == 0) return;
+	Centroid /= MemberPawnScratch.Num();
+
+	float SquadExtent = 0.f;
+	for (const AActor* MemberPawn : MemberPawnScratch)
+	{
+		SquadExtent = FMath::Max(SquadExtent, FVector::Dist(Centroid, MemberPawn->GetActorLocation()));
+	}
+
+	// Candidatos: combatentes vivos de outros times ao alcance de qualquer membro
+	CandidateScratch.Reset();
+	if (const URPGCombatantSpatialSubsystem* Spatial = URPGCombatantSpatialSubsystem::Get(this))
+	{
+		FRPGCombatantQueryFilter Filter;
+		Filter.bInflateByBounds = false;
+		Filter.TeamFilter = ERPGCombatantTeamFilter::OtherTeam;
+		if (const IGenericTeamAgentInterface* LeaderTeamAgent = Cast<IGenericTeamAgentInterface>(LeaderPawn))
+		{
+			Filter.TeamId = LeaderTeamAgent->GetGenericTeamId();
+		}
+		Spatial->QueryRadius(Centroid, LoseSightRadius + SquadExtent, Filter, CandidateScratch);
+	}
+
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(SquadPerceptionSight), false);
+	TraceParams.AddIgnoredActors(MemberPawnScratch);
+
+	const UAISense_Sight& SightSense = *GetDefault<UAISense_Sight>();
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<8>> NowSeen;
+
+	for (AActor* Candidate : CandidateScratch)
+	{
+		if (Leader->GetTeamAttitudeTowards(*Candidate) != ETeamAttitude::Hostile) continue;
+
+		// Alvos já vistos só são perdidos além do LoseSightRadius
+		const bool bWasSeen = Squad.SeenTargets.Contains(Candidate);
+		const float RadiusSq = FMath::Square(bWasSeen ? LoseSightRadius : SightRadius);
+		const FVector TargetLocation = Candidate->GetActorLocation();
+
+		// OTIMIZAÇÃO: normalmente um único trace por alvo, a partir do membro mais próximo que o tem no cone;
+		// se esse trace for bloqueado, tenta os próximos observadores em ordem de distância (outro ângulo pode ter visão)
+		ObserverScratch.Reset();
+		for (const AActor* MemberActor : MemberPawnScratch)
+		{
+			const APawn* MemberPawn = static_cast<const APawn*>(MemberActor);
+			const FVector ToTarget = TargetLocation - MemberPawn->GetActorLocation();
+			const float DistanceSq = ToTarget.SizeSquared();
+			if (DistanceSq > RadiusSq) continue;
+			if (FVector::DotProduct(ToTarget.GetSafeNormal(), MemberPawn->GetActorForwardVector()) < CosHalfAngle) continue;
+			ObserverScratch.Add({ DistanceSq, MemberPawn });
+		}
+		if (ObserverScratch.Num() == 0) continue;
+		ObserverScratch.Sort([](const FObserver& A, const FObserver& B) { return A.DistanceSq < B.DistanceSq; });
+
+		const APawn* Observer = nullptr;
+		for (const FObserver& Entry : ObserverScratch)
+		{
+			FHitResult Hit;
+			++SightTracesThisInterval;
+			const bool bBlocked = GetWorld()->LineTraceSingleByChannel(Hit, Entry.Pawn->GetPawnViewLocation(), TargetLocation, ECC_Visibility, TraceParams)
+				&& !URPGSightTraceSubsystem::IsHitOnTarget(Hit, Candidate);
+			if (!bBlocked)
+			{
+				Observer = Entry.Pawn;
+				break;
+			}
+		}
+		if (!Observer) continue;
+
+		NowSeen.Add(Candidate);
+		if (!bWasSeen)
+		{
+			const FAIStimulus Stimulus(SightSense, 1.f, TargetLocation, Observer->GetActorLocation(), FAIStimulus::SensingSucceeded);
+			BroadcastStimulus(Squad, Candidate, Stimulus, nullptr);
+		}
+	}
+
+	// Perda de visão: vistos na atualização anterior e não mais agora
+	for (const TWeakObjectPtr<AActor>& Previous : Squad.SeenTargets)
+	{
+		AActor* PreviousActor = Previous.Get();
+		if (!PreviousActor || NowSeen.Contains(Previous)) continue;
+
+		const FAIStimulus Stimulus(SightSense, 1.f, PreviousActor->GetActorLocation(), LeaderPawn->GetActorLocation(), FAIStimulus::SensingFailed);
+		BroadcastStimulus(Squad, PreviousActor, Stimulus, nullptr);
+	}
+
+	Squad.SeenTargets.Reset();
+	Squad.SeenTargets.Append(NowSeen);
+}
+
+void URPGSquadPerceptionSubsystem::ShareHearingStimulus(const ARPGAIController* Source, AActor* Actor, const FAIStimulus& Stimulus)
+{
+	const FName* SquadId = SquadByController.Find(Source);
+	const FSquad* Squad = SquadId ? Squads.Find(*SquadId) : nullptr;
+	if (!Squad || Squad->Leader != Source) return;
+
+	BroadcastStimulus(*Squad, Actor, Stimulus, Source);
+}
+
+void URPGSquadPerceptionSubsystem::BroadcastStimulus(const FSquad& Squad, AActor* Actor, const FAIStimulus& Stimulus, const ARPGAIController* Except) const
+{
+	for (const TWeakObjectPtr<ARPGAIController>& Member : Squad.Members)
+	{
+		ARPGAIController* Controller = Member.Get();
+		if (!Controller || Controller == Except || !RPGSquadPerception::IsAlive(Controller->GetPawn())) continue;
+		Controller->ReceiveSquadStimulus(Actor, Stimulus);
+	}
+}
@@ -0,0 +1,70 @@
+// Copyright Druid Mechanics
+
+#include "AI/RPGThreatSubsystem.h"
+#include "AI/RPGAIController.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+
+void URPGThreatSubsystem::Deinitialize()
+{
+	EngagedControllers.Empty();
+	Super::Deinitialize();
+}
+
+bool URPGThreatSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URPGThreatSubsystem::ReportDamage(const AActor* Victim, AActor* Instigator, float Damage)
+{
+	if (!Instigator || Damage <= 0.f) return;
+
+	const APawn* VictimPawn = Cast<APawn>(Victim);
+	if (ARPGAIController* Controller = VictimPawn ? Cast<ARPGAIController>(VictimPawn->GetController()) : nullptr)
+	{
+		Controller->AddDamageThreat(Instigator, Damage * DAMAGE_THREAT_SCALE);
+	}
+}
+
+void URPGThreatSubsystem::ReportHealing(const AActor* Healed, AActor* Healer, float Amount)
+{
+	if (!Healed || !Healer || Amount <= 0.f) return;
+
+	URPGThreatSubsystem* Subsystem = Healed->GetWorld() ? Healed->GetWorld()->GetSubsystem<URPGThreatSubsystem>() : nullptr;
+	if (!Subsystem) return;
+
+	FEngagedControllers* Controllers = Subsystem->EngagedControllers.Find(Healed);
+	if (!Controllers) return;
+
+	// AddThreat pode registrar um novo engajamento e realocar o mapa; iterar sobre uma cópia
+	const FEngagedControllers Snapshot = *Controllers;
+	for (const TWeakObjectPtr<ARPGAIController>& Controller : Snapshot)
+	{
+		if (ARPGAIController* EngagedController = Controller.Get())
+		{
+			EngagedController->AddThreat(Healer, Amount * HEAL_THREAT_SCALE);
+		}
+	}
+}
+
+void URPGThreatSubsystem::RegisterEngagement(ARPGAIController* Controller, const AActor* Actor)
+{
+	if (!Controller || !Actor) return;
+
+	FEngagedControllers& Controllers = EngagedControllers.FindOrAdd(Actor);
+	Controllers.RemoveAllSwap([](const TWeakObjectPtr<ARPGAIController>& Entry) { return !Entry.IsValid(); });
+	Controllers.AddUnique(Controller);
+}
+
+void URPGThreatSubsystem::UnregisterEngagement(ARPGAIController* Controller, const AActor* Actor)
+{
+	FEngagedControllers* Controllers = EngagedControllers.Find(Actor);
+	if (!Controllers) return;
+
+	Controllers->RemoveAllSwap([Controller](const TWeakObjectPtr<ARPGAIController>& Entry) { return !Entry.IsValid() || Entry.Get() == Controller; });
+	if (Controllers->Num() == 0)
+	{
+		EngagedControllers.Remove(Actor);
+	}
+}
@@ -0,0 +1,137 @@
+// Copyright Druid Mechanics
+
+#include "AI/RPGThreatTable.h"
+
+bool FRPGThreatTable::AddThreat(AActor* Actor, float Amount, double Now)
+{
+	if (!Actor || Amount <= 0.f) return false;
+
+	if (Entries.Num() == 0)
+	{
+		Epoch = Now;
+	}
+	else if (Now - Epoch > REBASE_INTERVAL)
+	{
+		Rebase(Now);
+	}
+
+	const AActor* PreviousTop = GetTopActor();
+	const double ScaledAmount = Amount * FMath::Exp(DECAY_RATE * (Now - Epoch));
+
+	int32 EntryIndex = FindIndex(Actor);
+	if (EntryIndex == INDEX_NONE)
+	{
+		EntryIndex = Entries.Add({ Actor, ScaledAmount });
+	}
+	else
+	{
+		Entries[EntryIndex].ScaledThreat += ScaledAmount;
+	}
+
+	// OTIMIZAÇÃO: só a entrada alterada pode desbancar o topo; varredura apenas se o topo ficou inválido
+	if (!CanBeTop(TopIndex))
+	{
+		TopIndex = FindTopIndex();
+	}
+	else if (EntryIndex != TopIndex && CanBeTop(EntryIndex) && Entries[EntryIndex].ScaledThreat > Entries[TopIndex].ScaledThreat * SWITCH_MARGIN)
+	{
+		TopIndex = EntryIndex;
+	}
+
+	return GetTopActor() != PreviousTop;
+}
+
+bool FRPGThreatTable::RemoveThreat(const AActor* Actor)
+{
+	const int32 EntryIndex = FindIndex(Actor);
+	if (EntryIndex == INDEX_NONE) return false;
+
+	const AActor* PreviousTop = GetTopActor();
+	Entries.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+
+	// Aproveita a varredura para descartar atores destruídos
+	Entries.RemoveAllSwap([](const FEntry& Entry) { return !Entry.Actor.IsValid(); }, EAllowShrinking::No);
+	TopIndex = FindTopIndex();
+
+	return GetTopActor() != PreviousTop;
+}
+
+bool FRPGThreatTable::SetUnseen(const AActor* Actor, bool bUnseen)
+{
+	const int32 EntryIndex = FindIndex(Actor);
+	if (EntryIndex == INDEX_NONE || Entries[EntryIndex].bUnseen == bUnseen) return false;
+
+	const AActor* PreviousTop = GetTopActor();
+	Entries[EntryIndex].bUnseen = bUnseen;
+
+	// Topo fora de vista: o maior visível assume sem exigir a margem (como na remoção);
+	// de volta à vista, a ameaça acumulada disputa o topo com a margem de sempre
+	if (!CanBeTop(TopIndex))
+	{
+		TopIndex = FindTopIndex();
+	}
+	else if (!bUnseen && Entries[EntryIndex].ScaledThreat > Entries[TopIndex].ScaledThreat * SWITCH_MARGIN)
+	{
+		TopIndex = EntryIndex;
+	}
+
+	return GetTopActor() != PreviousTop;
+}
+
+bool FRPGThreatTable::IsUnseen(const AActor* Actor) const
+{
+	const int32 EntryIndex = FindIndex(Actor);
+	return EntryIndex != INDEX_NONE && Entries[EntryIndex].bUnseen;
+}
+
+void FRPGThreatTable::Reset()
+{
+	Entries.Reset();
+	TopIndex = INDEX_NONE;
+}
+
+AActor* FRPGThreatTable::GetTopActor() const
+{
+	return Entries.IsValidIndex(TopIndex) ? Entries[TopIndex].Actor.Get() : nullptr;
+}
+
+float FRPGThreatTable::GetThreat(const AActor* Actor, double Now) const
+{
+	const int32 EntryIndex = FindIndex(Actor);
+	if (EntryIndex == INDEX_NONE) return 0.f;
+	return static_cast<float>(Entries[EntryIndex].ScaledThreat * FMath::Exp(-DECAY_RATE * (Now - Epoch)));
+}
+
+int32 FRPGThreatTable::FindIndex(const AActor* Actor) const
+{
+	return Entries.IndexOfByPredicate([Actor](const FEntry& Entry) { return Entry.Actor.Get() == Actor; });
+}
+
+int32 FRPGThreatTable::FindTopIndex() const
+{
+	int32 BestIndex = INDEX_NONE;
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		if (!CanBeTop(EntryIndex)) continue;
+		if (BestIndex == INDEX_NONE || Entries[EntryIndex].ScaledThreat > Entries[BestIndex].ScaledThreat)
+		{
+			BestIndex = EntryIndex;
+		}
+	}
+	return BestIndex;
+}
+
+bool FRPGThreatTable::CanBeTop(int32 EntryIndex) const
+{
+	return Entries.IsValidIndex(EntryIndex) && !Entries[EntryIndex].bUnseen && Entries[EntryIndex].Actor.IsValid();
+}
+
+void FRPGThreatTable::Rebase(double Now)
+{
+	const double Scale = FMath::Exp(-DECAY_RATE * (Now - Epoch));
+	for (FEntry& Entry : Entries)
+	{
+		Entry.ScaledThreat *= Scale;
+	}
+	Epoch = Now;
+}
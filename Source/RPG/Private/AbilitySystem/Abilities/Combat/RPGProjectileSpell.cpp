@@ -2,6 +2,7 @@
 
 #include "AbilitySystem/Abilities/Combat/RPGProjectileSpell.h"
 #include "Actor/RPGProjectile.h"
+#include "Actor/RPGProjectilePoolSubsystem.h"
 #include "AbilitySystem/Abilities/Base/RPGGameplayAbility.h"
 #include "AbilitySystemComponent.h"
 #include "Interaction/CombatInterface.h"
@@ -38,12 +39,27 @@ void URPGProjectileSpell::SpawnProjectile(const FVector& ProjectileTargetLocatio
     SpawnTransform.SetLocation(SocketLocation);
     SpawnTransform.SetRotation(Rotation.Quaternion());
 
-    ARPGProjectile* Projectile = GetWorld()->SpawnActorDeferred<ARPGProjectile>(
-        ProjectileClass,
-        SpawnTransform,
-        GetOwningActorFromActorInfo(),
-        Cast<APawn>(GetOwningActorFromActorInfo()),
-        ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    // Modo simulado: estado em SoA no subsystem, sem ator por projétil
+    if (bUseSimulatedProjectile)
+    {
+        if (URPGProjectileSimulationSubsystem* Simulation = World->GetSubsystem<URPGProjectileSimulationSubsystem>())
+        {
+            Simulation->SpawnSimulatedProjectile(SpawnTransform, SimulatedProjectileParams, MakeDamageEffectParamsFromClassDefaults());
+            return;
+        }
+    }
+
+    // OTIMIZAÇÃO: reutilizar projéteis do pool em vez de spawn/destroy a cada disparo
+    URPGProjectilePoolSubsystem* ProjectilePool = World->GetSubsystem<URPGProjectilePoolSubsystem>();
+    ARPGProjectile* Projectile = ProjectilePool
+        ? ProjectilePool->AcquireProjectile(ProjectileClass, SpawnTransform, GetOwningActorFromActorInfo(), Cast<APawn>(GetOwningActorFromActorInfo()))
+        : World->SpawnActorDeferred<ARPGProjectile>(
+            ProjectileClass,
+            SpawnTransform,
+            GetOwningActorFromActorInfo(),
+            Cast<APawn>(GetOwningActorFromActorInfo()),
+            ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    if (!Projectile) return;
 
     const UAbilitySystemComponent* SourceASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetAvatarActorFromActorInfo());
     if (SourceASC)
@@ -66,5 +82,12 @@ void URPGProjectileSpell::SpawnProjectile(const FVector& ProjectileTargetLocatio
         Projectile->DamageEffectSpecHandle = SpecHandle;
     }
 
-    Projectile->FinishSpawning(SpawnTransform);
+    if (ProjectilePool)
+    {
+        ProjectilePool->LaunchProjectile(Projectile, SpawnTransform);
+    }
+    else
+    {
+        Projectile->FinishSpawning(SpawnTransform);
+    }
 } 
\ No newline at end of file
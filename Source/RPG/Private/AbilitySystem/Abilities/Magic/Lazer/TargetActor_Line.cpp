@@ -7,6 +7,7 @@
 #include "NiagaraComponent.h"
 #include "Abilities/GameplayAbility.h"
 #include "Net/UnrealNetwork.h"
+#include "WorldCollision.h"
 #include "RPG/RPG.h"
 
 ATargetActor_Line::ATargetActor_Line()
@@ -38,6 +39,7 @@ void ATargetActor_Line::ConfigureTargetSetting(float NewTargetRange, float NewDe
     TargetRange = NewTargetRange;
     DetectionCylinderRadius = NewDetectionCylinderRadius;
     TargetingInterval = NewTargetingInterval;
+    CurrentLineLength = NewTargetRange;
     SetGenericTeamId(OwnerTeamId);
     bDrawDebug = bShouldDrawDebug;
 }
@@ -78,7 +80,33 @@ void ATargetActor_Line::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    UpdateTargetTrace();
+    const FRotator LookRotation = UpdateAimRotation();
+
+    // Resultado do sweep emitido no frame anterior
+    if (bUseAsyncTrace)
+    {
+        ConsumeAsyncTargetTrace(LookRotation);
+    }
+
+    TimeSinceVisualTrace += DeltaTime;
+    if (VisualTraceInterval > 0.f && TimeSinceVisualTrace < VisualTraceInterval)
+    {
+        // Entre traces: manter o comprimento atual seguindo a mira
+        ApplyLineEnd(GetActorLocation() + LookRotation.Vector() * CurrentLineLength);
+        return;
+    }
+    TimeSinceVisualTrace = 0.f;
+
+    if (bUseAsyncTrace)
+    {
+        if (!PendingTargetTraceHandle.IsValid())
+        {
+            IssueAsyncTargetTrace(LookRotation);
+        }
+        return;
+    }
+
+    UpdateTargetTrace(LookRotation);
 }
 
 void ATargetActor_Line::BeginDestroy()
@@ -118,7 +146,7 @@ void ATargetActor_Line::DoTargetCheckAndReport()
     TargetDataReadyDelegate.Broadcast(TargetDataHandle);
 }
 
-void ATargetActor_Line::UpdateTargetTrace()
+FRotator ATargetActor_Line::UpdateAimRotation()
 {
     FVector ViewLocation = GetActorLocation();
     FRotator ViewRotation = GetActorRotation();
@@ -131,14 +159,22 @@ void ATargetActor_Line::UpdateTargetTrace()
     const FVector LookEndPoint = ViewLocation + ViewRotation.Vector() * 100000.f;
     const FRotator LookRotation = UKismetMathLibrary::FindLookAtRotation(GetActorLocation(), LookEndPoint);
     SetActorRotation(LookRotation);
+    return LookRotation;
+}
 
-    const FVector SweepEndLocation = GetActorLocation() + LookRotation.Vector() * TargetRange;
-
-    TArray<FHitResult> HitResults;
-
+FCollisionQueryParams ATargetActor_Line::MakeTargetTraceQueryParams() const
+{
     FCollisionQueryParams QueryParams;
     QueryParams.AddIgnoredActor(AvatarActor);
     QueryParams.AddIgnoredActor(this);
+    return QueryParams;
+}
+
+void ATargetActor_Line::UpdateTargetTrace(const FRotator& LookRotation)
+{
+    const FVector SweepEndLocation = GetActorLocation() + LookRotation.Vector() * TargetRange;
+
+    TArray<FHitResult> HitResults;
 
     FCollisionResponseParams CollisionResponseParams(ECR_Overlap);
     GetWorld()->SweepMultiByChannel(
@@ -148,31 +184,82 @@ void ATargetActor_Line::UpdateTargetTrace()
         FQuat::Identity,
         ECC_WorldDynamic,
         FCollisionShape::MakeSphere(DetectionCylinderRadius),
-        QueryParams,
+        MakeTargetTraceQueryParams(),
         CollisionResponseParams
     );
 
     FVector LineEndLocation = SweepEndLocation;
-    float LineLength = TargetRange;
+    FindLineEnd(HitResults, LineEndLocation);
+    ApplyLineEnd(LineEndLocation);
+}
 
-    for (FHitResult& HitResult : HitResults)
+void ATargetActor_Line::IssueAsyncTargetTrace(const FRotator& LookRotation)
+{
+    const FVector SweepEndLocation = GetActorLocation() + LookRotation.Vector() * TargetRange;
+
+    PendingTargetTraceHandle = GetWorld()->AsyncSweepByChannel(
+        EAsyncTraceType::Multi,
+        GetActorLocation(),
+        SweepEndLocation,
+        FQuat::Identity,
+        ECC_WorldDynamic,
+        FCollisionShape::MakeSphere(DetectionCylinderRadius),
+        MakeTargetTraceQueryParams(),
+        FCollisionResponseParams(ECR_Overlap)
+    );
+}
+
+void ATargetActor_Line::ConsumeAsyncTargetTrace(const FRotator& LookRotation)
+{
+    if (!PendingTargetTraceHandle.IsValid())
+    {
+        return;
+    }
+
+    FTraceDatum TraceDatum;
+    if (!GetWorld()->QueryTraceData(PendingTargetTraceHandle, TraceDatum))
+    {
+        // Ainda não disponível (ou expirado): reemitir no próximo trace
+        if (!GetWorld()->IsTraceHandleValid(PendingTargetTraceHandle, false))
+        {
+            PendingTargetTraceHandle = FTraceHandle();
+        }
+        return;
+    }
+    PendingTargetTraceHandle = FTraceHandle();
+
+    // O sweep é de um frame atrás: usar o comprimento encontrado ao longo da mira atual
+    FVector LineEndLocation = TraceDatum.End;
+    FindLineEnd(TraceDatum.OutHits, LineEndLocation);
+    const float LineLength = FVector::Distance(TraceDatum.Start, LineEndLocation);
+    ApplyLineEnd(GetActorLocation() + LookRotation.Vector() * LineLength);
+}
+
+bool ATargetActor_Line::FindLineEnd(const TArray<FHitResult>& HitResults, FVector& OutLineEndLocation) const
+{
+    for (const FHitResult& HitResult : HitResults)
     {
         if (HitResult.GetActor())
         {
             if (GetTeamAttitudeTowards(*HitResult.GetActor()) != ETeamAttitude::Friendly)
             {
-                LineEndLocation = HitResult.ImpactPoint;
-                LineLength = FVector::Distance(GetActorLocation(), LineEndLocation);
-                break;
+                OutLineEndLocation = HitResult.ImpactPoint;
+                return true;
             }
         }
     }
+    return false;
+}
+
+void ATargetActor_Line::ApplyLineEnd(const FVector& LineEndLocation)
+{
+    CurrentLineLength = FVector::Distance(GetActorLocation(), LineEndLocation);
 
     TargetEndDetectionSphere->SetWorldLocation(LineEndLocation);
 
     if (LazerVFX)
     {
-        LazerVFX->SetVariableFloat(LazerFXLengthParamName, LineLength / 100.f);
+        LazerVFX->SetVariableFloat(LazerFXLengthParamName, CurrentLineLength / 100.f);
     }
 }
 
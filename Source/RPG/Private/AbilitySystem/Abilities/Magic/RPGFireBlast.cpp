@@ -3,6 +3,7 @@
 #include "AbilitySystem/Abilities/Magic/RPGFireBlast.h"
 #include "AbilitySystem/Core/RPGAbilitySystemLibrary.h"
 #include "Actor/RPGFireBall.h"
+#include "Actor/RPGProjectilePoolSubsystem.h"
 #include "RPGAbilityTypes.h"
 
 FString URPGFireBlast::GetDescription(int32 Level)
@@ -71,6 +72,20 @@ FString URPGFireBlast::GetNextLevelDescription(int32 Level)
 			ScaledDamage);
 }
 
+void URPGFireBlast::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
+{
+	Super::OnGiveAbility(ActorInfo, Spec);
+
+	// Pré-aquecer o pool quando a habilidade é concedida, e não no primeiro cast
+	if (!ActorInfo || !ActorInfo->IsNetAuthority() || !ActorInfo->OwnerActor.IsValid()) return;
+
+	UWorld* World = ActorInfo->OwnerActor->GetWorld();
+	if (URPGProjectilePoolSubsystem* ProjectilePool = World ? World->GetSubsystem<URPGProjectilePoolSubsystem>() : nullptr)
+	{
+		ProjectilePool->PrewarmPool(FireBallClass, NumFireBalls);
+	}
+}
+
 TArray<ARPGFireBall*> URPGFireBlast::SpawnFireBalls()
 {
 	TArray<ARPGFireBall*> FireBalls;
@@ -87,26 +102,44 @@ TArray<ARPGFireBall*> URPGFireBlast::SpawnFireBalls()
 	const FVector Location = GetAvatarActorFromActorInfo()->GetActorLocation();
 	TArray<FRotator> Rotators = URPGAbilitySystemLibrary::EvenlySpacedRotators(Forward, FVector::UpVector, 360.f, NumFireBalls);
 
+	// Parâmetros de dano são iguais para todas as bolas de fogo: montar uma única vez
+	const FDamageEffectParams ExplosionDamageParams = MakeDamageEffectParamsFromClassDefaults();
+	FireBalls.Reserve(Rotators.Num());
+
+	// OTIMIZAÇÃO: bolas de fogo vêm do pool (pré-aquecido em OnGiveAbility, fora do frame do cast)
+	URPGProjectilePoolSubsystem* ProjectilePool = World->GetSubsystem<URPGProjectilePoolSubsystem>();
+	APawn* InstigatorPawn = CurrentActorInfo->PlayerController.IsValid() ? CurrentActorInfo->PlayerController->GetPawn() : nullptr;
+
 	for (const FRotator& Rotator : Rotators)
 	{
 		FTransform SpawnTransform;
 		SpawnTransform.SetLocation(Location);
 		SpawnTransform.SetRotation(Rotator.Quaternion());
 		
-		ARPGFireBall* FireBall = GetWorld()->SpawnActorDeferred<ARPGFireBall>(
-			FireBallClass,
-			SpawnTransform,
-			GetOwningActorFromActorInfo(),
-			CurrentActorInfo->PlayerController->GetPawn(),
-			ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		ARPGFireBall* FireBall = ProjectilePool
+			? Cast<ARPGFireBall>(ProjectilePool->AcquireProjectile(FireBallClass, SpawnTransform, GetOwningActorFromActorInfo(), InstigatorPawn))
+			: World->SpawnActorDeferred<ARPGFireBall>(
+				FireBallClass,
+				SpawnTransform,
+				GetOwningActorFromActorInfo(),
+				InstigatorPawn,
+				ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!FireBall) continue;
 		
-		FireBall->ExplosionDamageParams = MakeDamageEffectParamsFromClassDefaults();
+		FireBall->ExplosionDamageParams = ExplosionDamageParams;
 		FireBall->ReturnToActor = GetAvatarActorFromActorInfo();
 		FireBall->SetOwner(GetAvatarActorFromActorInfo());
 
 		FireBalls.Add(FireBall);
 
-		FireBall->FinishSpawning(SpawnTransform);
+		if (ProjectilePool)
+		{
+			ProjectilePool->LaunchProjectile(FireBall, SpawnTransform);
+		}
+		else
+		{
+			FireBall->FinishSpawning(SpawnTransform);
+		}
 	}
 	
 	return FireBalls;
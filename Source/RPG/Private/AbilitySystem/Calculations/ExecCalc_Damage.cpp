@@ -6,6 +6,32 @@
 #include "AbilitySystem/Core/RPGAttributeSet.h"
 #include "AbilitySystem/Data/EnemyClassInfo.h"
 #include "Interaction/CombatInterface.h"
+#include "RPGAbilityTypes.h"
+
+// Logs por hit: compilados fora em builds Shipping
+#if !UE_BUILD_SHIPPING
+#define RPG_DAMAGE_LOG(Verbosity, Format, ...) UE_LOG(LogTemp, Verbosity, Format, ##__VA_ARGS__)
+#else
+#define RPG_DAMAGE_LOG(Verbosity, Format, ...)
+#endif
+
+struct RPGDamageStatics;
+
+/** Entrada da tabela tipo de dano -> captura de resistência no Target */
+struct FRPGDamageTypeEntry
+{
+	FGameplayTag FRPGGameplayTags::* DamageTag;
+	const FGameplayEffectAttributeCaptureDefinition RPGDamageStatics::* ResistanceDef;
+};
+
+/** Informação resolvida por tipo de dano (nullptr = sem resistência) */
+struct FRPGDamageTypeInfo
+{
+	const FGameplayEffectAttributeCaptureDefinition* ResistanceDef = nullptr;
+
+	// Posição na tabela: com vários tipos no SetByCaller vence o menor (independe da ordem do TMap)
+	int32 Priority = 0;
+};
 
 struct RPGDamageStatics
 {
@@ -13,11 +39,18 @@ struct RPGDamageStatics
 	
 	// Defensive attributes (Target)
 	DECLARE_ATTRIBUTE_CAPTUREDEF(Armor);
+	DECLARE_ATTRIBUTE_CAPTUREDEF(MagicResistance);
 	
 	// Offensive attributes (Source)
 	DECLARE_ATTRIBUTE_CAPTUREDEF(Attack);
 	
 	TMap<FGameplayTag, FGameplayEffectAttributeCaptureDefinition> TagsToCaptureDefs;
+
+	// Tipo de dano (tag SetByCaller) -> resistência, montado uma única vez
+	TMap<FGameplayTag, FRPGDamageTypeInfo> DamageTypeInfos;
+
+	// Tipos com resistência na ordem de prioridade da tabela (fallback pelas tags do Source)
+	TArray<FGameplayTag> TypedDamageTagsByPriority;
 	
 	RPGDamageStatics()
 	{
@@ -25,6 +58,7 @@ struct RPGDamageStatics
 		
 		// Defensive attributes (Target)
 		DEFINE_ATTRIBUTE_CAPTUREDEF(URPGAttributeSet, Armor, Target, false);
+		DEFINE_ATTRIBUTE_CAPTUREDEF(URPGAttributeSet, MagicResistance, Target, false);
 		
 		// Offensive attributes (Source)
 		DEFINE_ATTRIBUTE_CAPTUREDEF(URPGAttributeSet, Attack, Source, false);
@@ -32,7 +66,32 @@ struct RPGDamageStatics
 		const FRPGGameplayTags& Tags = FRPGGameplayTags::Get();
 		
 		TagsToCaptureDefs.Add(Tags.Attributes_Secondary_Armor, ArmorDef);
+		TagsToCaptureDefs.Add(Tags.Attributes_Secondary_MagicResistance, MagicResistanceDef);
 		TagsToCaptureDefs.Add(Tags.Attributes_Secondary_Attack, AttackDef);
+
+		// Tabela em tempo de compilação: tipo de dano -> atributo de resistência (ordem = prioridade)
+		static constexpr FRPGDamageTypeEntry DamageTypeTable[] =
+		{
+			{ &FRPGGameplayTags::Damage,           nullptr },
+			{ &FRPGGameplayTags::Damage_Physical,  &RPGDamageStatics::ArmorDef },
+			{ &FRPGGameplayTags::Damage_Fire,      &RPGDamageStatics::MagicResistanceDef },
+			{ &FRPGGameplayTags::Damage_Lightning, &RPGDamageStatics::MagicResistanceDef },
+			{ &FRPGGameplayTags::Damage_Arcane,    &RPGDamageStatics::MagicResistanceDef },
+		};
+
+		DamageTypeInfos.Reserve(UE_ARRAY_COUNT(DamageTypeTable));
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(DamageTypeTable); ++Index)
+		{
+			const FRPGDamageTypeEntry& Entry = DamageTypeTable[Index];
+			FRPGDamageTypeInfo Info;
+			Info.ResistanceDef = Entry.ResistanceDef ? &(this->*Entry.ResistanceDef) : nullptr;
+			Info.Priority = Index;
+			DamageTypeInfos.Add(Tags.*Entry.DamageTag, Info);
+			if (Info.ResistanceDef)
+			{
+				TypedDamageTagsByPriority.Add(Tags.*Entry.DamageTag);
+			}
+		}
 	}
 };
 
@@ -48,6 +107,7 @@ UExecCalc_Damage::UExecCalc_Damage()
 	
 	// Defensive attributes (Target)
 	RelevantAttributesToCapture.Add(DamageStatics().ArmorDef);
+	RelevantAttributesToCapture.Add(DamageStatics().MagicResistanceDef);
 	
 	// Offensive attributes (Source)
 	RelevantAttributesToCapture.Add(DamageStatics().AttackDef);
@@ -95,27 +155,56 @@ void UExecCalc_Damage::Execute_Implementation(const FGameplayEffectCustomExecuti
 	EvaluationParameters.SourceTags = SourceTags;
 	EvaluationParameters.TargetTags = TargetTags;
 
-    // Get Damage Set by Caller Magnitude (habilidade base)
-    float Damage = 0.f;
-    // Tentar capturar o dano usando as tags de tipo de dano
-    const FRPGGameplayTags& Tags = FRPGGameplayTags::Get();
-    Damage = Spec.GetSetByCallerMagnitude(Tags.Damage, false, 0.f);
-    if (Damage == 0.f)
-    {
-        Damage = Spec.GetSetByCallerMagnitude(Tags.Damage_Physical, false, 0.f);
-    }
-    if (Damage == 0.f)
-    {
-        Damage = Spec.GetSetByCallerMagnitude(Tags.Damage_Fire, false, 0.f);
-    }
-    if (Damage == 0.f)
+	FGameplayEffectContextHandle EffectContextHandle = Spec.GetContext();
+    const TMap<FGameplayTag, FRPGDamageTypeInfo>& DamageTypeInfos = DamageStatics().DamageTypeInfos;
+
+    // Tipo explícito: o DamageType do contexto, quando presente, decide a resistência
+    const FRPGDamageTypeInfo* ExplicitTypeInfo = nullptr;
+    if (const FRPGGameplayEffectContext* RPGContext = static_cast<const FRPGGameplayEffectContext*>(EffectContextHandle.Get()))
     {
-        Damage = Spec.GetSetByCallerMagnitude(Tags.Damage_Lightning, false, 0.f);
+        if (const TSharedPtr<FGameplayTag> ContextDamageType = RPGContext->GetDamageType())
+        {
+            const FRPGDamageTypeInfo* Info = DamageTypeInfos.Find(*ContextDamageType);
+            ExplicitTypeInfo = Info && Info->ResistanceDef ? Info : nullptr;
+        }
     }
-    if (Damage == 0.f)
+
+    // Resolver tipo e magnitude do dano com uma busca na tabela por entrada SetByCaller
+    // (Damage genérico mantém prioridade na magnitude; o tipo específico define a resistência).
+    // Vários tipos no SetByCaller: vence a menor Priority, nunca a ordem de iteração do TMap
+    const FRPGDamageTypeInfo* PriorityTypeInfo = nullptr;
+    float GenericDamage = 0.f;
+    float PriorityDamage = 0.f;
+    float ExplicitDamage = 0.f;
+    for (const TPair<FGameplayTag, float>& SetByCaller : Spec.SetByCallerTagMagnitudes)
     {
-        Damage = Spec.GetSetByCallerMagnitude(Tags.Damage_Arcane, false, 0.f);
+        if (SetByCaller.Value == 0.f)
+        {
+            continue;
+        }
+        const FRPGDamageTypeInfo* Info = DamageTypeInfos.Find(SetByCaller.Key);
+        if (!Info)
+        {
+            continue;
+        }
+        if (!Info->ResistanceDef)
+        {
+            GenericDamage = SetByCaller.Value;
+            continue;
+        }
+        if (Info == ExplicitTypeInfo)
+        {
+            ExplicitDamage = SetByCaller.Value;
+        }
+        if (!PriorityTypeInfo || Info->Priority < PriorityTypeInfo->Priority)
+        {
+            PriorityTypeInfo = Info;
+            PriorityDamage = SetByCaller.Value;
+        }
     }
+    const FRPGDamageTypeInfo* DamageTypeInfo = ExplicitTypeInfo ? ExplicitTypeInfo : PriorityTypeInfo;
+    const float TypedDamage = ExplicitDamage != 0.f ? ExplicitDamage : PriorityDamage;
+    float Damage = GenericDamage != 0.f ? GenericDamage : TypedDamage;
     Damage = FMath::Max(0.f, Damage);
     
     // Capturar Attack do Source (personagem + equipamentos)
@@ -126,41 +215,26 @@ void UExecCalc_Damage::Execute_Implementation(const FGameplayEffectCustomExecuti
 
 
 	// Sistema de Block removido - pode ser implementado como habilidade especial
-	FGameplayEffectContextHandle EffectContextHandle = Spec.GetContext();
 
-	// Sistema de resistências baseado no tipo de dano
-	
-	// Verificar tipo de dano e aplicar resistência correta
-	float ResistanceReduction = 0.f;
-	
-	if (SourceTags->HasTag(Tags.Damage_Physical))
-	{
-		// Dano físico - usar Armor
-		float TargetArmor = 0.f;
-		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().ArmorDef, EvaluationParameters, TargetArmor);
-		TargetArmor = FMath::Max<float>(TargetArmor, 0.f);
-		ResistanceReduction = TargetArmor;
-	}
-	else if (SourceTags->HasTag(Tags.Damage_Fire))
-	{
-		// Dano de fogo - usar Fire Resistance
-		float FireResistance = 0.f;
-		// TODO: Capturar FireResistance do Target
-		ResistanceReduction = FireResistance;
-	}
-	else if (SourceTags->HasTag(Tags.Damage_Lightning))
+	// Fallback legado: tipo de dano presente nas tags do Source, na ordem de prioridade da tabela
+	if (!DamageTypeInfo)
 	{
-		// Dano de relâmpago - usar Lightning Resistance
-		float LightningResistance = 0.f;
-		// TODO: Capturar LightningResistance do Target
-		ResistanceReduction = LightningResistance;
+		for (const FGameplayTag& DamageTypeTag : DamageStatics().TypedDamageTagsByPriority)
+		{
+			if (SourceTags->HasTag(DamageTypeTag))
+			{
+				DamageTypeInfo = DamageTypeInfos.Find(DamageTypeTag);
+				break;
+			}
+		}
 	}
-	else if (SourceTags->HasTag(Tags.Damage_Arcane))
+
+	// Sistema de resistências baseado no tipo de dano
+	float ResistanceReduction = 0.f;
+	if (DamageTypeInfo && DamageTypeInfo->ResistanceDef)
 	{
-		// Dano arcano - usar Arcane Resistance
-		float ArcaneResistance = 0.f;
-		// TODO: Capturar ArcaneResistance do Target
-		ResistanceReduction = ArcaneResistance;
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(*DamageTypeInfo->ResistanceDef, EvaluationParameters, ResistanceReduction);
+		ResistanceReduction = FMath::Max<float>(ResistanceReduction, 0.f);
 	}
 	
 	// Aplicar redução de resistência (com verificação de segurança)
@@ -168,13 +242,13 @@ void UExecCalc_Damage::Execute_Implementation(const FGameplayEffectCustomExecuti
 	{
 		// Resistência total - dano reduzido a 0
 		Damage = 0.f;
-		UE_LOG(LogTemp, Log, TEXT("[ExecCalc_Damage] Resistência total aplicada - dano reduzido a 0"));
+		RPG_DAMAGE_LOG(Verbose, TEXT("[ExecCalc_Damage] Resistência total aplicada - dano reduzido a 0"));
 	}
 	else if (ResistanceReduction > 0.f)
 	{
 		// Aplicar redução de resistência
 		Damage *= (100.f - ResistanceReduction) / 100.f;
-		UE_LOG(LogTemp, Log, TEXT("[ExecCalc_Damage] Resistência aplicada: %.1f%%, Dano final: %.1f"), ResistanceReduction, Damage);
+		RPG_DAMAGE_LOG(Verbose, TEXT("[ExecCalc_Damage] Resistência aplicada: %.1f%%, Dano final: %.1f"), ResistanceReduction, Damage);
 	}
 
 	// Sistema de Critical Hit removido - pode ser implementado como habilidade especial
@@ -186,7 +260,7 @@ void UExecCalc_Damage::Execute_Implementation(const FGameplayEffectCustomExecuti
     Damage = FMath::Max(0.f, Damage);
     
     // Log do dano final para debug
-    UE_LOG(LogTemp, Log, TEXT("[ExecCalc_Damage] Dano final calculado: %.1f (Base: %.1f, Attack: %.1f)"), Damage, Damage - SourceAttack, SourceAttack);
+    RPG_DAMAGE_LOG(Verbose, TEXT("[ExecCalc_Damage] Dano final calculado: %.1f (Base: %.1f, Attack: %.1f)"), Damage, Damage - SourceAttack, SourceAttack);
 
 	// Só aplicar dano se for maior que 0
 	if (Damage > 0.f)
@@ -196,6 +270,6 @@ void UExecCalc_Damage::Execute_Implementation(const FGameplayEffectCustomExecuti
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[ExecCalc_Damage] Dano é 0 ou negativo - não aplicando dano"));
+		RPG_DAMAGE_LOG(Verbose, TEXT("[ExecCalc_Damage] Dano é 0 ou negativo - não aplicando dano"));
 	}
 }
@@ -1,6 +1,7 @@
 // Copyright Druid Mechanics
 
 #include "AbilitySystem/Core/RPGAbilitySystemComponent.h"
+#include "AI/RPGAIStressStats.h"
 #include "Net/UnrealNetwork.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "RPGGameplayTags.h"
@@ -34,19 +35,30 @@ void URPGAbilitySystemComponent::AddCharacterPassiveAbilities(const TArray<TSubc
     }
 }
 
+void URPGAbilitySystemComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	// Coluna AbilitySystem do harness de carga de IA (junto com as entradas de input abaixo)
+	RPG_AI_STRESS_SCOPE(AbilitySystem);
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
 void URPGAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& InputTag)
 {
 	if (!InputTag.IsValid()) return;
+	RPG_AI_STRESS_SCOPE(AbilitySystem);
 	FScopedAbilityListLock ActiveScopeLock(*this);
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	// Copia local: ativar habilidades pode reentrar e reconstruir a tabela
+	TArray<FInputTagSpecRef, TInlineAllocator<4>> SpecRefs;
+	GetInputTagSpecRefs(InputTag, SpecRefs);
+	for (const FInputTagSpecRef& SpecRef : SpecRefs)
 	{
-		if (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag))
+		FGameplayAbilitySpec* AbilitySpecPtr = ResolveInputTagSpecRef(SpecRef);
+		if (!AbilitySpecPtr) continue;
+		FGameplayAbilitySpec& AbilitySpec = *AbilitySpecPtr;
+		AbilitySpecInputPressed(AbilitySpec);
+		if (AbilitySpec.IsActive())
 		{
-			AbilitySpecInputPressed(AbilitySpec);
-			if (AbilitySpec.IsActive())
-			{
-				InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, AbilitySpec.Handle, AbilitySpec.ActivationInfo.GetActivationPredictionKey());
-			}
+			InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, AbilitySpec.Handle, AbilitySpec.ActivationInfo.GetActivationPredictionKey());
 		}
 	}
 	
@@ -65,35 +77,54 @@ void URPGAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& Inpu
 void URPGAbilitySystemComponent::AbilityInputTagHeld(const FGameplayTag& InputTag)
 {
 	if (!InputTag.IsValid()) return;
+	RPG_AI_STRESS_SCOPE(AbilitySystem);
 	FScopedAbilityListLock ActiveScopeLock(*this);
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	// Copia local: ativar habilidades pode reentrar e reconstruir a tabela
+	TArray<FInputTagSpecRef, TInlineAllocator<4>> SpecRefs;
+	GetInputTagSpecRefs(InputTag, SpecRefs);
+	for (const FInputTagSpecRef& SpecRef : SpecRefs)
 	{
-		if (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag))
+		FGameplayAbilitySpec* AbilitySpecPtr = ResolveInputTagSpecRef(SpecRef);
+		if (!AbilitySpecPtr) continue;
+		FGameplayAbilitySpec& AbilitySpec = *AbilitySpecPtr;
+		AbilitySpecInputPressed(AbilitySpec);
+		if (!AbilitySpec.IsActive())
 		{
-			AbilitySpecInputPressed(AbilitySpec);
-			if (!AbilitySpec.IsActive())
-			{
-				TryActivateAbility(AbilitySpec.Handle);
-			}
+			TryActivateAbility(AbilitySpec.Handle);
 		}
 	}
 	
-	// Enviar evento usando a tag criada
-	if (GetAvatarActor())
+	// Held dispara todo frame: o evento genérico pode ser suprimido ou limitado
+	if (bSuppressInputHeldEvent || !GetAvatarActor()) return;
+	
+	if (InputHeldEventInterval > 0.f)
 	{
-		FGameplayEventData Payload;
-		Payload.EventTag = FRPGGameplayTags::Get().Events_Abilities_InputHeld;
-		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(GetAvatarActor(), FRPGGameplayTags::Get().Events_Abilities_InputHeld, Payload);
+		const double Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+		double& LastTime = LastInputHeldEventTime.FindOrAdd(InputTag, TNumericLimits<double>::Lowest());
+		if (Now - LastTime < InputHeldEventInterval) return;
+		LastTime = Now;
 	}
+	
+	// Enviar evento usando a tag criada
+	FGameplayEventData Payload;
+	Payload.EventTag = FRPGGameplayTags::Get().Events_Abilities_InputHeld;
+	UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(GetAvatarActor(), FRPGGameplayTags::Get().Events_Abilities_InputHeld, Payload);
 }
 
 void URPGAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& InputTag)
 {
 	if (!InputTag.IsValid()) return;
+	RPG_AI_STRESS_SCOPE(AbilitySystem);
 	FScopedAbilityListLock ActiveScopeLock(*this);
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	// Copia local: ativar habilidades pode reentrar e reconstruir a tabela
+	TArray<FInputTagSpecRef, TInlineAllocator<4>> SpecRefs;
+	GetInputTagSpecRefs(InputTag, SpecRefs);
+	for (const FInputTagSpecRef& SpecRef : SpecRefs)
 	{
-		if (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag) && AbilitySpec.IsActive())
+		FGameplayAbilitySpec* AbilitySpecPtr = ResolveInputTagSpecRef(SpecRef);
+		if (!AbilitySpecPtr) continue;
+		FGameplayAbilitySpec& AbilitySpec = *AbilitySpecPtr;
+		if (AbilitySpec.IsActive())
 		{
 			AbilitySpecInputReleased(AbilitySpec);
 			InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputReleased, AbilitySpec.Handle, AbilitySpec.ActivationInfo.GetActivationPredictionKey());
@@ -154,9 +185,11 @@ AActor* URPGAbilitySystemComponent::GetAvatarActor() const
 bool URPGAbilitySystemComponent::HasActiveAbilityWithInputTag(const FGameplayTag& InputTag) const
 {
     if (!InputTag.IsValid()) return false;
-    for (const FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+    TArray<FInputTagSpecRef, TInlineAllocator<4>> SpecRefs;
+    GetInputTagSpecRefs(InputTag, SpecRefs);
+    for (const FInputTagSpecRef& SpecRef : SpecRefs)
     {
-        if (AbilitySpec.IsActive() && AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag))
+        if (GetActivatableAbilities()[SpecRef.SpecIndex].IsActive())
         {
             return true;
         }
@@ -164,6 +197,69 @@ bool URPGAbilitySystemComponent::HasActiveAbilityWithInputTag(const FGameplayTag
     return false;
 }
 
+// === ROTEAMENTO DE INPUT ===
+
+void URPGAbilitySystemComponent::RebuildInputTagRouting() const
+{
+    InputTagRouting.Reset();
+    
+    const TArray<FGameplayAbilitySpec>& Specs = GetActivatableAbilities();
+    for (int32 SpecIndex = 0; SpecIndex < Specs.Num(); ++SpecIndex)
+    {
+        const FGameplayAbilitySpec& AbilitySpec = Specs[SpecIndex];
+        for (const FGameplayTag& Tag : AbilitySpec.GetDynamicSpecSourceTags())
+        {
+            InputTagRouting.FindOrAdd(Tag).Add({ SpecIndex, AbilitySpec.Handle });
+        }
+    }
+    
+    bInputTagRoutingDirty = false;
+}
+
+void URPGAbilitySystemComponent::GetInputTagSpecRefs(const FGameplayTag& InputTag, TArray<FInputTagSpecRef, TInlineAllocator<4>>& OutSpecRefs) const
+{
+    OutSpecRefs.Reset();
+    
+    if (bInputTagRoutingDirty)
+    {
+        RebuildInputTagRouting();
+    }
+    
+    const TArray<FInputTagSpecRef>* SpecRefs = InputTagRouting.Find(InputTag);
+    if (!SpecRefs)
+    {
+        return;
+    }
+    
+    // Validar que os índices ainda apontam para os mesmos specs; reconstruir se não
+    const TArray<FGameplayAbilitySpec>& Specs = GetActivatableAbilities();
+    for (const FInputTagSpecRef& SpecRef : *SpecRefs)
+    {
+        if (!Specs.IsValidIndex(SpecRef.SpecIndex) || Specs[SpecRef.SpecIndex].Handle != SpecRef.Handle
+            || !Specs[SpecRef.SpecIndex].GetDynamicSpecSourceTags().HasTagExact(InputTag))
+        {
+            RebuildInputTagRouting();
+            SpecRefs = InputTagRouting.Find(InputTag);
+            break;
+        }
+    }
+    
+    if (SpecRefs)
+    {
+        OutSpecRefs.Append(*SpecRefs);
+    }
+}
+
+FGameplayAbilitySpec* URPGAbilitySystemComponent::ResolveInputTagSpecRef(const FInputTagSpecRef& SpecRef)
+{
+    TArray<FGameplayAbilitySpec>& Specs = GetActivatableAbilities();
+    if (Specs.IsValidIndex(SpecRef.SpecIndex) && Specs[SpecRef.SpecIndex].Handle == SpecRef.Handle)
+    {
+        return &Specs[SpecRef.SpecIndex];
+    }
+    return nullptr;
+}
+
 // === ABILITY LEVEL MANAGEMENT ===
 
 void URPGAbilitySystemComponent::SetAbilityLevel(TSubclassOf<UGameplayAbility> AbilityClass, int32 Level)
@@ -245,12 +341,20 @@ void URPGAbilitySystemComponent::ServerAddToAbilityLevel_Implementation(TSubclas
 void URPGAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
 {
     Super::OnGiveAbility(AbilitySpec);
+    bInputTagRoutingDirty = true;
     HandleAutoActivateAbility(AbilitySpec);
 }
 
+void URPGAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+    Super::OnRemoveAbility(AbilitySpec);
+    bInputTagRoutingDirty = true;
+}
+
 void URPGAbilitySystemComponent::OnRep_ActivateAbilities()
 {
     Super::OnRep_ActivateAbilities();
+    bInputTagRoutingDirty = true;
     
     FScopedAbilityListLock ActiveScopeLock(*this);
     for (const FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
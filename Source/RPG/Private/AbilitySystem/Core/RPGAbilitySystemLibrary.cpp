@@ -7,7 +7,9 @@
 #include "AbilitySystem/Data/EnemyClassInfo.h"
 #include "Kismet/GameplayStatics.h"
 #include "Interaction/CombatInterface.h"
+#include "Character/RPGCombatantSpatialSubsystem.h"
 #include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
 #include "GenericTeamAgentInterface.h"
 #include "Game/RPGGameInstance.h"
 #include "RPGAbilityTypes.h"
@@ -18,6 +20,7 @@
 #include "Engine/OverlapResult.h"
 #include "Engine/World.h"
 #include "RPGGameplayTags.h"
+#include "AbilitySystem/Core/RPGAttributeSet.h"
 
 bool URPGAbilitySystemLibrary::IsBlockedHit(const FGameplayEffectContextHandle& EffectContextHandle)
 {
@@ -111,55 +114,127 @@ void URPGAbilitySystemLibrary::SetRadialDamageOrigin(FGameplayEffectContextHandl
 
 void URPGAbilitySystemLibrary::InitializeDefaultAttributes(const UObject* WorldContextObject, ECharacterClass CharacterClass, float Level, UAbilitySystemComponent* ASC)
 {
-    if (!ASC) return;
+    InitializeDefaultAttributesForGameMode(Cast<ARPGGameModeBase>(UGameplayStatics::GetGameMode(WorldContextObject)), CharacterClass, Level, ASC);
+}
 
-    if (ARPGGameModeBase* RPGGameMode = Cast<ARPGGameModeBase>(UGameplayStatics::GetGameMode(WorldContextObject)))
+void URPGAbilitySystemLibrary::InitializeDefaultAttributesForGameMode(ARPGGameModeBase* RPGGameMode, ECharacterClass CharacterClass, float Level, UAbilitySystemComponent* ASC)
+{
+    if (!ASC || !RPGGameMode) return;
+
+    UEnemyClassInfo* CharacterClassInfo = RPGGameMode->EnemyClassInfo;
+    if (!CharacterClassInfo) return;
+
+    // OTIMIZAÇÃO: spawns seguintes do mesmo (classe, nível) aplicam os valores finais em uma
+    // única passada, sem montar specs nem avaliar MMCs/agregadores
+    const int32 BaselineLevel = FMath::TruncToInt32(Level);
+    const bool bUseBaseline = static_cast<float>(BaselineLevel) == Level && CharacterClassInfo->CanBakeAttributeBaselines(CharacterClass);
+    const FEnemyAttributeBaseline* Baseline = bUseBaseline ? RPGGameMode->FindEnemyAttributeBaseline(CharacterClass, BaselineLevel) : nullptr;
+
+    if (Baseline)
     {
-        if (UEnemyClassInfo* CharacterClassInfo = RPGGameMode->EnemyClassInfo)
+        for (const TPair<FGameplayAttribute, float>& Value : Baseline->Values)
         {
-            FCharacterClassDefaultInfo ClassDefaultInfo = CharacterClassInfo->GetClassDefaultInfo(CharacterClass);
-
-            UObject* AvatarActor = ASC->GetAvatarActor();
-
-            // Primary Attributes
-            if (ClassDefaultInfo.PrimaryAttributes)
-            {
-                FGameplayEffectContextHandle ContextHandle = ASC->MakeEffectContext();
-                ContextHandle.AddSourceObject(AvatarActor);
-                const FGameplayEffectSpecHandle SpecHandle = ASC->MakeOutgoingSpec(ClassDefaultInfo.PrimaryAttributes, Level, ContextHandle);
-                if (SpecHandle.IsValid() && SpecHandle.Data.Get())
-                {
-                    ASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
-                }
-            }
-
-            // Secondary Attributes
-            if (CharacterClassInfo->SecondaryAttributes)
-            {
-                FGameplayEffectContextHandle ContextHandle = ASC->MakeEffectContext();
-                ContextHandle.AddSourceObject(AvatarActor);
-                const FGameplayEffectSpecHandle SpecHandle = ASC->MakeOutgoingSpec(CharacterClassInfo->SecondaryAttributes, Level, ContextHandle);
-                if (SpecHandle.IsValid() && SpecHandle.Data.Get())
-                {
-                    ASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
-                }
-            }
-
-            // Vital Attributes
-            if (CharacterClassInfo->VitalAttributes)
-            {
-                FGameplayEffectContextHandle ContextHandle = ASC->MakeEffectContext();
-                ContextHandle.AddSourceObject(AvatarActor);
-                const FGameplayEffectSpecHandle SpecHandle = ASC->MakeOutgoingSpec(CharacterClassInfo->VitalAttributes, Level, ContextHandle);
-                if (SpecHandle.IsValid() && SpecHandle.Data.Get())
-                {
-                    ASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
-                }
-            }
+            ASC->SetNumericAttributeBase(Value.Key, Value.Value);
         }
+        return;
+    }
+
+    ApplyDefaultAttributeEffects(CharacterClassInfo, CharacterClass, Level, ASC);
+
+    if (bUseBaseline)
+    {
+        RPGGameMode->StoreEnemyAttributeBaseline(CharacterClass, BaselineLevel, MakeAttributeBaseline(CharacterClassInfo, CharacterClass, ASC));
     }
 }
 
+void URPGAbilitySystemLibrary::ApplyDefaultAttributeEffects(UEnemyClassInfo* CharacterClassInfo, ECharacterClass CharacterClass, float Level, UAbilitySystemComponent* ASC)
+{
+    FCharacterClassDefaultInfo ClassDefaultInfo = CharacterClassInfo->GetClassDefaultInfo(CharacterClass);
+
+    UObject* AvatarActor = ASC->GetAvatarActor();
+
+    // Primary Attributes
+    if (ClassDefaultInfo.PrimaryAttributes)
+    {
+        FGameplayEffectContextHandle ContextHandle = ASC->MakeEffectContext();
+        ContextHandle.AddSourceObject(AvatarActor);
+        const FGameplayEffectSpecHandle SpecHandle = ASC->MakeOutgoingSpec(ClassDefaultInfo.PrimaryAttributes, Level, ContextHandle);
+        if (SpecHandle.IsValid() && SpecHandle.Data.Get())
+        {
+            ASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+        }
+    }
+
+    // Secondary Attributes
+    if (CharacterClassInfo->SecondaryAttributes)
+    {
+        FGameplayEffectContextHandle ContextHandle = ASC->MakeEffectContext();
+        ContextHandle.AddSourceObject(AvatarActor);
+        const FGameplayEffectSpecHandle SpecHandle = ASC->MakeOutgoingSpec(CharacterClassInfo->SecondaryAttributes, Level, ContextHandle);
+        if (SpecHandle.IsValid() && SpecHandle.Data.Get())
+        {
+            ASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+        }
+    }
+
+    // Vital Attributes
+    if (CharacterClassInfo->VitalAttributes)
+    {
+        FGameplayEffectContextHandle ContextHandle = ASC->MakeEffectContext();
+        ContextHandle.AddSourceObject(AvatarActor);
+        const FGameplayEffectSpecHandle SpecHandle = ASC->MakeOutgoingSpec(CharacterClassInfo->VitalAttributes, Level, ContextHandle);
+        if (SpecHandle.IsValid() && SpecHandle.Data.Get())
+        {
+            ASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+        }
+    }
+}
+
+FEnemyAttributeBaseline URPGAbilitySystemLibrary::MakeAttributeBaseline(UEnemyClassInfo* CharacterClassInfo, ECharacterClass CharacterClass, UAbilitySystemComponent* ASC)
+{
+    const TSubclassOf<UGameplayEffect> Effects[] = {
+        CharacterClassInfo->GetClassDefaultInfo(CharacterClass).PrimaryAttributes,
+        CharacterClassInfo->SecondaryAttributes,
+        CharacterClassInfo->VitalAttributes
+    };
+
+    // Apenas os atributos que os GEs de inicialização modificam; os demais ficam com o valor padrão do AttributeSet
+    TArray<FGameplayAttribute> Attributes;
+    bool bHasExecutions = false;
+    for (const TSubclassOf<UGameplayEffect>& EffectClass : Effects)
+    {
+        if (!EffectClass) continue;
+
+        const UGameplayEffect* Effect = EffectClass.GetDefaultObject();
+        for (const FGameplayModifierInfo& Modifier : Effect->Modifiers)
+        {
+            Attributes.AddUnique(Modifier.Attribute);
+        }
+        bHasExecutions |= Effect->Executions.Num() > 0;
+    }
+
+    // Executions podem escrever em qualquer atributo: nesse caso o snapshot cobre todos
+    if (bHasExecutions)
+    {
+        Attributes.Reset();
+        ASC->GetAllAttributes(Attributes);
+    }
+
+    FEnemyAttributeBaseline Baseline;
+    Baseline.Values.Reserve(Attributes.Num());
+    for (const FGameplayAttribute& Attribute : Attributes)
+    {
+        // Meta atributos são transitórios (dano/XP recebidos)
+        if (Attribute == URPGAttributeSet::GetIncomingDamageAttribute() || Attribute == URPGAttributeSet::GetIncomingXPAttribute())
+        {
+            continue;
+        }
+        // Valor atual: inclui modificadores de GEs Infinite quando bBakeNonInstantAttributeEffects
+        Baseline.Values.Emplace(Attribute, ASC->GetNumericAttribute(Attribute));
+    }
+    return Baseline;
+}
+
 void URPGAbilitySystemLibrary::GiveStartupAbilities(const UObject* WorldContextObject, UAbilitySystemComponent* ASC, ECharacterClass CharacterClass)
 {
 	UEnemyClassInfo* CharacterClassInfo = GetCharacterClassInfo(WorldContextObject);
@@ -202,6 +277,25 @@ int32 URPGAbilitySystemLibrary::GetXPRewardForClassAndLevel(const UObject* World
 
 void URPGAbilitySystemLibrary::GetLivePlayersWithinRadius(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors, const TArray<AActor*>& ActorsToIgnore, float Radius, const FVector& SphereOrigin)
 {
+	// OTIMIZAÇÃO: hash espacial de combatentes (sem overlap de física); o resultado passa pelo
+	// mesmo mapeamento para o avatar e dedupe contra o que já estava em OutOverlappingActors
+	if (const URPGCombatantSpatialSubsystem* CombatantSpatial = URPGCombatantSpatialSubsystem::Get(WorldContextObject))
+	{
+		FRPGCombatantQueryFilter Filter;
+		Filter.IgnoredActors = ActorsToIgnore;
+
+		TArray<AActor*> Combatants;
+		CombatantSpatial->QueryRadius(SphereOrigin, Radius, Filter, Combatants);
+		for (AActor* Combatant : Combatants)
+		{
+			if (Combatant->Implements<UCombatInterface>())
+			{
+				OutOverlappingActors.AddUnique(ICombatInterface::Execute_GetAvatar(Combatant));
+			}
+		}
+		return;
+	}
+
 	FCollisionQueryParams SphereParams;
 	SphereParams.AddIgnoredActors(ActorsToIgnore);
 
@@ -266,13 +360,13 @@ bool URPGAbilitySystemLibrary::IsNotFriend(AActor* FirstActor, AActor* SecondAct
 	return true;
 }
 
-FGameplayEffectContextHandle URPGAbilitySystemLibrary::ApplyDamageEffect(const FDamageEffectParams& DamageEffectParams)
+FGameplayEffectSpecHandle URPGAbilitySystemLibrary::MakeDamageEffectSpec(const FDamageEffectParams& DamageEffectParams)
 {
-	const FRPGGameplayTags& GameplayTags = FRPGGameplayTags::Get();
 	const AActor* SourceAvatarActor = DamageEffectParams.SourceAbilitySystemComponent->GetAvatarActor();
 	
 	FGameplayEffectContextHandle EffectContexthandle = DamageEffectParams.SourceAbilitySystemComponent->MakeEffectContext();
 	EffectContexthandle.AddSourceObject(SourceAvatarActor);
+	SetDamageType(EffectContexthandle, DamageEffectParams.DamageType);
 	SetDeathImpulse(EffectContexthandle, DamageEffectParams.DeathImpulse);
 	SetKnockbackForce(EffectContexthandle, DamageEffectParams.KnockbackForce);
 
@@ -284,9 +378,62 @@ FGameplayEffectContextHandle URPGAbilitySystemLibrary::ApplyDamageEffect(const F
 	const FGameplayEffectSpecHandle SpecHandle = DamageEffectParams.SourceAbilitySystemComponent->MakeOutgoingSpec(DamageEffectParams.DamageGameplayEffectClass, DamageEffectParams.AbilityLevel, EffectContexthandle);
 
 	UAbilitySystemBlueprintLibrary::AssignTagSetByCallerMagnitude(SpecHandle, DamageEffectParams.DamageType, DamageEffectParams.Attack);
+	return SpecHandle;
+}
+
+FGameplayEffectContextHandle URPGAbilitySystemLibrary::ApplyDamageEffect(const FDamageEffectParams& DamageEffectParams)
+{
+	const FGameplayEffectSpecHandle SpecHandle = MakeDamageEffectSpec(DamageEffectParams);
 	
 	DamageEffectParams.TargetAbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data);
-	return EffectContexthandle;
+	return SpecHandle.Data->GetEffectContext();
+}
+
+int32 URPGAbilitySystemLibrary::ApplyDamageEffectToTargets(const FDamageEffectParams& DamageEffectParams, TArrayView<AActor* const> TargetActors)
+{
+	if (!DamageEffectParams.SourceAbilitySystemComponent || !DamageEffectParams.DamageGameplayEffectClass || TargetActors.Num() == 0)
+	{
+		return 0;
+	}
+
+	// OTIMIZAÇÃO: Spec (e captura dos atributos do Source) montado uma única vez para todos os alvos
+	const FGameplayEffectSpecHandle SpecHandle = MakeDamageEffectSpec(DamageEffectParams);
+	if (!SpecHandle.IsValid())
+	{
+		return 0;
+	}
+
+	FGameplayEffectSpec& Spec = *SpecHandle.Data;
+	const FGameplayEffectContextHandle BaseContextHandle = Spec.GetEffectContext();
+
+	// Resolver ASCs alvo antes de aplicar (ignora atores sem ASC e duplicados)
+	TArray<UAbilitySystemComponent*, TInlineAllocator<32>> TargetASCs;
+	TargetASCs.Reserve(TargetActors.Num());
+	for (AActor* TargetActor : TargetActors)
+	{
+		if (UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(TargetActor))
+		{
+			TargetASCs.AddUnique(TargetASC);
+		}
+	}
+
+	int32 NumApplied = 0;
+	for (UAbilitySystemComponent* TargetASC : TargetASCs)
+	{
+		// Cada alvo recebe sua própria cópia do contexto (ExecCalcs podem escrever nele)
+		if (NumApplied > 0)
+		{
+			Spec.SetContext(BaseContextHandle.Duplicate(), true);
+		}
+		TargetASC->ApplyGameplayEffectSpecToSelf(Spec);
+		++NumApplied;
+	}
+	return NumApplied;
+}
+
+int32 URPGAbilitySystemLibrary::ApplyDamageEffectToActors(const FDamageEffectParams& DamageEffectParams, const TArray<AActor*>& TargetActors)
+{
+	return ApplyDamageEffectToTargets(DamageEffectParams, TargetActors);
 }
 
 TArray<FRotator> URPGAbilitySystemLibrary::EvenlySpacedRotators(const FVector& Forward, const FVector& Axis, float Spread, int32 NumRotators)
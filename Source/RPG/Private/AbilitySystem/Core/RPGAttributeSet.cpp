@@ -26,6 +26,7 @@
 // AI & Perception
 #include "Perception/AIPerceptionSystem.h"
 #include "Perception/AISense_Damage.h"
+#include "AI/RPGThreatSubsystem.h"
 
 // Quests
 #include "Quest/QuestSubsystem.h"
@@ -91,6 +92,13 @@ void URPGAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
         // Verificar se Health chegou a 0 ou menos (morte) quando modificado diretamente
         // Só verificar se não foi através de IncomingDamage (que já trata morte no bloco abaixo)
         const float HealthAfterClamp = GetHealth();
+
+        // Cura gera ameaça do curador nos inimigos engajados com o alvo (só o que de fato recuperou)
+        if (Data.EvaluatedData.ModifierOp == EGameplayModOp::Additive && Data.EvaluatedData.Magnitude > 0.f)
+        {
+            const float HealedAmount = HealthAfterClamp - (HealthBeforeModification - Data.EvaluatedData.Magnitude);
+            URPGThreatSubsystem::ReportHealing(Props.TargetAvatarActor, Props.SourceAvatarActor, HealedAmount);
+        }
         if (HealthAfterClamp <= 0.f && HealthBeforeModification > 0.f)
         {
             // Verificar se o dano não veio de IncomingDamage (para evitar duplicação)
@@ -134,6 +142,9 @@ void URPGAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
                     Props.TargetAvatarActor->GetActorLocation()
                 );
                 UAIPerceptionSystem::OnEvent(Props.TargetAvatarActor->GetWorld(), DamageEvent);
+
+                // OTIMIZAÇÃO: ameaça somada incrementalmente na tabela do inimigo atingido
+                URPGThreatSubsystem::ReportDamage(Props.TargetAvatarActor, Props.SourceAvatarActor, LocalIncomingDamage);
             }
 
             const bool bFatal = NewHealth <= 0.f;
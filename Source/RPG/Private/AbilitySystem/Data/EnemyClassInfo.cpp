@@ -1,6 +1,7 @@
 // Copyright Druid Mechanics
 
 #include "AbilitySystem/Data/EnemyClassInfo.h"
+#include "GameplayEffect.h"
 
 FCharacterClassDefaultInfo UEnemyClassInfo::GetClassDefaultInfo(ECharacterClass CharacterClass)
 {
@@ -11,3 +12,26 @@ FCharacterClassDefaultInfo UEnemyClassInfo::GetClassDefaultInfo(ECharacterClass
     // Retorne um default
     return FCharacterClassDefaultInfo();
 }
+
+bool UEnemyClassInfo::CanBakeAttributeBaselines(ECharacterClass CharacterClass) const
+{
+    if (!bBakeAttributeBaselines)
+    {
+        return false;
+    }
+    if (bBakeNonInstantAttributeEffects)
+    {
+        return true;
+    }
+
+    // Um GE Infinite/HasDuration precisa continuar ativo no ASC; baseline fixo mudaria o comportamento
+    auto IsInstantOrUnset = [](const TSubclassOf<UGameplayEffect>& EffectClass)
+    {
+        return !EffectClass || EffectClass.GetDefaultObject()->DurationPolicy == EGameplayEffectDurationType::Instant;
+    };
+
+    const FCharacterClassDefaultInfo* ClassInfo = CharacterClassInformation.Find(CharacterClass);
+    return IsInstantOrUnset(ClassInfo ? ClassInfo->PrimaryAttributes : nullptr)
+        && IsInstantOrUnset(SecondaryAttributes)
+        && IsInstantOrUnset(VitalAttributes);
+}
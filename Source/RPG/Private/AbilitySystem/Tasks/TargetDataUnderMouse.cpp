@@ -6,13 +6,15 @@
 #include "RPG/RPG.h"
 #include "Character/RPGCharacter.h"
 #include "DrawDebugHelpers.h"
+#include "WorldCollision.h"
 
-UTargetDataUnderMouse* UTargetDataUnderMouse::CreateTargetDataUnderMouse(UGameplayAbility* OwningAbility, float MaxTraceRange, bool bDrawDebugTrace, bool bUsePawnViewPoint)
+UTargetDataUnderMouse* UTargetDataUnderMouse::CreateTargetDataUnderMouse(UGameplayAbility* OwningAbility, float MaxTraceRange, bool bDrawDebugTrace, bool bUsePawnViewPoint, bool bUseAsyncTrace)
 {
 	UTargetDataUnderMouse* MyObj = NewAbilityTask<UTargetDataUnderMouse>(OwningAbility);
 	MyObj->MaxTraceRange = MaxTraceRange;
 	MyObj->bDrawDebugTrace = bDrawDebugTrace;
 	MyObj->bUsePawnViewPoint = bUsePawnViewPoint;
+	MyObj->bUseAsyncTrace = bUseAsyncTrace;
 	return MyObj;
 }
 
@@ -38,14 +40,58 @@ void UTargetDataUnderMouse::Activate()
 
 void UTargetDataUnderMouse::SendMouseCursorData()
 {
+	FVector Start;
+	FVector End;
+	if (!GetCursorTraceSegment(Start, End))
+	{
+		return;
+	}
+
+	// Trace simples - sempre vai acertar algo (objeto real ou backstop)
+	FCollisionQueryParams Params(NAME_None, false, nullptr); // Comentado PC->GetPawn() para teste
+
+	if (bUseAsyncTrace)
+	{
+		// OTIMIZAÇÃO: trace assíncrono; o TargetData é enviado quando o resultado chegar
+		FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &UTargetDataUnderMouse::OnAsyncCursorTraceDone);
+		GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, ECC_Visibility, Params, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate);
+		return;
+	}
+
 	FScopedPredictionWindow ScopedPrediction(AbilitySystemComponent.Get());
-	
+
+	FHitResult CursorHit;
+	GetWorld()->LineTraceSingleByChannel(CursorHit, Start, End, ECC_Visibility, Params);
+	SendCursorHit(CursorHit, Start, End, AbilitySystemComponent->ScopedPredictionKey);
+}
+
+void UTargetDataUnderMouse::OnAsyncCursorTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	// A task pode ter terminado enquanto o trace estava em andamento
+	if (!IsValid(Ability) || !AbilitySystemComponent.IsValid() || IsFinished())
+	{
+		return;
+	}
+
+	// A janela da ativação já fechou: uma janela nova gera a chave que acompanha o TargetData
+	FScopedPredictionWindow ScopedPrediction(AbilitySystemComponent.Get());
+
+	FHitResult CursorHit;
+	if (TraceDatum.OutHits.Num() > 0)
+	{
+		CursorHit = TraceDatum.OutHits[0];
+	}
+	SendCursorHit(CursorHit, TraceDatum.Start, TraceDatum.End, AbilitySystemComponent->ScopedPredictionKey);
+}
+
+bool UTargetDataUnderMouse::GetCursorTraceSegment(FVector& OutStart, FVector& OutEnd) const
+{
 	// Trace a partir do personagem (não da câmera)
 	ARPGCharacter* RPGChar = Cast<ARPGCharacter>(Ability->GetCurrentActorInfo()->AvatarActor);
 	if (!RPGChar)
 	{
 		UE_LOG(LogTemp, Error, TEXT("[TargetDataUnderMouse] AvatarActor não é um RPGCharacter"));
-		return;
+		return false;
 	}
 	
 	// Backstop removido - não é mais necessário com o trace da frente da câmera
@@ -77,20 +123,19 @@ void UTargetDataUnderMouse::SendMouseCursorData()
 	}
 	
 	// Usar direção da câmera/pawn e começar um pouco na frente
-	FVector Start = CameraLocation + ViewRot.Vector() * 100.f; // 100cm na frente
-	FVector Direction = ViewRot.Vector();
+	OutStart = CameraLocation + ViewRot.Vector() * 100.f; // 100cm na frente
+	const FVector Direction = ViewRot.Vector();
 	
 	// Usar MaxTraceRange configurado ou o padrão do personagem
-	float MaxRange = (MaxTraceRange > 0.f) ? MaxTraceRange : RPGChar->MaxTargetingRange;
+	const float MaxRange = (MaxTraceRange > 0.f) ? MaxTraceRange : RPGChar->MaxTargetingRange;
 	
 	// Calcular ponto de destino
-	FVector End = Start + Direction * MaxRange;
-	
-	// Trace simples - sempre vai acertar algo (objeto real ou backstop)
-	FCollisionQueryParams Params(NAME_None, false, nullptr); // Comentado PC->GetPawn() para teste
-	FHitResult CursorHit;
-	GetWorld()->LineTraceSingleByChannel(CursorHit, Start, End, ECC_Visibility, Params);
-	
+	OutEnd = OutStart + Direction * MaxRange;
+	return true;
+}
+
+void UTargetDataUnderMouse::SendCursorHit(const FHitResult& CursorHit, const FVector& Start, const FVector& End, const FPredictionKey& CurrentPredictionKey)
+{
 	// Debug visual do trace
 	if (bDrawDebugTrace)
 	{
@@ -146,7 +191,7 @@ void UTargetDataUnderMouse::SendMouseCursorData()
             GetActivationPredictionKey(),
             DataHandle,
             FGameplayTag(),
-            AbilitySystemComponent->ScopedPredictionKey);
+            CurrentPredictionKey);
     }
 
 	if (ShouldBroadcastAbilityTaskDelegates())
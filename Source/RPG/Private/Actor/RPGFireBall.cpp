@@ -10,24 +10,45 @@
 void ARPGFireBall::BeginPlay()
 {
 	Super::BeginPlay();
+	if (!IsPoolDormant())
+	{
+		StartOutgoingTimeline();
+	}
+}
+
+void ARPGFireBall::OnPoolActivated()
+{
+	Super::OnPoolActivated();
 	StartOutgoingTimeline();
 }
 
-void ARPGFireBall::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void ARPGFireBall::OnPoolDeactivated()
+{
+	Super::OnPoolDeactivated();
+	bExploded = false;
+	ReturnToActor = nullptr;
+	ExplosionDamageParams = FDamageEffectParams();
+}
+
+int32 ARPGFireBall::ApplyExplosionDamage()
 {
-	if (!IsValidOverlap(OtherActor)) return;
+	if (!HasAuthority() || ExplosionDamageParams.SourceAbilitySystemComponent == nullptr) return 0;
 
-	if (HasAuthority())
-	{
-		if (UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(OtherActor))
-		{
-			const FVector DeathImpulse = GetActorForwardVector() * ExplosionDamageParams.DeathImpulseMagnitude;
-			ExplosionDamageParams.DeathImpulse = DeathImpulse;
-			
-			ExplosionDamageParams.TargetAbilitySystemComponent = TargetASC;
-			URPGAbilitySystemLibrary::ApplyDamageEffect(ExplosionDamageParams);
-		}
-	}
+	AActor* SourceAvatarActor = ExplosionDamageParams.SourceAbilitySystemComponent->GetAvatarActor();
+
+	TArray<AActor*> ActorsToIgnore;
+	ActorsToIgnore.Add(this);
+	ActorsToIgnore.Add(SourceAvatarActor);
+
+	TArray<AActor*> OverlappingActors;
+	URPGAbilitySystemLibrary::GetLivePlayersWithinRadius(this, OverlappingActors, ActorsToIgnore, ExplosionDamageParams.RadialDamageOuterRadius, GetActorLocation());
+	OverlappingActors.RemoveAllSwap([this](AActor* Actor) { return !IsValidOverlap(Actor); });
+
+	ExplosionDamageParams.DeathImpulse = GetActorForwardVector() * ExplosionDamageParams.DeathImpulseMagnitude;
+	ExplosionDamageParams.RadialDamageOrigin = GetActorLocation();
+
+	// OTIMIZAÇÃO: um único spec para todos os alvos da explosão
+	return URPGAbilitySystemLibrary::ApplyDamageEffectToTargets(ExplosionDamageParams, OverlappingActors);
 }
 
 void ARPGFireBall::OnHit()
@@ -39,9 +60,22 @@ void ARPGFireBall::OnHit()
 		// CueParams.Location = GetActorLocation();
 		// UGameplayCueManager::ExecuteGameplayCue_NonReplicated(GetOwner(), FRPGGameplayTags::Get().GameplayCue_FireBlast, CueParams);
 	}
+
+	// Explosão ao retornar: dano em área em lote, uma única vez por lançamento (opt-in até o BP deixar de aplicar)
+	if (bApplyNativeExplosion && !bExploded)
+	{
+		bExploded = true;
+		ApplyExplosionDamage();
+	}
 	
 	// Chamar a função da classe base para lidar com sons e efeitos
 	Super::OnHit();
+
+	// Explodiu: volta para o pool (ou é destruída se não veio dele)
+	if (HasAuthority())
+	{
+		ReleaseToPoolOrDestroy();
+	}
 }
 
 bool ARPGFireBall::IsValidOverlap(AActor* OtherActor)
@@ -10,6 +10,8 @@
 #include "Perception/AIPerceptionSystem.h"
 #include "Perception/AISense_Hearing.h"
 #include "AbilitySystem/Core/RPGAbilitySystemLibrary.h"
+#include "Actor/RPGProjectilePoolSubsystem.h"
+#include "Net/UnrealNetwork.h"
 
 ARPGProjectile::ARPGProjectile()
 {
@@ -34,19 +36,120 @@ ARPGProjectile::ARPGProjectile()
 void ARPGProjectile::BeginPlay()
 {
 	Super::BeginPlay();
-	SetLifeSpan(LifeSpan);
 	SetReplicateMovement(true);
 	Sphere->OnComponentBeginOverlap.AddDynamic(this, &ARPGProjectile::OnSphereOverlap);
 
+	if (bPoolDormant)
+	{
+		// Pré-aquecido pelo pool: fica inativo até ser lançado
+		if (HasAuthority()) DeactivateToPool();
+		else SetDormantState(true);
+		return;
+	}
+	StartLifeSpan();
+
     // Removed looping sound
 }
 
 void ARPGProjectile::Destroyed()
 {
-    if (!bHit && !HasAuthority()) OnHit();
+    if (!bHit && !bPoolDormant && !HasAuthority()) OnHit();
 	Super::Destroyed();
 }
 
+void ARPGProjectile::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ARPGProjectile, bPoolDormant);
+}
+
+void ARPGProjectile::StartLifeSpan()
+{
+	if (!bIsPooled)
+	{
+		SetLifeSpan(LifeSpan);
+		return;
+	}
+
+	if (HasAuthority() && LifeSpan > 0.f)
+	{
+		GetWorldTimerManager().SetTimer(PooledLifeSpanTimerHandle, this, &ARPGProjectile::ReleaseToPoolOrDestroy, LifeSpan, false);
+	}
+}
+
+void ARPGProjectile::ReleaseToPoolOrDestroy()
+{
+	if (bIsPooled && HasAuthority())
+	{
+		if (URPGProjectilePoolSubsystem* Pool = GetWorld() ? GetWorld()->GetSubsystem<URPGProjectilePoolSubsystem>() : nullptr)
+		{
+			Pool->ReleaseProjectile(this);
+			return;
+		}
+	}
+	Destroy();
+}
+
+void ARPGProjectile::ActivateFromPool(const FTransform& SpawnTransform)
+{
+	bPoolDormant = false;
+	bHit = false;
+
+	SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+	SetDormantState(false);
+
+	StartLifeSpan();
+	OnPoolActivated();
+	ForceNetUpdate();
+}
+
+void ARPGProjectile::DeactivateToPool()
+{
+	bPoolDormant = true;
+	GetWorldTimerManager().ClearTimer(PooledLifeSpanTimerHandle);
+	SetDormantState(true);
+
+	// Liberar referências do spec/contexto do disparo anterior
+	DamageEffectSpecHandle = FGameplayEffectSpecHandle();
+
+	OnPoolDeactivated();
+	ForceNetUpdate();
+}
+
+void ARPGProjectile::SetDormantState(bool bDormant)
+{
+	if (bDormant)
+	{
+		ProjectileMovement->StopMovementImmediately();
+		ProjectileMovement->Deactivate();
+	}
+	else
+	{
+		ProjectileMovement->SetUpdatedComponent(Sphere);
+		ProjectileMovement->Velocity = GetActorForwardVector() * ProjectileMovement->InitialSpeed;
+		ProjectileMovement->Activate(true);
+	}
+	SetActorEnableCollision(!bDormant);
+	SetActorHiddenInGame(bDormant);
+}
+
+void ARPGProjectile::OnRep_PoolDormant()
+{
+	if (bPoolDormant)
+	{
+		// Equivalente ao Destroyed() para projéteis do pool: o cliente reproduz o impacto que não viu
+		if (!bHit && HasActorBegunPlay()) OnHit();
+		SetDormantState(true);
+		OnPoolDeactivated();
+		return;
+	}
+
+	bHit = false;
+	SetDormantState(false);
+	OnPoolActivated();
+}
+
 void ARPGProjectile::OnHit()
 {
     // Visual/Som removidos
@@ -57,6 +160,8 @@ void ARPGProjectile::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, A
                                      UPrimitiveComponent* OtherComp, int32 OtherBodyIndex,
                                      bool bFromSweep, const FHitResult& SweepResult)
 {
+	if (bPoolDormant) return;
+
 	if (!DamageEffectSpecHandle.Data.IsValid() || DamageEffectSpecHandle.Data.Get()->GetContext().GetEffectCauser() == OtherActor)
 	{
 		return;
@@ -85,7 +190,7 @@ void ARPGProjectile::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, A
 		{
 			TargetASC->ApplyGameplayEffectSpecToSelf(*DamageEffectSpecHandle.Data.Get());
 		}
-		Destroy();
+		ReleaseToPoolOrDestroy();
 	}
 	else bHit = true;
 } 
\ No newline at end of file
@@ -0,0 +1,119 @@
+// Copyright Druid Mechanics
+
+#include "Actor/RPGProjectilePoolSubsystem.h"
+#include "Actor/RPGProjectile.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+
+void URPGProjectilePoolSubsystem::Deinitialize()
+{
+	// Os atores pertencem ao mundo e serão destruídos com ele
+	Pools.Empty();
+	Super::Deinitialize();
+}
+
+bool URPGProjectilePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URPGProjectilePoolSubsystem::PrewarmPool(TSubclassOf<ARPGProjectile> ProjectileClass, int32 Count)
+{
+	UWorld* World = GetWorld();
+	if (!ProjectileClass || !IsValid(World) || World->bIsTearingDown) return;
+
+	FRPGProjectilePoolBucket& Bucket = Pools.FindOrAdd(ProjectileClass.Get());
+	const int32 NumToSpawn = FMath::Min(Count, MAX_POOLED_PER_CLASS) - Bucket.InactiveProjectiles.Num();
+	if (NumToSpawn <= 0) return;
+
+	Bucket.InactiveProjectiles.Reserve(Bucket.InactiveProjectiles.Num() + NumToSpawn);
+	for (int32 i = 0; i < NumToSpawn; ++i)
+	{
+		ARPGProjectile* Projectile = SpawnPooledProjectile(ProjectileClass, FTransform::Identity, nullptr, nullptr);
+		if (!Projectile) break;
+
+		// Nasce dormente: BeginPlay desativa sem iniciar movimento/efeitos
+		Projectile->bPoolDormant = true;
+		Projectile->SetActorEnableCollision(false);
+		Projectile->FinishSpawning(FTransform::Identity);
+
+		Bucket.InactiveProjectiles.Add(Projectile);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ProjectilePool] %s pré-aquecido com %d projéteis"), *GetNameSafe(ProjectileClass), Bucket.InactiveProjectiles.Num());
+}
+
+ARPGProjectile* URPGProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<ARPGProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator)
+{
+	if (!ProjectileClass) return nullptr;
+
+	if (FRPGProjectilePoolBucket* Bucket = Pools.Find(ProjectileClass.Get()))
+	{
+		while (Bucket->InactiveProjectiles.Num() > 0)
+		{
+			ARPGProjectile* Projectile = Bucket->InactiveProjectiles.Pop(EAllowShrinking::No).Get();
+			if (!IsValid(Projectile)) continue;
+
+			Projectile->SetOwner(Owner);
+			Projectile->SetInstigator(Instigator);
+			Projectile->SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+			return Projectile;
+		}
+	}
+
+	return SpawnPooledProjectile(ProjectileClass, SpawnTransform, Owner, Instigator);
+}
+
+void URPGProjectilePoolSubsystem::LaunchProjectile(ARPGProjectile* Projectile, const FTransform& SpawnTransform)
+{
+	if (!IsValid(Projectile)) return;
+
+	if (!Projectile->IsActorInitialized())
+	{
+		// Primeiro uso: concluir o spawn deferred normalmente
+		Projectile->FinishSpawning(SpawnTransform);
+		return;
+	}
+
+	Projectile->ActivateFromPool(SpawnTransform);
+}
+
+void URPGProjectilePoolSubsystem::ReleaseProjectile(ARPGProjectile* Projectile)
+{
+	if (!IsValid(Projectile) || Projectile->bPoolDormant) return;
+
+	FRPGProjectilePoolBucket& Bucket = Pools.FindOrAdd(Projectile->GetClass());
+	if (Bucket.InactiveProjectiles.Num() >= MAX_POOLED_PER_CLASS)
+	{
+		Projectile->Destroy();
+		return;
+	}
+
+	Projectile->DeactivateToPool();
+	Bucket.InactiveProjectiles.Add(Projectile);
+}
+
+int32 URPGProjectilePoolSubsystem::GetNumPooledProjectiles(TSubclassOf<ARPGProjectile> ProjectileClass) const
+{
+	const FRPGProjectilePoolBucket* Bucket = Pools.Find(ProjectileClass.Get());
+	return Bucket ? Bucket->InactiveProjectiles.Num() : 0;
+}
+
+ARPGProjectile* URPGProjectilePoolSubsystem::SpawnPooledProjectile(TSubclassOf<ARPGProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator)
+{
+	UWorld* World = GetWorld();
+	if (!IsValid(World) || World->bIsTearingDown) return nullptr;
+
+	ARPGProjectile* Projectile = World->SpawnActorDeferred<ARPGProjectile>(
+		ProjectileClass,
+		SpawnTransform,
+		Owner,
+		Instigator,
+		ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+	if (Projectile)
+	{
+		Projectile->bIsPooled = true;
+	}
+	return Projectile;
+}
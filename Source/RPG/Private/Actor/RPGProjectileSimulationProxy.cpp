@@ -0,0 +1,24 @@
+// Copyright Druid Mechanics
+
+#include "Actor/RPGProjectileSimulationProxy.h"
+#include "Engine/World.h"
+
+ARPGProjectileSimulationProxy::ARPGProjectileSimulationProxy()
+{
+	bReplicates = true;
+	bAlwaysRelevant = true;
+
+	// Sem propriedades replicadas: só carrega RPCs
+	SetNetUpdateFrequency(1.f);
+}
+
+void ARPGProjectileSimulationProxy::MulticastSpawnProjectiles_Implementation(const TArray<FTransform>& SpawnTransforms, const FRPGSimulatedProjectileParams& Params, AActor* SourceAvatar)
+{
+	// O servidor (inclusive listen server) já simula e desenha os projéteis reais
+	if (HasAuthority()) return;
+
+	if (URPGProjectileSimulationSubsystem* Simulation = GetWorld() ? GetWorld()->GetSubsystem<URPGProjectileSimulationSubsystem>() : nullptr)
+	{
+		Simulation->SpawnVisualProjectiles(SpawnTransforms, Params, SourceAvatar);
+	}
+}
@@ -0,0 +1,440 @@
+// Copyright Druid Mechanics
+
+#include "Actor/RPGProjectileSimulationSubsystem.h"
+#include "Actor/RPGProjectileSimulationProxy.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystem/Core/RPGAbilitySystemLibrary.h"
+#include "Async/ParallelFor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "WorldCollision.h"
+
+namespace RPGProjectileSimulation
+{
+	FCollisionObjectQueryParams MakeSweepObjectParams()
+	{
+		FCollisionObjectQueryParams ObjectParams;
+		ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+		ObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
+		ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+		return ObjectParams;
+	}
+}
+
+void URPGProjectileSimulationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Criar o proxy antes do primeiro disparo, para o canal já estar aberto nos clientes
+	GetReplicationProxy();
+}
+
+ARPGProjectileSimulationProxy* URPGProjectileSimulationSubsystem::GetReplicationProxy()
+{
+	UWorld* World = GetWorld();
+	if (!IsValid(World) || World->bIsTearingDown) return nullptr;
+
+	const ENetMode NetMode = World->GetNetMode();
+	if (NetMode == NM_Standalone || NetMode == NM_Client) return nullptr;
+
+	if (!IsValid(ReplicationProxy))
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		ReplicationProxy = World->SpawnActor<ARPGProjectileSimulationProxy>(SpawnParams);
+	}
+	return ReplicationProxy;
+}
+
+void URPGProjectileSimulationSubsystem::Deinitialize()
+{
+	Positions.Empty();
+	PreviousPositions.Empty();
+	Velocities.Empty();
+	CollisionRadii.Empty();
+	RemainingLifeSpans.Empty();
+	DamageEntryIndices.Empty();
+	PendingSweeps.Empty();
+	VisualBatchIndices.Empty();
+	VisualInstanceIndices.Empty();
+	VisualScales.Empty();
+	DamageEntries.Empty();
+	VisualBatches.Empty();
+	VisualBatchByMesh.Empty();
+	VisualsActor = nullptr;
+	ReplicationProxy = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool URPGProjectileSimulationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URPGProjectileSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGProjectileSimulationSubsystem, STATGROUP_Tickables);
+}
+
+// === SPAWN ===
+
+bool URPGProjectileSimulationSubsystem::SpawnSimulatedProjectile(const FTransform& SpawnTransform, const FRPGSimulatedProjectileParams& Params, const FDamageEffectParams& DamageParams)
+{
+	return SpawnSimulatedProjectiles(MakeArrayView(&SpawnTransform, 1), Params, DamageParams) > 0;
+}
+
+int32 URPGProjectileSimulationSubsystem::SpawnSimulatedProjectiles(TArrayView<const FTransform> SpawnTransforms, const FRPGSimulatedProjectileParams& Params, const FDamageEffectParams& DamageParams)
+{
+	const UWorld* World = GetWorld();
+	if (!IsValid(World) || World->bIsTearingDown || World->GetNetMode() == NM_Client) return 0;
+	if (!DamageParams.SourceAbilitySystemComponent || SpawnTransforms.Num() == 0) return 0;
+
+	AddProjectiles(SpawnTransforms, Params, AddDamageEntry(DamageParams));
+
+	// Clientes rodam a simulação visual com os mesmos parâmetros de spawn
+	if (Params.VisualMesh)
+	{
+		if (ARPGProjectileSimulationProxy* Proxy = GetReplicationProxy())
+		{
+			Proxy->MulticastSpawnProjectiles(TArray<FTransform>(SpawnTransforms), Params, DamageParams.SourceAbilitySystemComponent->GetAvatarActor());
+		}
+	}
+	return SpawnTransforms.Num();
+}
+
+int32 URPGProjectileSimulationSubsystem::SpawnVisualProjectiles(TArrayView<const FTransform> SpawnTransforms, const FRPGSimulatedProjectileParams& Params, AActor* SourceAvatar)
+{
+	const UWorld* World = GetWorld();
+	if (!IsValid(World) || World->bIsTearingDown || World->GetNetMode() != NM_Client) return 0;
+	if (!Params.VisualMesh || SpawnTransforms.Num() == 0) return 0;
+
+	AddProjectiles(SpawnTransforms, Params, AddVisualEntry(SourceAvatar));
+	return SpawnTransforms.Num();
+}
+
+void URPGProjectileSimulationSubsystem::AddProjectiles(TArrayView<const FTransform> SpawnTransforms, const FRPGSimulatedProjectileParams& Params, int32 DamageEntryIndex)
+{
+	const int32 NewNum = Positions.Num() + SpawnTransforms.Num();
+	Positions.Reserve(NewNum);
+	PreviousPositions.Reserve(NewNum);
+	Velocities.Reserve(NewNum);
+	CollisionRadii.Reserve(NewNum);
+	RemainingLifeSpans.Reserve(NewNum);
+	DamageEntryIndices.Reserve(NewNum);
+	PendingSweeps.Reserve(NewNum);
+	VisualBatchIndices.Reserve(NewNum);
+	VisualInstanceIndices.Reserve(NewNum);
+	VisualScales.Reserve(NewNum);
+
+	for (const FTransform& SpawnTransform : SpawnTransforms)
+	{
+		AddProjectile(SpawnTransform, Params, DamageEntryIndex);
+	}
+}
+
+int32 URPGProjectileSimulationSubsystem::AddDamageEntry(const FDamageEffectParams& DamageParams)
+{
+	FDamageEntry Entry;
+	Entry.Params = DamageParams;
+	Entry.SourceASC = DamageParams.SourceAbilitySystemComponent;
+	Entry.SourceAvatar = DamageParams.SourceAbilitySystemComponent->GetAvatarActor();
+	Entry.QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(RPGSimulatedProjectile), false);
+	if (Entry.SourceAvatar.IsValid())
+	{
+		Entry.QueryParams.AddIgnoredActor(Entry.SourceAvatar.Get());
+	}
+	return DamageEntries.Add(MoveTemp(Entry));
+}
+
+int32 URPGProjectileSimulationSubsystem::AddVisualEntry(AActor* SourceAvatar)
+{
+	FDamageEntry Entry;
+	Entry.bVisualOnly = true;
+	Entry.SourceAvatar = SourceAvatar;
+	Entry.QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(RPGSimulatedProjectile), false);
+	if (SourceAvatar)
+	{
+		Entry.QueryParams.AddIgnoredActor(SourceAvatar);
+	}
+	return DamageEntries.Add(MoveTemp(Entry));
+}
+
+void URPGProjectileSimulationSubsystem::AddProjectile(const FTransform& SpawnTransform, const FRPGSimulatedProjectileParams& Params, int32 DamageEntryIndex)
+{
+	Positions.Add(SpawnTransform.GetLocation());
+	PreviousPositions.Add(SpawnTransform.GetLocation());
+	Velocities.Add(SpawnTransform.GetRotation().Vector() * Params.Speed);
+	CollisionRadii.Add(Params.CollisionRadius);
+	RemainingLifeSpans.Add(Params.LifeSpan);
+	DamageEntryIndices.Add(DamageEntryIndex);
+	PendingSweeps.Add(FTraceHandle());
+	VisualScales.Add(Params.VisualScale);
+
+	int32 BatchIndex = INDEX_NONE;
+	const int32 InstanceIndex = AcquireVisualInstance(Params.VisualMesh, BatchIndex);
+	VisualBatchIndices.Add(BatchIndex);
+	VisualInstanceIndices.Add(InstanceIndex);
+
+	++DamageEntries[DamageEntryIndex].RefCount;
+}
+
+// === TICK ===
+
+void URPGProjectileSimulationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Positions.Num() == 0) return;
+
+	// 1) Resultados dos sweeps emitidos no frame anterior
+	TArray<bool> Kill;
+	ResolvePendingSweeps(Kill);
+
+	// 2) Remover projéteis que colidiram ou expiraram
+	RemoveDeadProjectiles(Kill);
+	if (Positions.Num() == 0) return;
+
+	// 3) Integrar e 4) emitir sweeps do novo segmento
+	IntegrateProjectiles(DeltaTime);
+	IssueSweeps();
+
+	UpdateVisuals();
+}
+
+void URPGProjectileSimulationSubsystem::ResolvePendingSweeps(TArray<bool>& OutKill)
+{
+	UWorld* World = GetWorld();
+	const int32 Num = Positions.Num();
+	OutKill.Init(false, Num);
+
+	FTraceDatum TraceDatum;
+	TArray<FHitResult> SyncHits;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		if (PendingSweeps[Index].IsValid())
+		{
+			if (World->QueryTraceData(PendingSweeps[Index], TraceDatum))
+			{
+				OutKill[Index] = HandleSweepHits(Index, TraceDatum.OutHits);
+			}
+			else
+			{
+				// Resultado descartado (ex.: o buffer assíncrono foi trocado): refazer o mesmo segmento agora
+				SyncHits.Reset();
+				World->SweepMultiByObjectType(
+					SyncHits,
+					PreviousPositions[Index],
+					Positions[Index],
+					FQuat::Identity,
+					RPGProjectileSimulation::MakeSweepObjectParams(),
+					FCollisionShape::MakeSphere(CollisionRadii[Index]),
+					DamageEntries[DamageEntryIndices[Index]].QueryParams);
+				OutKill[Index] = HandleSweepHits(Index, SyncHits);
+			}
+			PendingSweeps[Index] = FTraceHandle();
+		}
+
+		// Expirou depois de percorrer o último segmento
+		if (RemainingLifeSpans[Index] <= 0.f)
+		{
+			OutKill[Index] = true;
+		}
+	}
+}
+
+bool URPGProjectileSimulationSubsystem::HandleSweepHits(int32 Index, const TArray<FHitResult>& Hits)
+{
+	if (Hits.Num() == 0) return false;
+
+	const FDamageEntry& Entry = DamageEntries[DamageEntryIndices[Index]];
+
+	// Dono do disparo foi destruído: o projétil some sem causar dano
+	if (!Entry.bVisualOnly && !Entry.SourceASC.IsValid()) return true;
+	AActor* SourceAvatar = Entry.SourceAvatar.Get();
+
+	// Hits já vêm ordenados pelo tempo do sweep
+	for (const FHitResult& Hit : Hits)
+	{
+		AActor* HitActor = Hit.GetActor();
+		if (!IsValid(HitActor)) continue;
+
+		UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(HitActor);
+		if (!TargetASC)
+		{
+			// Geometria do mundo: o projétil para aqui
+			return true;
+		}
+
+		// Aliados são atravessados, como no ARPGProjectile
+		if (!URPGAbilitySystemLibrary::IsNotFriend(SourceAvatar, HitActor)) continue;
+
+		// Cliente: o servidor aplica o dano, aqui o projétil apenas some
+		if (Entry.bVisualOnly) return true;
+
+		FDamageEffectParams DamageParams = Entry.Params;
+		DamageParams.SourceAbilitySystemComponent = Entry.SourceASC.Get();
+		DamageParams.TargetAbilitySystemComponent = TargetASC;
+		DamageParams.DeathImpulse = Velocities[Index].GetSafeNormal() * DamageParams.DeathImpulseMagnitude;
+		URPGAbilitySystemLibrary::ApplyDamageEffect(DamageParams);
+		return true;
+	}
+	return false;
+}
+
+void URPGProjectileSimulationSubsystem::RemoveDeadProjectiles(const TArray<bool>& Kill)
+{
+	// Remoção por swap mantém os arrays densos; iterar de trás para frente preserva os índices pendentes
+	for (int32 Index = Kill.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Kill[Index]) continue;
+
+		ReleaseVisualInstance(VisualBatchIndices[Index], VisualInstanceIndices[Index]);
+
+		const int32 EntryIndex = DamageEntryIndices[Index];
+		if (--DamageEntries[EntryIndex].RefCount <= 0)
+		{
+			DamageEntries.RemoveAt(EntryIndex);
+		}
+
+		Positions.RemoveAtSwap(Index, EAllowShrinking::No);
+		PreviousPositions.RemoveAtSwap(Index, EAllowShrinking::No);
+		Velocities.RemoveAtSwap(Index, EAllowShrinking::No);
+		CollisionRadii.RemoveAtSwap(Index, EAllowShrinking::No);
+		RemainingLifeSpans.RemoveAtSwap(Index, EAllowShrinking::No);
+		DamageEntryIndices.RemoveAtSwap(Index, EAllowShrinking::No);
+		PendingSweeps.RemoveAtSwap(Index, EAllowShrinking::No);
+		VisualBatchIndices.RemoveAtSwap(Index, EAllowShrinking::No);
+		VisualInstanceIndices.RemoveAtSwap(Index, EAllowShrinking::No);
+		VisualScales.RemoveAtSwap(Index, EAllowShrinking::No);
+	}
+}
+
+void URPGProjectileSimulationSubsystem::IntegrateProjectiles(float DeltaTime)
+{
+	FVector* PositionData = Positions.GetData();
+	FVector* PreviousPositionData = PreviousPositions.GetData();
+	const FVector* VelocityData = Velocities.GetData();
+	float* LifeSpanData = RemainingLifeSpans.GetData();
+
+	// OTIMIZAÇÃO: integração linear em paralelo, sem acesso a UObjects
+	ParallelFor(TEXT("RPGProjectileSimulation.Integrate"), Positions.Num(), INTEGRATION_BATCH_SIZE, [=](int32 Index)
+	{
+		PreviousPositionData[Index] = PositionData[Index];
+		PositionData[Index] += VelocityData[Index] * DeltaTime;
+		LifeSpanData[Index] -= DeltaTime;
+	});
+}
+
+void URPGProjectileSimulationSubsystem::IssueSweeps()
+{
+	UWorld* World = GetWorld();
+	const FCollisionObjectQueryParams ObjectParams = RPGProjectileSimulation::MakeSweepObjectParams();
+
+	for (int32 Index = 0; Index < Positions.Num(); ++Index)
+	{
+		PendingSweeps[Index] = World->AsyncSweepByObjectType(
+			EAsyncTraceType::Multi,
+			PreviousPositions[Index],
+			Positions[Index],
+			FQuat::Identity,
+			ObjectParams,
+			FCollisionShape::MakeSphere(CollisionRadii[Index]),
+			DamageEntries[DamageEntryIndices[Index]].QueryParams);
+	}
+}
+
+// === VISUAIS ===
+
+bool URPGProjectileSimulationSubsystem::ShouldRenderVisuals() const
+{
+	const UWorld* World = GetWorld();
+	return IsValid(World) && World->GetNetMode() != NM_DedicatedServer;
+}
+
+int32 URPGProjectileSimulationSubsystem::AcquireVisualInstance(UStaticMesh* Mesh, int32& OutBatchIndex)
+{
+	OutBatchIndex = INDEX_NONE;
+	if (!Mesh || !ShouldRenderVisuals()) return INDEX_NONE;
+
+	if (const int32* ExistingBatch = VisualBatchByMesh.Find(Mesh))
+	{
+		OutBatchIndex = *ExistingBatch;
+	}
+	else
+	{
+		UWorld* World = GetWorld();
+		if (!IsValid(VisualsActor))
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.ObjectFlags |= RF_Transient;
+			VisualsActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+			if (!VisualsActor) return INDEX_NONE;
+		}
+
+		UInstancedStaticMeshComponent* InstancedMesh = NewObject<UInstancedStaticMeshComponent>(VisualsActor);
+		InstancedMesh->SetStaticMesh(Mesh);
+		InstancedMesh->SetMobility(EComponentMobility::Movable);
+		InstancedMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		InstancedMesh->SetCastShadow(false);
+		if (!VisualsActor->GetRootComponent())
+		{
+			VisualsActor->SetRootComponent(InstancedMesh);
+		}
+		InstancedMesh->RegisterComponent();
+		VisualsActor->AddInstanceComponent(InstancedMesh);
+
+		FRPGProjectileVisualBatch& NewBatch = VisualBatches.AddDefaulted_GetRef();
+		NewBatch.InstancedMesh = InstancedMesh;
+		OutBatchIndex = VisualBatches.Num() - 1;
+		VisualBatchByMesh.Add(Mesh, OutBatchIndex);
+	}
+
+	FRPGProjectileVisualBatch& Batch = VisualBatches[OutBatchIndex];
+	if (Batch.FreeInstances.Num() > 0)
+	{
+		return Batch.FreeInstances.Pop(EAllowShrinking::No);
+	}
+	return Batch.InstancedMesh->AddInstance(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), true);
+}
+
+void URPGProjectileSimulationSubsystem::ReleaseVisualInstance(int32 BatchIndex, int32 InstanceIndex)
+{
+	if (!VisualBatches.IsValidIndex(BatchIndex) || InstanceIndex == INDEX_NONE) return;
+
+	// Instâncias não são removidas (isso reordenaria o ISM): ficam com escala zero até serem reutilizadas
+	FRPGProjectileVisualBatch& Batch = VisualBatches[BatchIndex];
+	if (Batch.InstancedMesh)
+	{
+		Batch.InstancedMesh->UpdateInstanceTransform(InstanceIndex, FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), true, true, true);
+	}
+	Batch.FreeInstances.Add(InstanceIndex);
+}
+
+void URPGProjectileSimulationSubsystem::UpdateVisuals()
+{
+	if (VisualBatches.Num() == 0) return;
+
+	for (int32 Index = 0; Index < Positions.Num(); ++Index)
+	{
+		const int32 BatchIndex = VisualBatchIndices[Index];
+		if (BatchIndex == INDEX_NONE) continue;
+
+		UInstancedStaticMeshComponent* InstancedMesh = VisualBatches[BatchIndex].InstancedMesh;
+		if (!InstancedMesh) continue;
+
+		const FTransform InstanceTransform(Velocities[Index].ToOrientationQuat(), Positions[Index], VisualScales[Index]);
+		InstancedMesh->UpdateInstanceTransform(VisualInstanceIndices[Index], InstanceTransform, true, false, true);
+	}
+
+	// Um único dirty de render state por lote
+	for (FRPGProjectileVisualBatch& Batch : VisualBatches)
+	{
+		if (Batch.InstancedMesh)
+		{
+			Batch.InstancedMesh->MarkRenderStateDirty();
+		}
+	}
+}
@@ -0,0 +1,196 @@
+// Copyright (c) 2025 RPG Yumi Project. All rights reserved.
+
+#include "Character/Animation/ANS_SendTargetGroup.h"
+#include "Character/Animation/AN_SendTargetGroup.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+
+void UANS_SendTargetGroup::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
+
+	if (!MeshComp)
+		return;
+
+	AActor* OwnerActor = MeshComp->GetOwner();
+	if (!OwnerActor || !UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(OwnerActor))
+		return;
+
+	// Drop windows whose mesh went away without a NotifyEnd
+	for (auto It = ActiveWindows.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TArray<FVector, TInlineAllocator<8>> WeaponSocketLocations;
+	const bool bWeaponSockets = bUseWeaponCombatSockets && UAN_SendTargetGroup::GetWeaponCombatSocketLocations(OwnerActor, WeaponSocketLocations);
+	if (!bWeaponSockets && TargetSocketNames.Num() <= 1)
+		return;
+
+	FSweepWindow& Window = ActiveWindows.FindOrAdd(MeshComp);
+	Window.bWeaponSockets = bWeaponSockets;
+	Window.HitActors.Reset();
+	Window.QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ANS_SendTargetGroup), false);
+	if (bIgnoreOwner)
+	{
+		Window.QueryParams.AddIgnoredActor(OwnerActor);
+	}
+	SampleSocketLocations(MeshComp, Window, Window.PreviousSocketLocations);
+	Window.PreviousComponentTransform = MeshComp->GetComponentTransform();
+
+	// Cover the pose at the first frame of the window as well
+	SweepWindow(MeshComp, Window, 0.f);
+}
+
+void UANS_SendTargetGroup::NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyTick(MeshComp, Animation, FrameDeltaTime, EventReference);
+
+	if (FSweepWindow* Window = ActiveWindows.Find(MeshComp))
+	{
+		SweepWindow(MeshComp, *Window, FrameDeltaTime);
+	}
+}
+
+void UANS_SendTargetGroup::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+{
+	ActiveWindows.Remove(MeshComp);
+
+	Super::NotifyEnd(MeshComp, Animation, EventReference);
+}
+
+void UANS_SendTargetGroup::SampleSocketLocations(const USkeletalMeshComponent* MeshComp, const FSweepWindow& Window, TArray<FVector>& OutLocations) const
+{
+	// Component space; the owner's movement is interpolated separately from the pose
+	if (Window.bWeaponSockets)
+	{
+		TArray<FVector, TInlineAllocator<8>> WorldLocations;
+		UAN_SendTargetGroup::GetWeaponCombatSocketLocations(MeshComp->GetOwner(), WorldLocations);
+
+		const FTransform& ComponentTransform = MeshComp->GetComponentTransform();
+		OutLocations.Reset(WorldLocations.Num());
+		for (const FVector& WorldLocation : WorldLocations)
+		{
+			OutLocations.Add(ComponentTransform.InverseTransformPosition(WorldLocation));
+		}
+		return;
+	}
+
+	OutLocations.Reset(TargetSocketNames.Num());
+	for (const FName& SocketName : TargetSocketNames)
+	{
+		OutLocations.Add(MeshComp->GetSocketTransform(SocketName, RTS_Component).GetLocation());
+	}
+}
+
+void UANS_SendTargetGroup::SweepWindow(USkeletalMeshComponent* MeshComp, FSweepWindow& Window, float DeltaTime)
+{
+	SampleSocketLocations(MeshComp, Window, Window.CurrentSocketLocations);
+
+	const FTransform& ComponentTransform = MeshComp->GetComponentTransform();
+	if (Window.CurrentSocketLocations.Num() != Window.PreviousSocketLocations.Num())
+	{
+		// Weapon swapped mid-window: restart the interpolation from the new chain
+		Window.PreviousSocketLocations = Window.CurrentSocketLocations;
+		Window.PreviousComponentTransform = ComponentTransform;
+	}
+	const int32 NumSockets = Window.CurrentSocketLocations.Num();
+	const int32 NumSubsteps = FMath::Clamp(FMath::CeilToInt(DeltaTime / FMath::Max(SubstepInterval, KINDA_SMALL_NUMBER)), 1, MaxSubstepsPerFrame);
+
+	FGameplayEventData Data;
+
+	// Sub-steps blend both the pose (component space) and the component transform, so a lunge or turn
+	// during the frame moves the previous sample along with the owner instead of snapping it to the new transform
+	TArray<FVector, TInlineAllocator<8>> PreviousStepWorld;
+	TArray<FVector, TInlineAllocator<8>> StepWorld;
+	PreviousStepWorld.SetNumUninitialized(NumSockets);
+	StepWorld.SetNumUninitialized(NumSockets);
+	for (int32 SocketIndex = 0; SocketIndex < NumSockets; ++SocketIndex)
+	{
+		PreviousStepWorld[SocketIndex] = Window.PreviousComponentTransform.TransformPosition(Window.PreviousSocketLocations[SocketIndex]);
+	}
+
+	FTransform StepTransform;
+	for (int32 Step = 1; Step <= NumSubsteps; ++Step)
+	{
+		const float Alpha = static_cast<float>(Step) / static_cast<float>(NumSubsteps);
+		StepTransform.Blend(Window.PreviousComponentTransform, ComponentTransform, Alpha);
+		for (int32 SocketIndex = 0; SocketIndex < NumSockets; ++SocketIndex)
+		{
+			const FVector Local = FMath::Lerp(Window.PreviousSocketLocations[SocketIndex], Window.CurrentSocketLocations[SocketIndex], Alpha);
+			StepWorld[SocketIndex] = StepTransform.TransformPosition(Local);
+		}
+
+		// Weapon chain at this sub-step
+		for (int32 SocketIndex = 1; SocketIndex < NumSockets; ++SocketIndex)
+		{
+			SweepSegment(MeshComp, Window, StepWorld[SocketIndex - 1], StepWorld[SocketIndex], Data);
+		}
+
+		// Path of each socket since the previous sub-step (edges of the swept volume)
+		if (DeltaTime > 0.f)
+		{
+			for (int32 SocketIndex = 0; SocketIndex < NumSockets; ++SocketIndex)
+			{
+				SweepSegment(MeshComp, Window, PreviousStepWorld[SocketIndex], StepWorld[SocketIndex], Data);
+			}
+		}
+
+		Swap(PreviousStepWorld, StepWorld);
+	}
+
+	Swap(Window.PreviousSocketLocations, Window.CurrentSocketLocations);
+	Window.PreviousComponentTransform = ComponentTransform;
+
+	if (Data.TargetData.Num() > 0)
+	{
+		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(MeshComp->GetOwner(), EventTag, Data);
+	}
+}
+
+void UANS_SendTargetGroup::SweepSegment(USkeletalMeshComponent* MeshComp, FSweepWindow& Window, const FVector& Start, const FVector& End, FGameplayEventData& OutData) const
+{
+	UWorld* World = MeshComp->GetWorld();
+	if (!World)
+		return;
+
+	static const FCollisionObjectQueryParams ObjectQueryParams(ECC_Pawn);
+
+	Window.HitResults.Reset();
+	World->SweepMultiByObjectType(Window.HitResults, Start, End, FQuat::Identity, ObjectQueryParams,
+		FCollisionShape::MakeSphere(SphereSweepRadius), Window.QueryParams);
+
+#if ENABLE_DRAW_DEBUG
+	if (bDrawDebug)
+	{
+		DrawDebugLine(World, Start, End, Window.HitResults.Num() > 0 ? FColor::Green : FColor::Red, false, 2.f);
+	}
+#endif
+
+	const IGenericTeamAgentInterface* OwnerTeamInterface = Cast<IGenericTeamAgentInterface>(MeshComp->GetOwner());
+
+	for (const FHitResult& HitResult : Window.HitResults)
+	{
+		AActor* HitActor = HitResult.GetActor();
+		if (!HitActor || Window.HitActors.Contains(HitActor))
+		{
+			continue;
+		}
+
+		if (OwnerTeamInterface && OwnerTeamInterface->GetTeamAttitudeTowards(*HitActor) != TargetTeam)
+		{
+			continue;
+		}
+
+		Window.HitActors.Add(HitActor);
+
+		OutData.TargetData.Add(new FGameplayAbilityTargetData_SingleTargetHit(HitResult));
+		UAN_SendTargetGroup::SendLocalGameplayCues(TriggerGameplayCueTags, HitResult);
+	}
+}
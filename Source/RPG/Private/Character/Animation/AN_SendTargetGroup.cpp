@@ -7,6 +7,7 @@
 #include "GameplayCueManager.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "GameplayEffectTypes.h"
+#include "Character/RPGCharacter.h"
 
 void UAN_SendTargetGroup::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
 {
@@ -15,36 +16,48 @@ void UAN_SendTargetGroup::Notify(USkeletalMeshComponent* MeshComp, UAnimSequence
 	if (!MeshComp)
 		return;
 
-	if (TargetSocketNames.Num() <= 1)
-		return;
-
 	if (!MeshComp->GetOwner() || !UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(MeshComp->GetOwner()))
 	{
 		return;
 	}
 
+	// Socket chain: cached weapon sockets when requested, otherwise the configured names
+	TArray<FVector, TInlineAllocator<8>> SocketLocations;
+	if (!bUseWeaponCombatSockets || !GetWeaponCombatSocketLocations(MeshComp->GetOwner(), SocketLocations))
+	{
+		for (const FName& SocketName : TargetSocketNames)
+		{
+			SocketLocations.Add(MeshComp->GetSocketLocation(SocketName));
+		}
+	}
+
+	if (SocketLocations.Num() <= 1)
+		return;
+
 	FGameplayEventData Data;
 	TSet<AActor*> HitActors;
 	AActor* OwnerActor = MeshComp->GetOwner();
 	const IGenericTeamAgentInterface* OwnerTeamInterface = Cast<IGenericTeamAgentInterface>(OwnerActor);
 
-	for (int i = 1; i < TargetSocketNames.Num(); ++i)
+	// Query setup is identical for every segment
+	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
+	ObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_Pawn));
+
+	TArray<AActor*> ActorsToIgnore;
+	if (bIgnoreOwner)
 	{
-		FVector StartLoc = MeshComp->GetSocketLocation(TargetSocketNames[i-1]);
-		FVector EndLoc = MeshComp->GetSocketLocation(TargetSocketNames[i]);
+		ActorsToIgnore.Add(OwnerActor);
+	}
 
-		TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-		ObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_Pawn));
-		TArray<FHitResult> HitResults;
+	const EDrawDebugTrace::Type DrawDebugTrace = bDrawDebug ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None;
+	TArray<FHitResult> HitResults;
 
-		TArray<AActor*> ActorsToIgnore;
-		if (bIgnoreOwner)
-		{
-			ActorsToIgnore.Add(OwnerActor);
-		}
-
-		EDrawDebugTrace::Type DrawDebugTrace = bDrawDebug ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None;
+	for (int i = 1; i < SocketLocations.Num(); ++i)
+	{
+		const FVector& StartLoc = SocketLocations[i-1];
+		const FVector& EndLoc = SocketLocations[i];
 
+		HitResults.Reset();
 		UKismetSystemLibrary::SphereTraceMultiForObjects(MeshComp, StartLoc, EndLoc, SphereSweepRadius, 
 			ObjectTypes, false, ActorsToIgnore, DrawDebugTrace, HitResults, false);
 
@@ -64,6 +77,8 @@ void UAN_SendTargetGroup::Notify(USkeletalMeshComponent* MeshComp, UAnimSequence
 				}
 			}
 
+			HitActors.Add(HitResult.GetActor());
+
 			FGameplayAbilityTargetData_SingleTargetHit* TargetHit = new FGameplayAbilityTargetData_SingleTargetHit(HitResult);
 			Data.TargetData.Add(TargetHit);
 			SendLocalGameplayCue(HitResult);
@@ -74,14 +89,36 @@ void UAN_SendTargetGroup::Notify(USkeletalMeshComponent* MeshComp, UAnimSequence
 }
 
 void UAN_SendTargetGroup::SendLocalGameplayCue(const FHitResult& HitResult) const
+{
+	SendLocalGameplayCues(TriggerGameplayCueTags, HitResult);
+}
+
+void UAN_SendTargetGroup::SendLocalGameplayCues(const FGameplayTagContainer& GameplayCueTags, const FHitResult& HitResult)
 {
 	FGameplayCueParameters CueParam;
 	CueParam.Location = HitResult.ImpactPoint;
 	CueParam.Normal = HitResult.ImpactNormal;
 
-	for (const FGameplayTag& GameplayCueTag : TriggerGameplayCueTags)
+	for (const FGameplayTag& GameplayCueTag : GameplayCueTags)
 	{
 		UAbilitySystemGlobals::Get().GetGameplayCueManager()->HandleGameplayCue(HitResult.GetActor(), GameplayCueTag, EGameplayCueEvent::Executed, CueParam);
 	}
 }
 
+bool UAN_SendTargetGroup::GetWeaponCombatSocketLocations(const AActor* OwnerActor, TArray<FVector, TInlineAllocator<8>>& OutLocations)
+{
+	OutLocations.Reset();
+
+	const ARPGCharacter* Character = Cast<ARPGCharacter>(OwnerActor);
+	if (!Character)
+		return false;
+
+	OutLocations.SetNumUninitialized(Character->GetNumWeaponCombatSockets());
+	OutLocations.SetNum(Character->WriteWeaponCombatSocketLocations(OutLocations), EAllowShrinking::No);
+	if (OutLocations.Num() <= 1)
+	{
+		OutLocations.Reset();
+		return false;
+	}
+	return true;
+}
@@ -22,6 +22,7 @@
 #include "Components/PrimitiveComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
 
 // Ability System
 #include "AbilitySystemComponent.h"
@@ -315,11 +316,23 @@ void ARPGCharacter::HandleItemEquipped(EEquipmentSlot Slot, UEquippedItem* Equip
     }
 
 	SpawnEquipmentMesh(Slot, Item, SocketName);
+
+	// OTIMIZAÇÃO: resolver sockets de combate uma vez por equip (não a cada golpe)
+	if (Slot == EEquipmentSlot::Weapon)
+	{
+		RebuildWeaponCombatSocketCache();
+	}
 }
 
 void ARPGCharacter::HandleItemUnequipped(EEquipmentSlot Slot, const FInventoryItem& UnequippedItem)
 {
 	RemoveEquipmentMesh(Slot);
+
+	if (Slot == EEquipmentSlot::Weapon)
+	{
+		// Reconstruído na próxima consulta, quando o item já saiu do EquipmentComponent
+		bWeaponCombatSocketCacheValid = false;
+	}
 }
 
 void ARPGCharacter::SpawnEquipmentMesh(EEquipmentSlot Slot, UItemDataAsset* Item, FName SocketName)
@@ -385,128 +398,180 @@ void ARPGCharacter::SpawnEquipmentMesh(EEquipmentSlot Slot, UItemDataAsset* Item
 
 FName ARPGCharacter::GetCurrentWeaponCombatSocketName() const
 {
-    // Preferir primeiro socket de dano configurado no Item (se houver), depois mapeamento do EquipmentComponent
-    if (EquipmentComponent)
+    EnsureWeaponCombatSocketCache();
+    return CachedWeaponCombatSocketName;
+}
+
+TArray<FName> ARPGCharacter::GetCurrentWeaponCombatSocketNames() const
+{
+    EnsureWeaponCombatSocketCache();
+    return CachedWeaponCombatSocketNames;
+}
+
+TArray<FVector> ARPGCharacter::GetCurrentWeaponCombatSocketLocations() const
+{
+    TArray<FVector> Out;
+    Out.SetNumUninitialized(GetNumWeaponCombatSockets());
+    Out.SetNum(WriteWeaponCombatSocketLocations(Out), EAllowShrinking::No);
+    return Out;
+}
+
+int32 ARPGCharacter::GetNumWeaponCombatSockets() const
+{
+    EnsureWeaponCombatSocketCache();
+    return CachedWeaponCombatSockets.Num();
+}
+
+int32 ARPGCharacter::WriteWeaponCombatSocketLocations(TArrayView<FVector> OutLocations) const
+{
+    EnsureWeaponCombatSocketCache();
+
+    int32 NumWritten = 0;
+    for (const FCachedCombatSocket& CachedSocket : CachedWeaponCombatSockets)
     {
-        if (UEquippedItem* EquippedWeapon = EquipmentComponent->GetEquippedItem(EEquipmentSlot::Weapon))
+        if (NumWritten >= OutLocations.Num())
         {
-            if (UItemDataAsset* ItemData = EquippedWeapon->GetItemData())
-            {
-                if (ItemData->DamageSockets.Num() > 0 && ItemData->DamageSockets[0] != NAME_None)
-                {
-                    return ItemData->DamageSockets[0];
-                }
-            }
+            break;
         }
 
-        const TArray<FName> Mapped = EquipmentComponent->GetAllSocketNamesForSlot(EEquipmentSlot::Weapon);
-        if (Mapped.Num() > 0 && !Mapped[0].IsNone())
+        const USkeletalMeshComponent* SkelComp = CachedSocket.Component.Get();
+        if (!SkelComp)
         {
-            return Mapped[0];
+            // Mesh trocada/destruída fora do fluxo de equip: resolver de novo na próxima consulta
+            bWeaponCombatSocketCacheValid = false;
+            continue;
         }
+
+        const FTransform BoneTransform = SkelComp->GetBoneTransform(CachedSocket.BoneIndex);
+        OutLocations[NumWritten++] = BoneTransform.TransformPosition(CachedSocket.SocketLocalTransform.GetLocation());
     }
-    return NAME_None;
+    return NumWritten;
 }
 
-TArray<FName> ARPGCharacter::GetCurrentWeaponCombatSocketNames() const
+void ARPGCharacter::EnsureWeaponCombatSocketCache() const
 {
-    TArray<FName> Out;
-    if (EquipmentComponent)
+    if (!bWeaponCombatSocketCacheValid)
+    {
+        RebuildWeaponCombatSocketCache();
+    }
+}
+
+bool ARPGCharacter::ResolveCombatSocket(const USkeletalMeshComponent* SkelComp, FName SocketName, FCachedCombatSocket& OutSocket)
+{
+    if (!SkelComp || SocketName.IsNone())
+    {
+        return false;
+    }
+
+    // Socket do asset: osso pai + transform local do socket
+    if (const USkeletalMeshSocket* Socket = SkelComp->GetSocketByName(SocketName))
     {
-        if (UEquippedItem* EquippedWeapon = EquipmentComponent->GetEquippedItem(EEquipmentSlot::Weapon))
+        const int32 BoneIndex = SkelComp->GetBoneIndex(Socket->BoneName);
+        if (BoneIndex == INDEX_NONE)
         {
-            if (UItemDataAsset* ItemData = EquippedWeapon->GetItemData())
-            {
-                // Primeiro: sockets de dano configurados no Item (prioridade máxima)
-                for (const FName& SocketName : ItemData->DamageSockets)
-                {
-                    if (!SocketName.IsNone())
-                    {
-                        Out.Add(SocketName);
-                    }
-                }
-            }
+            return false;
         }
-        
-        // Segundo: sockets mapeados pelo EquipmentComponent (fallback)
-        const TArray<FName> Mapped = EquipmentComponent->GetAllSocketNamesForSlot(EEquipmentSlot::Weapon);
-        for (const FName& Name : Mapped)
+        OutSocket.Component = SkelComp;
+        OutSocket.BoneIndex = BoneIndex;
+        OutSocket.SocketLocalTransform = Socket->GetSocketLocalTransform();
+        return true;
+    }
+
+    // DoesSocketExist também aceita nomes de ossos
+    const int32 BoneIndex = SkelComp->GetBoneIndex(SocketName);
+    if (BoneIndex == INDEX_NONE)
+    {
+        return false;
+    }
+    OutSocket.Component = SkelComp;
+    OutSocket.BoneIndex = BoneIndex;
+    OutSocket.SocketLocalTransform = FTransform::Identity;
+    return true;
+}
+
+void ARPGCharacter::RebuildWeaponCombatSocketCache() const
+{
+    CachedWeaponCombatSockets.Reset();
+    CachedWeaponCombatSocketNames.Reset();
+    CachedWeaponCombatSocketName = NAME_None;
+    bWeaponCombatSocketCacheValid = true;
+
+    if (!EquipmentComponent)
+    {
+        return;
+    }
+
+    const UItemDataAsset* ItemData = nullptr;
+    if (UEquippedItem* EquippedWeapon = EquipmentComponent->GetEquippedItem(EEquipmentSlot::Weapon))
+    {
+        ItemData = EquippedWeapon->GetItemData();
+    }
+
+    // Nomes: sockets de dano do Item (prioridade máxima), depois mapeamento do EquipmentComponent
+    if (ItemData)
+    {
+        for (const FName& SocketName : ItemData->DamageSockets)
         {
-            if (!Name.IsNone())
+            if (!SocketName.IsNone())
             {
-                Out.AddUnique(Name);
+                CachedWeaponCombatSocketNames.Add(SocketName);
             }
         }
     }
-    return Out;
-}
+    const TArray<FName> Mapped = EquipmentComponent->GetAllSocketNamesForSlot(EEquipmentSlot::Weapon);
+    for (const FName& Name : Mapped)
+    {
+        if (!Name.IsNone())
+        {
+            CachedWeaponCombatSocketNames.AddUnique(Name);
+        }
+    }
+    if (ItemData && ItemData->DamageSockets.Num() > 0 && !ItemData->DamageSockets[0].IsNone())
+    {
+        CachedWeaponCombatSocketName = ItemData->DamageSockets[0];
+    }
+    else if (Mapped.Num() > 0 && !Mapped[0].IsNone())
+    {
+        CachedWeaponCombatSocketName = Mapped[0];
+    }
 
-TArray<FVector> ARPGCharacter::GetCurrentWeaponCombatSocketLocations() const
-{
-    TArray<FVector> Out;
-    if (EquipmentComponent)
+    if (!ItemData)
+    {
+        return;
+    }
+
+    auto ResolveDamageSockets = [this, ItemData](const USkeletalMeshComponent* SkelComp)
     {
-        if (UEquippedItem* EquippedWeapon = EquipmentComponent->GetEquippedItem(EEquipmentSlot::Weapon))
+        for (const FName& SocketName : ItemData->DamageSockets)
         {
-            if (UItemDataAsset* ItemData = EquippedWeapon->GetItemData())
+            FCachedCombatSocket CachedSocket;
+            if (ResolveCombatSocket(SkelComp, SocketName, CachedSocket))
             {
-                // PRIORIDADE 1: Procurar DamageSockets na PRIMEIRA ARMA
-                if (EquippedMeshComponents.Contains(EEquipmentSlot::Weapon))
-                {
-                    if (const UMeshComponent* MeshComp = EquippedMeshComponents.FindRef(EEquipmentSlot::Weapon))
-                    {
-                        if (const USkeletalMeshComponent* SkelComp = Cast<USkeletalMeshComponent>(MeshComp))
-                        {
-                            for (const FName& SocketName : ItemData->DamageSockets)
-                            {
-                                if (!SocketName.IsNone() && SkelComp->DoesSocketExist(SocketName))
-                                {
-                                    Out.Add(SkelComp->GetSocketLocation(SocketName));
-                                }
-                            }
-                        }
-                    }
-                }
+                CachedWeaponCombatSockets.Add(CachedSocket);
+            }
+        }
+    };
 
-                // PRIORIDADE 2: Procurar DamageSockets na SEGUNDA ARMA (se existir)
-                if (EquippedExtraMeshes.Num() > 0)
-                {
-                    for (const FEquippedExtraMeshRef& ExtraMeshRef : EquippedExtraMeshes)
-                    {
-                        if (ExtraMeshRef.Slot == EEquipmentSlot::Weapon && ExtraMeshRef.Mesh)
-                        {
-                            if (USkeletalMeshComponent* ExtraSkelComp = Cast<USkeletalMeshComponent>(ExtraMeshRef.Mesh))
-                            {
-                                for (const FName& SocketName : ItemData->DamageSockets)
-                                {
-                                    if (!SocketName.IsNone() && ExtraSkelComp->DoesSocketExist(SocketName))
-                                    {
-                                        Out.Add(ExtraSkelComp->GetSocketLocation(SocketName));
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
+    // PRIORIDADE 1: DamageSockets na PRIMEIRA ARMA
+    if (const UMeshComponent* MeshComp = EquippedMeshComponents.FindRef(EEquipmentSlot::Weapon))
+    {
+        ResolveDamageSockets(Cast<USkeletalMeshComponent>(MeshComp));
+    }
 
-                // PRIORIDADE 3: Fallback para personagem principal
-                if (Out.Num() == 0)
-                {
-                    if (USkeletalMeshComponent* SkelMesh = GetMesh())
-                    {
-                        for (const FName& SocketName : ItemData->DamageSockets)
-                        {
-                            if (!SocketName.IsNone() && SkelMesh->DoesSocketExist(SocketName))
-                            {
-                                Out.Add(SkelMesh->GetSocketLocation(SocketName));
-                            }
-                        }
-                    }
-                }
-            }
+    // PRIORIDADE 2: DamageSockets na SEGUNDA ARMA (se existir)
+    for (const FEquippedExtraMeshRef& ExtraMeshRef : EquippedExtraMeshes)
+    {
+        if (ExtraMeshRef.Slot == EEquipmentSlot::Weapon && ExtraMeshRef.Mesh)
+        {
+            ResolveDamageSockets(Cast<USkeletalMeshComponent>(ExtraMeshRef.Mesh));
         }
     }
-    return Out;
+
+    // PRIORIDADE 3: Fallback para personagem principal
+    if (CachedWeaponCombatSockets.Num() == 0)
+    {
+        ResolveDamageSockets(GetMesh());
+    }
 }
 
 UMeshComponent* ARPGCharacter::GetEquippedMeshForSlot(EEquipmentSlot Slot) const
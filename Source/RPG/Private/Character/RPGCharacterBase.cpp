@@ -14,10 +14,14 @@
 #include "Progression/ProgressionSubsystem.h"
 #include "Character/RPGCharacter.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Engine/EngineTypes.h"
 #include "MotionWarpingComponent.h"
+#include "Character/RPGCombatantSpatialSubsystem.h"
+#include "AI/RPGSightTraceSubsystem.h"
+#include "AI/RPGAIStressStats.h"
 
 ARPGCharacterBase::ARPGCharacterBase(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<URPGCustomMovementComponent>(ACharacter::CharacterMovementComponentName))
@@ -117,6 +121,10 @@ void ARPGCharacterBase::MulticastHandleDeath_Implementation(const FVector& Death
 	}
 	
 	bDead = true;
+	if (URPGCombatantSpatialSubsystem* CombatantSpatial = URPGCombatantSpatialSubsystem::Get(this))
+	{
+		CombatantSpatial->SetCombatantAlive(this, false);
+	}
 	OnDeathDelegate.Broadcast(this);
 }
 
@@ -138,6 +146,30 @@ void ARPGCharacterBase::BeginPlay()
 {
 	Super::BeginPlay();
 	SetGenericTeamId(FGenericTeamId(static_cast<uint8>(Team)));
+
+	// OTIMIZAÇÃO: consultas de alvo usam o hash espacial em vez de overlaps de física
+	if (URPGCombatantSpatialSubsystem* CombatantSpatial = URPGCombatantSpatialSubsystem::Get(this))
+	{
+		CombatantSpatial->RegisterCombatant(this);
+	}
+}
+
+void ARPGCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (URPGCombatantSpatialSubsystem* CombatantSpatial = URPGCombatantSpatialSubsystem::Get(this))
+	{
+		CombatantSpatial->UnregisterCombatant(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void ARPGCharacterBase::SetGenericTeamId(const FGenericTeamId& InTeamID)
+{
+	TeamID = InTeamID;
+	if (URPGCombatantSpatialSubsystem* CombatantSpatial = URPGCombatantSpatialSubsystem::Get(this))
+	{
+		CombatantSpatial->SetCombatantTeam(this, TeamID);
+	}
 }
 
 FVector ARPGCharacterBase::GetCombatSocketLocation_Implementation(const FGameplayTag& MontageTag)
@@ -306,6 +338,16 @@ void ARPGCharacterBase::ApplyEffectToSelf(TSubclassOf<UGameplayEffect> GameplayE
 
 TArray<AActor*> ARPGCharacterBase::GetLivePlayersWithinRadius(double Radius, const FVector& SphereOrigin)
 {
+	if (const URPGCombatantSpatialSubsystem* CombatantSpatial = URPGCombatantSpatialSubsystem::Get(this))
+	{
+		FRPGCombatantQueryFilter Filter;
+		Filter.IgnoredActor = this;
+
+		TArray<AActor*> LiveActors;
+		CombatantSpatial->QueryRadius(SphereOrigin, static_cast<float>(Radius), Filter, LiveActors);
+		return LiveActors;
+	}
+
 	TArray<AActor*> OverlappingActors;
 	TArray<AActor*> OutActors;
 	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
@@ -329,6 +371,72 @@ TArray<AActor*> ARPGCharacterBase::GetLivePlayersWithinRadius(double Radius, con
 	return OverlappingActors;
 }
 
+UAISense_Sight::EVisibilityResult ARPGCharacterBase::CanBeSeenFrom(const FCanBeSeenFromContext& Context, FVector& OutSeenLocation, int32& OutNumberOfLoSChecksPerformed,
+	int32& OutNumberOfAsyncLosCheckRequested, float& OutSightStrength, int32* UserData, const FOnPendingVisibilityQueryProcessedDelegate* Delegate)
+{
+	// Coluna Perception do harness de carga de IA (chamado pelo UAIPerceptionSystem)
+	RPG_AI_STRESS_SCOPE(Perception);
+	OutNumberOfLoSChecksPerformed = 0;
+	OutNumberOfAsyncLosCheckRequested = 0;
+	OutSightStrength = 1.f;
+
+	// Pontos testados: sockets configurados (cabeça, tronco...) ou o centro do ator
+	TArray<FVector, TInlineAllocator<4>> TargetPoints;
+	if (const USkeletalMeshComponent* MeshComponent = GetMesh())
+	{
+		// OTIMIZAÇÃO: nomes resolvidos uma vez por mesh, sem busca de socket/osso por consulta
+		if (!bSightTargetPointsResolved || SightTargetPointsAsset.Get() != MeshComponent->GetSkinnedAsset())
+		{
+			ResolveSightTargetPoints(*MeshComponent);
+		}
+		for (const FSightTargetPoint& Point : SightTargetPoints)
+		{
+			TargetPoints.Add(Point.Socket ? Point.Socket->GetSocketLocation(MeshComponent) : MeshComponent->GetBoneTransform(Point.BoneIndex).GetLocation());
+		}
+	}
+	if (TargetPoints.Num() == 0)
+	{
+		TargetPoints.Add(GetActorLocation());
+	}
+
+	// OTIMIZAÇÃO: traces assíncronos com orçamento por frame em vez de traces síncronos na game thread
+	if (URPGSightTraceSubsystem* SightTraces = GetWorld() ? GetWorld()->GetSubsystem<URPGSightTraceSubsystem>() : nullptr)
+	{
+		const UAISense_Sight::EVisibilityResult Result = SightTraces->QueryVisibility(Context, this, TargetPoints,
+			OutSeenLocation, OutNumberOfAsyncLosCheckRequested, UserData, Delegate);
+		OutSightStrength = Result == UAISense_Sight::EVisibilityResult::Visible ? 1.f : 0.f;
+		return Result;
+	}
+
+	// Sem subsistema (mundos de editor/preview): trace síncrono como o padrão do UAISense_Sight
+	FHitResult Hit;
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(RPGAISightTrace), true, Context.IgnoreActor);
+	OutNumberOfLoSChecksPerformed = 1;
+	const bool bBlocked = GetWorld()->LineTraceSingleByChannel(Hit, Context.ObserverLocation, TargetPoints[0], ECC_Visibility, Params)
+		&& !URPGSightTraceSubsystem::IsHitOnTarget(Hit, this);
+	OutSeenLocation = TargetPoints[0];
+	OutSightStrength = bBlocked ? 0.f : 1.f;
+	return bBlocked ? UAISense_Sight::EVisibilityResult::NotVisible : UAISense_Sight::EVisibilityResult::Visible;
+}
+
+void ARPGCharacterBase::ResolveSightTargetPoints(const USkeletalMeshComponent& MeshComponent)
+{
+	SightTargetPoints.Reset();
+	SightTargetPointsAsset = MeshComponent.GetSkinnedAsset();
+	bSightTargetPointsResolved = true;
+
+	for (const FName& SocketName : SightTargetSocketNames)
+	{
+		FSightTargetPoint Point;
+		Point.Socket = MeshComponent.GetSocketByName(SocketName);
+		Point.BoneIndex = Point.Socket ? INDEX_NONE : MeshComponent.GetBoneIndex(SocketName);
+		if (Point.Socket || Point.BoneIndex != INDEX_NONE)
+		{
+			SightTargetPoints.Add(Point);
+		}
+	}
+}
+
 void ARPGCharacterBase::InitializeDefaultAttributes() const
 {
 	if (!AbilitySystemComponent || !IsValid(AbilitySystemComponent))
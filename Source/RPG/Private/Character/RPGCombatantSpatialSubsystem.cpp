@@ -0,0 +1,314 @@
+// Copyright (c) 2025 RPG Yumi Project. All rights reserved.
+
+#include "Character/RPGCombatantSpatialSubsystem.h"
+#include "Character/RPGCharacterBase.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+void URPGCombatantSpatialSubsystem::Deinitialize()
+{
+	for (FCombatantEntry& Entry : Entries)
+	{
+		if (USceneComponent* Root = Entry.RootComponent.Get())
+		{
+			Root->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+		}
+	}
+	Entries.Empty();
+	Cells.Empty();
+	EntryIndexByCombatant.Empty();
+
+	Super::Deinitialize();
+}
+
+bool URPGCombatantSpatialSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+URPGCombatantSpatialSubsystem* URPGCombatantSpatialSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<URPGCombatantSpatialSubsystem>() : nullptr;
+}
+
+// === REGISTRO ===
+
+void URPGCombatantSpatialSubsystem::RegisterCombatant(ARPGCharacterBase* Combatant)
+{
+	if (!IsValid(Combatant) || EntryIndexByCombatant.Contains(Combatant)) return;
+
+	USceneComponent* Root = Combatant->GetRootComponent();
+	if (!Root) return;
+
+	FCombatantEntry Entry;
+	Entry.Combatant = Combatant;
+	Entry.RootComponent = Root;
+	Entry.Location = Root->GetComponentLocation();
+	Entry.Cell = GetCell(Entry.Location);
+	Entry.TeamId = static_cast<const IGenericTeamAgentInterface*>(Combatant)->GetGenericTeamId();
+	Entry.bAlive = !Combatant->IsDead_Implementation();
+
+	if (const UCapsuleComponent* Capsule = Combatant->GetCapsuleComponent())
+	{
+		Entry.BoundsRadius = Capsule->GetScaledCapsuleRadius();
+		Entry.BoundsSegmentHalfLength = FMath::Max(0.f, Capsule->GetScaledCapsuleHalfHeight() - Entry.BoundsRadius);
+	}
+	MaxBoundsRadius = FMath::Max(MaxBoundsRadius, Entry.BoundsRadius);
+
+	const int32 EntryIndex = Entries.Add(MoveTemp(Entry));
+	Entries[EntryIndex].TransformUpdatedHandle = Root->TransformUpdated.AddUObject(this, &URPGCombatantSpatialSubsystem::OnCombatantTransformUpdated, EntryIndex);
+
+	AddToCell(EntryIndex, Entries[EntryIndex].Cell);
+	EntryIndexByCombatant.Add(Combatant, EntryIndex);
+}
+
+void URPGCombatantSpatialSubsystem::UnregisterCombatant(ARPGCharacterBase* Combatant)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (!EntryIndexByCombatant.RemoveAndCopyValue(Combatant, EntryIndex)) return;
+
+	FCombatantEntry& Entry = Entries[EntryIndex];
+	if (USceneComponent* Root = Entry.RootComponent.Get())
+	{
+		Root->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+	}
+	RemoveFromCell(EntryIndex, Entry.Cell);
+	Entries.RemoveAt(EntryIndex);
+}
+
+void URPGCombatantSpatialSubsystem::SetCombatantAlive(const ARPGCharacterBase* Combatant, bool bAlive)
+{
+	if (const int32* EntryIndex = EntryIndexByCombatant.Find(Combatant))
+	{
+		Entries[*EntryIndex].bAlive = bAlive;
+	}
+}
+
+void URPGCombatantSpatialSubsystem::SetCombatantTeam(const ARPGCharacterBase* Combatant, FGenericTeamId TeamId)
+{
+	if (const int32* EntryIndex = EntryIndexByCombatant.Find(Combatant))
+	{
+		Entries[*EntryIndex].TeamId = TeamId;
+	}
+}
+
+// === HASH ===
+
+FIntPoint URPGCombatantSpatialSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CELL_SIZE), FMath::FloorToInt32(Location.Y / CELL_SIZE));
+}
+
+void URPGCombatantSpatialSubsystem::AddToCell(int32 EntryIndex, const FIntPoint& Cell)
+{
+	Cells.FindOrAdd(Cell).Add(EntryIndex);
+}
+
+void URPGCombatantSpatialSubsystem::RemoveFromCell(int32 EntryIndex, const FIntPoint& Cell)
+{
+	if (FCellEntries* CellEntries = Cells.Find(Cell))
+	{
+		CellEntries->RemoveSwap(EntryIndex, EAllowShrinking::No);
+		if (CellEntries->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void URPGCombatantSpatialSubsystem::OnCombatantTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, int32 EntryIndex)
+{
+	if (!Entries.IsValidIndex(EntryIndex) || !UpdatedComponent) return;
+
+	FCombatantEntry& Entry = Entries[EntryIndex];
+	Entry.Location = UpdatedComponent->GetComponentLocation();
+
+	// OTIMIZAÇÃO: só mexe no mapa de células quando o combatente troca de célula
+	const FIntPoint NewCell = GetCell(Entry.Location);
+	if (NewCell != Entry.Cell)
+	{
+		RemoveFromCell(EntryIndex, Entry.Cell);
+		AddToCell(EntryIndex, NewCell);
+		Entry.Cell = NewCell;
+	}
+}
+
+template <typename FunctorType>
+void URPGCombatantSpatialSubsystem::ForEachEntryInBounds(const FVector& Min, const FVector& Max, FunctorType&& Functor) const
+{
+	const FIntPoint MinCell = GetCell(Min);
+	const FIntPoint MaxCell = GetCell(Max);
+	const int64 NumCellsInBounds = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+
+	// Consultas muito grandes: percorrer só as células ocupadas é mais barato que o retângulo inteiro
+	if (NumCellsInBounds > Cells.Num())
+	{
+		for (const TPair<FIntPoint, FCellEntries>& Pair : Cells)
+		{
+			if (Pair.Key.X < MinCell.X || Pair.Key.X > MaxCell.X || Pair.Key.Y < MinCell.Y || Pair.Key.Y > MaxCell.Y) continue;
+			for (const int32 EntryIndex : Pair.Value)
+			{
+				Functor(EntryIndex, Entries[EntryIndex]);
+			}
+		}
+		return;
+	}
+
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			if (const FCellEntries* CellEntries = Cells.Find(FIntPoint(CellX, CellY)))
+			{
+				for (const int32 EntryIndex : *CellEntries)
+				{
+					Functor(EntryIndex, Entries[EntryIndex]);
+				}
+			}
+		}
+	}
+}
+
+bool URPGCombatantSpatialSubsystem::PassesFilter(const FCombatantEntry& Entry, const FRPGCombatantQueryFilter& Filter) const
+{
+	if (!Filter.bIncludeDead && !Entry.bAlive) return false;
+
+	if (Filter.TeamFilter == ERPGCombatantTeamFilter::SameTeam && Entry.TeamId != Filter.TeamId) return false;
+	if (Filter.TeamFilter == ERPGCombatantTeamFilter::OtherTeam && Entry.TeamId == Filter.TeamId) return false;
+
+	const AActor* Actor = Entry.Combatant.Get();
+	if (!Actor) return false;
+	if (Actor == Filter.IgnoredActor) return false;
+	if (Filter.IgnoredActors.Num() > 0 && Filter.IgnoredActors.Contains(Actor)) return false;
+
+	return true;
+}
+
+FVector URPGCombatantSpatialSubsystem::GetClosestAxisPoint(const FCombatantEntry& Entry, const FVector& Point, bool bInflateByBounds)
+{
+	if (!bInflateByBounds || Entry.BoundsSegmentHalfLength <= 0.f)
+	{
+		return Entry.Location;
+	}
+
+	// Cápsula de personagem sempre em pé: eixo vertical
+	FVector AxisPoint = Entry.Location;
+	AxisPoint.Z += FMath::Clamp(Point.Z - Entry.Location.Z, -Entry.BoundsSegmentHalfLength, Entry.BoundsSegmentHalfLength);
+	return AxisPoint;
+}
+
+// === CONSULTAS ===
+
+int32 URPGCombatantSpatialSubsystem::QueryRadius(const FVector& Origin, float Radius, const FRPGCombatantQueryFilter& Filter, TArray<AActor*>& OutActors) const
+{
+	const int32 NumBefore = OutActors.Num();
+	const FVector Reach(Radius + (Filter.bInflateByBounds ? MaxBoundsRadius : 0.f));
+
+	ForEachEntryInBounds(Origin - Reach, Origin + Reach, [&](int32, const FCombatantEntry& Entry)
+	{
+		if (!PassesFilter(Entry, Filter)) return;
+
+		const float TestRadius = Radius + (Filter.bInflateByBounds ? Entry.BoundsRadius : 0.f);
+		if (FVector::DistSquared(GetClosestAxisPoint(Entry, Origin, Filter.bInflateByBounds), Origin) <= FMath::Square(TestRadius))
+		{
+			OutActors.Add(Entry.Combatant.Get());
+		}
+	});
+
+	return OutActors.Num() - NumBefore;
+}
+
+int32 URPGCombatantSpatialSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees, const FRPGCombatantQueryFilter& Filter, TArray<AActor*>& OutActors) const
+{
+	const int32 NumBefore = OutActors.Num();
+	const FVector ConeDirection = Direction.GetSafeNormal();
+	const float HalfAngleRadians = FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.f, 180.f));
+	const FVector Reach(Radius + (Filter.bInflateByBounds ? MaxBoundsRadius : 0.f));
+
+	ForEachEntryInBounds(Origin - Reach, Origin + Reach, [&](int32, const FCombatantEntry& Entry)
+	{
+		if (!PassesFilter(Entry, Filter)) return;
+
+		const float BoundsRadius = Filter.bInflateByBounds ? Entry.BoundsRadius : 0.f;
+		const FVector ToTarget = GetClosestAxisPoint(Entry, Origin, Filter.bInflateByBounds) - Origin;
+		const float DistSq = ToTarget.SizeSquared();
+		if (DistSq > FMath::Square(Radius + BoundsRadius)) return;
+
+		// Origem dentro da cápsula: sempre conta
+		const float Dist = FMath::Sqrt(DistSq);
+		if (Dist <= BoundsRadius || ConeDirection.IsNearlyZero())
+		{
+			OutActors.Add(Entry.Combatant.Get());
+			return;
+		}
+
+		// Folga angular equivalente ao raio da cápsula vista da origem
+		const float AngleToTarget = FMath::Acos(FMath::Clamp(FVector::DotProduct(ToTarget / Dist, ConeDirection), -1.f, 1.f));
+		const float AngularSlack = BoundsRadius > 0.f ? FMath::Asin(FMath::Min(BoundsRadius / Dist, 1.f)) : 0.f;
+		if (AngleToTarget <= HalfAngleRadians + AngularSlack)
+		{
+			OutActors.Add(Entry.Combatant.Get());
+		}
+	});
+
+	return OutActors.Num() - NumBefore;
+}
+
+int32 URPGCombatantSpatialSubsystem::QueryBox(const FTransform& BoxTransform, const FVector& HalfExtent, const FRPGCombatantQueryFilter& Filter, TArray<AActor*>& OutActors) const
+{
+	const int32 NumBefore = OutActors.Num();
+	const FQuat BoxRotation = BoxTransform.GetRotation();
+	const FVector BoxCenter = BoxTransform.GetTranslation();
+
+	// AABB da caixa orientada (escala do transform ignorada; use HalfExtent)
+	FBox WorldBounds = FBox(-HalfExtent, HalfExtent).TransformBy(FTransform(BoxRotation, BoxCenter));
+	WorldBounds = WorldBounds.ExpandBy(Filter.bInflateByBounds ? MaxBoundsRadius : 0.f);
+
+	ForEachEntryInBounds(WorldBounds.Min, WorldBounds.Max, [&](int32, const FCombatantEntry& Entry)
+	{
+		if (!PassesFilter(Entry, Filter)) return;
+
+		const FVector LocalPoint = BoxRotation.UnrotateVector(GetClosestAxisPoint(Entry, BoxCenter, Filter.bInflateByBounds) - BoxCenter);
+		const FVector ClampedPoint = LocalPoint.BoundToBox(-HalfExtent, HalfExtent);
+		const float BoundsRadius = Filter.bInflateByBounds ? Entry.BoundsRadius : 0.f;
+		if (FVector::DistSquared(LocalPoint, ClampedPoint) <= FMath::Square(BoundsRadius))
+		{
+			OutActors.Add(Entry.Combatant.Get());
+		}
+	});
+
+	return OutActors.Num() - NumBefore;
+}
+
+int32 URPGCombatantSpatialSubsystem::QueryNearest(const FVector& Origin, int32 MaxResults, float MaxRadius, const FRPGCombatantQueryFilter& Filter, TArray<AActor*>& OutActors) const
+{
+	if (MaxResults <= 0) return 0;
+
+	TArray<TPair<float, AActor*>, TInlineAllocator<32>> Candidates;
+	const FVector Reach(MaxRadius + (Filter.bInflateByBounds ? MaxBoundsRadius : 0.f));
+
+	ForEachEntryInBounds(Origin - Reach, Origin + Reach, [&](int32, const FCombatantEntry& Entry)
+	{
+		if (!PassesFilter(Entry, Filter)) return;
+
+		// Distância até a superfície da cápsula (ou até o centro sem bInflateByBounds)
+		const float BoundsRadius = Filter.bInflateByBounds ? Entry.BoundsRadius : 0.f;
+		const float Distance = FMath::Max(0.f, FVector::Dist(GetClosestAxisPoint(Entry, Origin, Filter.bInflateByBounds), Origin) - BoundsRadius);
+		if (Distance <= MaxRadius)
+		{
+			Candidates.Emplace(Distance, Entry.Combatant.Get());
+		}
+	});
+
+	Candidates.Sort([](const TPair<float, AActor*>& A, const TPair<float, AActor*>& B) { return A.Key < B.Key; });
+
+	const int32 NumResults = FMath::Min(MaxResults, Candidates.Num());
+	OutActors.Reserve(OutActors.Num() + NumResults);
+	for (int32 Index = 0; Index < NumResults; ++Index)
+	{
+		OutActors.Add(Candidates[Index].Value);
+	}
+	return NumResults;
+}
@@ -1,6 +1,7 @@
 // Copyright Druid Mechanics
 
 #include "Character/RPGCustomMovementComponent.h"
+#include "AI/RPGAIStressStats.h"
 
 URPGCustomMovementComponent::URPGCustomMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -8,3 +9,9 @@ URPGCustomMovementComponent::URPGCustomMovementComponent(const FObjectInitialize
 	// Por enquanto sem mudanças, apenas a estrutura base
 }
 
+void URPGCustomMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	// Coluna Movement do harness de carga de IA
+	RPG_AI_STRESS_SCOPE(Movement);
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
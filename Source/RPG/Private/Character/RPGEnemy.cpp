@@ -77,7 +77,7 @@ void ARPGEnemy::PossessedBy(AController* NewController)
 	{
 		RPGAIController->GetBlackboardComponent()->InitializeBlackboard(*BehaviorTree->BlackboardAsset);
 		RPGAIController->RunBehaviorTree(BehaviorTree);
-		RPGAIController->GetBlackboardComponent()->SetValueAsBool(FName("HitReacting"), false);
+		RPGBlackboard::SetBool(RPGAIController->GetBlackboardComponent(), RPGAIController->GetBlackboardKeys().HitReacting, false);
 	}
 }
 
@@ -98,7 +98,7 @@ void ARPGEnemy::Die(const FVector& DeathImpulse)
 	// Definir a chave "Dead" no Blackboard como true
 	if (RPGAIController && RPGAIController->GetBlackboardComponent())
 	{
-		RPGAIController->GetBlackboardComponent()->SetValueAsBool(FName("Dead"), true);
+		RPGBlackboard::SetBool(RPGAIController->GetBlackboardComponent(), RPGAIController->GetBlackboardKeys().Dead, true);
 	}
 	
 			// Sistema de missões agora é tratado em SendXPEvent() no AttributeSet
@@ -186,7 +186,7 @@ void ARPGEnemy::HitReactTagChanged(const FGameplayTag CallbackTag, int32 NewCoun
 
 	if (RPGAIController && RPGAIController->GetBlackboardComponent())
 	{
-		RPGAIController->GetBlackboardComponent()->SetValueAsBool(FName("HitReacting"), bHitReacting);
+		RPGBlackboard::SetBool(RPGAIController->GetBlackboardComponent(), RPGAIController->GetBlackboardKeys().HitReacting, bHitReacting);
 	}
 }
 
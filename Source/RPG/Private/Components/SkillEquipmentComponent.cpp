@@ -9,6 +9,7 @@
 #include "Game/RPGGameModeBase.h"
 #include "Kismet/GameplayStatics.h"
 #include "Progression/SkillTreeTableRow.h"
+#include "AbilitySystemComponent.h"
 
 USkillEquipmentComponent::USkillEquipmentComponent()
 {
@@ -96,26 +97,14 @@ bool USkillEquipmentComponent::EquipSkill(const FName& SkillID, const FName& Slo
         return false;
     }
     
-    // Auto-remover: Desequipar habilidade atual no slot (se houver)
-    if (HasSlot(SlotID))
-    {
-        // Desequipar habilidade atual
-        UnequipSkill(SlotID);
-    }
-    
-    // Equipar a nova habilidade no slot
-    EquippedSkills.Add(SlotID, SkillID);
-    
-    // ✅ NOVO: Conceder via GAS com a InputTag do slot
-    GrantSkillToCharacter(SkillID, SlotInputTag);
+    // Equipamento manual invalida o preset ativo
+    ActiveLoadoutPreset = NAME_None;
     
-    // Disparar delegates
-    FName CharacterID = GetCharacterID();
-    OnSkillEquipmentEquipped.Broadcast(CharacterID, SlotID, SkillID);
-    
-    // ✅ NOVO: Disparar delegate com ícone
-    UTexture2D* SkillIcon = GetSkillIcon(SkillID);
-    OnSkillEquippedInSlot.Broadcast(SlotID, SkillID, SkillIcon);
+    FSkillLoadoutSlot LoadoutSlot;
+    LoadoutSlot.SlotID = SlotID;
+    LoadoutSlot.SkillID = SkillID;
+    LoadoutSlot.InputTag = SlotInputTag;
+    EquipResolvedSlot(LoadoutSlot);
     
     return true;
 }
@@ -141,6 +130,8 @@ bool USkillEquipmentComponent::UnequipSkill(const FName& SlotID)
     
     // Remover do mapa (remove o slot também)
     EquippedSkills.Remove(SlotID);
+    EquippedSlotInputTags.Remove(SlotID);
+    ActiveLoadoutPreset = NAME_None;
     
     // Disparar delegate
     FName CharacterID = GetCharacterID();
@@ -358,122 +349,416 @@ void USkillEquipmentComponent::ValidateWithSkillTreeSubsystem()
 
 void USkillEquipmentComponent::GrantSkillToCharacter(const FName& SkillID, const FGameplayTag& SlotInputTag)
 {
-    ARPGCharacter* Character = GetOwnerCharacter();
-    if (!Character)
+    TSubclassOf<UGameplayAbility> AbilityClass = ResolveSkillAbilityClass(SkillID);
+    if (!AbilityClass)
     {
         return;
     }
     
-    // Obter a classe da habilidade via SkillTreeSubsystem
-    TSubclassOf<UGameplayAbility> AbilityClass = nullptr;
-    if (UWorld* World = GetWorld())
+    // Usar a InputTag do slot; fallback para a tag da habilidade se a do slot for inválida
+    FGameplayTag InputTag = SlotInputTag;
+    if (!InputTag.IsValid())
     {
-        if (UGameInstance* GameInstance = World->GetGameInstance())
+        if (const URPGGameplayAbility* RPGAbility = Cast<URPGGameplayAbility>(AbilityClass->GetDefaultObject()))
         {
-            if (USkillTreeSubsystem* SkillTreeSubsystem = GameInstance->GetSubsystem<USkillTreeSubsystem>())
+            InputTag = RPGAbility->StartupInputTag;
+        }
+    }
+    
+    GrantResolvedSkill(SkillID, AbilityClass, InputTag);
+}
+
+void USkillEquipmentComponent::GrantResolvedSkill(const FName& SkillID, TSubclassOf<UGameplayAbility> AbilityClass, const FGameplayTag& SlotInputTag)
+{
+    UAbilitySystemComponent* ASC = GetOwnerAbilitySystemComponent();
+    if (!AbilityClass || !ASC)
+    {
+        return;
+    }
+    
+    // OTIMIZAÇÃO: se a habilidade já está concedida, apenas religar a InputTag
+    if (FGrantedSkillEntry* Entry = GrantedSkills.Find(SkillID))
+    {
+        if (FGameplayAbilitySpec* Spec = ASC->FindAbilitySpecFromHandle(Entry->Handle))
+        {
+            if (Entry->BoundInputTag != SlotInputTag)
             {
-                // Buscar dados da habilidade no Data Table
-                FName CharacterID = Character->GetCharacterUniqueID();
-                UDataTable* DataTable = SkillTreeSubsystem->GetCharacterSkillTable(CharacterID);
-                
-                if (DataTable)
+                if (Entry->BoundInputTag.IsValid())
                 {
-                    TArray<FName> RowNames = DataTable->GetRowNames();
-                    for (const FName& RowName : RowNames)
-                    {
-                        if (FSkillTreeTableRow* Row = DataTable->FindRow<FSkillTreeTableRow>(RowName, TEXT("GrantSkillToCharacter")))
-                        {
-                            if (Row->SkillID == SkillID)
-                            {
-                                AbilityClass = Row->AbilityClass;
-                                break;
-                            }
-                        }
-                    }
+                    Spec->GetDynamicSpecSourceTags().RemoveTag(Entry->BoundInputTag);
+                }
+                if (SlotInputTag.IsValid())
+                {
+                    Spec->GetDynamicSpecSourceTags().AddTag(SlotInputTag);
+                }
+                Entry->BoundInputTag = SlotInputTag;
+                ASC->MarkAbilitySpecDirty(*Spec);
+                if (URPGAbilitySystemComponent* RPGASC = Cast<URPGAbilitySystemComponent>(ASC))
+                {
+                    RPGASC->MarkInputTagRoutingDirty();
                 }
             }
+            return;
         }
+        
+        // Spec não existe mais (removido por outro caminho)
+        GrantedSkills.Remove(SkillID);
     }
     
-    // Conceder a habilidade via GAS
-    if (AbilityClass && Character->GetAbilitySystemComponent())
+    // Criar spec da habilidade com a InputTag do slot
+    FGameplayAbilitySpec AbilitySpec(AbilityClass, 1);
+    if (SlotInputTag.IsValid())
     {
-        // Criar spec da habilidade
-        FGameplayAbilitySpec AbilitySpec(AbilityClass, 1);
-        
-        // ✅ NOVO: Usar a InputTag do slot em vez da da habilidade
-        if (!SlotInputTag.IsValid())
+        AbilitySpec.GetDynamicSpecSourceTags().AddTag(SlotInputTag);
+    }
+    
+    // Conceder a habilidade
+    FGrantedSkillEntry NewEntry;
+    NewEntry.Handle = ASC->GiveAbility(AbilitySpec);
+    NewEntry.BoundInputTag = SlotInputTag;
+    GrantedSkills.Add(SkillID, NewEntry);
+}
+
+void USkillEquipmentComponent::RemoveSkillFromCharacter(const FName& SkillID)
+{
+    UAbilitySystemComponent* ASC = GetOwnerAbilitySystemComponent();
+    if (!ASC)
+    {
+        return;
+    }
+    
+    if (FGrantedSkillEntry* Entry = GrantedSkills.Find(SkillID))
+    {
+        if (bKeepUnequippedSkillsGranted)
         {
-            // Fallback: usar tag da habilidade se a do slot for inválida
-            if (const URPGGameplayAbility* RPGAbility = Cast<URPGGameplayAbility>(AbilitySpec.Ability))
+            // Manter concedida, apenas remover a InputTag
+            if (FGameplayAbilitySpec* Spec = ASC->FindAbilitySpecFromHandle(Entry->Handle))
             {
-                AbilitySpec.GetDynamicSpecSourceTags().AddTag(RPGAbility->StartupInputTag);
+                if (Entry->BoundInputTag.IsValid())
+                {
+                    Spec->GetDynamicSpecSourceTags().RemoveTag(Entry->BoundInputTag);
+                    ASC->MarkAbilitySpecDirty(*Spec);
+                    if (URPGAbilitySystemComponent* RPGASC = Cast<URPGAbilitySystemComponent>(ASC))
+                    {
+                        RPGASC->MarkInputTagRoutingDirty();
+                    }
+                }
+                Entry->BoundInputTag = FGameplayTag();
+                return;
             }
         }
         else
         {
-            // ✅ NOVO: Configurar a tag de input do slot
-            AbilitySpec.GetDynamicSpecSourceTags().AddTag(SlotInputTag);
+            ASC->ClearAbility(Entry->Handle);
         }
         
-        // Conceder a habilidade
-        Character->GetAbilitySystemComponent()->GiveAbility(AbilitySpec);
+        GrantedSkills.Remove(SkillID);
+        return;
+    }
+    
+    // Fallback: habilidade concedida fora deste componente
+    TSubclassOf<UGameplayAbility> AbilityClass = ResolveSkillAbilityClass(SkillID);
+    if (AbilityClass)
+    {
+        if (FGameplayAbilitySpec* Spec = ASC->FindAbilitySpecFromClass(AbilityClass))
+        {
+            ASC->ClearAbility(Spec->Handle);
+        }
     }
 }
 
-void USkillEquipmentComponent::RemoveSkillFromCharacter(const FName& SkillID)
+TSubclassOf<UGameplayAbility> USkillEquipmentComponent::ResolveSkillAbilityClass(const FName& SkillID)
 {
+    if (SkillID.IsNone())
+    {
+        return nullptr;
+    }
+    
+    if (const TSubclassOf<UGameplayAbility>* CachedClass = SkillAbilityClassCache.Find(SkillID))
+    {
+        return *CachedClass;
+    }
+    
+    // Cache vazio ou desatualizado: reconstruir uma vez a partir do DataTable
+    RebuildSkillAbilityClassCache();
+    return SkillAbilityClassCache.FindRef(SkillID);
+}
+
+void USkillEquipmentComponent::RebuildSkillAbilityClassCache()
+{
+    SkillAbilityClassCache.Reset();
+    
     ARPGCharacter* Character = GetOwnerCharacter();
     if (!Character)
     {
         return;
     }
     
-    // Obter a classe da habilidade via SkillTreeSubsystem
-    TSubclassOf<UGameplayAbility> AbilityClass = nullptr;
     if (UWorld* World = GetWorld())
     {
         if (UGameInstance* GameInstance = World->GetGameInstance())
         {
             if (USkillTreeSubsystem* SkillTreeSubsystem = GameInstance->GetSubsystem<USkillTreeSubsystem>())
             {
-                // Buscar dados da habilidade no Data Table
-                FName CharacterID = Character->GetCharacterUniqueID();
-                UDataTable* DataTable = SkillTreeSubsystem->GetCharacterSkillTable(CharacterID);
-                
-                if (DataTable)
+                if (UDataTable* DataTable = SkillTreeSubsystem->GetCharacterSkillTable(Character->GetCharacterUniqueID()))
                 {
-                    TArray<FName> RowNames = DataTable->GetRowNames();
-                    for (const FName& RowName : RowNames)
-                    {
-                        if (FSkillTreeTableRow* Row = DataTable->FindRow<FSkillTreeTableRow>(RowName, TEXT("RemoveSkillFromCharacter")))
+                    DataTable->ForeachRow<FSkillTreeTableRow>(TEXT("RebuildSkillAbilityClassCache"),
+                        [this](const FName& RowName, const FSkillTreeTableRow& Row)
                         {
-                            if (Row->SkillID == SkillID)
+                            if (!Row.SkillID.IsNone() && !SkillAbilityClassCache.Contains(Row.SkillID))
                             {
-                                AbilityClass = Row->AbilityClass;
-                                break;
+                                SkillAbilityClassCache.Add(Row.SkillID, Row.AbilityClass);
                             }
-                        }
-                    }
+                        });
                 }
             }
         }
     }
+}
+
+UAbilitySystemComponent* USkillEquipmentComponent::GetOwnerAbilitySystemComponent() const
+{
+    if (ARPGCharacter* Character = GetOwnerCharacter())
+    {
+        return Character->GetAbilitySystemComponent();
+    }
+    return nullptr;
+}
+
+void USkillEquipmentComponent::EquipResolvedSlot(const FSkillLoadoutSlot& LoadoutSlot)
+{
+    if (LoadoutSlot.SlotID.IsNone() || LoadoutSlot.SkillID.IsNone())
+    {
+        return;
+    }
     
-    // Remover a habilidade via GAS
-    if (AbilityClass && Character->GetAbilitySystemComponent())
+    // Uma habilidade só pode ocupar um slot: se já estiver em outro, é movida para este.
+    // Checado antes de desequipar o slot alvo para nunca deixá-lo vazio por engano
+    const FName PreviousSlotID = GetSkillEquippedSlot(LoadoutSlot.SkillID);
+    if (PreviousSlotID == LoadoutSlot.SlotID && EquippedSlotInputTags.FindRef(LoadoutSlot.SlotID) == LoadoutSlot.InputTag)
     {
-        UAbilitySystemComponent* ASC = Character->GetAbilitySystemComponent();
-        TArray<FGameplayAbilitySpec> AbilitySpecs = ASC->GetActivatableAbilities();
-        
-        for (const FGameplayAbilitySpec& Spec : AbilitySpecs)
+        return;
+    }
+    if (!PreviousSlotID.IsNone() && PreviousSlotID != LoadoutSlot.SlotID)
+    {
+        UnequipSkill(PreviousSlotID);
+    }
+    
+    // Auto-remover: Desequipar habilidade atual no slot (se houver)
+    if (HasSlot(LoadoutSlot.SlotID))
+    {
+        UnequipSkill(LoadoutSlot.SlotID);
+    }
+    
+    // Equipar a nova habilidade no slot
+    EquippedSkills.Add(LoadoutSlot.SlotID, LoadoutSlot.SkillID);
+    EquippedSlotInputTags.Add(LoadoutSlot.SlotID, LoadoutSlot.InputTag);
+    
+    // Conceder via GAS com a InputTag do slot (classe pré-resolvida quando disponível)
+    if (LoadoutSlot.AbilityClass)
+    {
+        FGameplayTag InputTag = LoadoutSlot.InputTag;
+        if (!InputTag.IsValid())
         {
-            if (Spec.Ability && Spec.Ability->GetClass() == AbilityClass)
+            if (const URPGGameplayAbility* RPGAbility = Cast<URPGGameplayAbility>(LoadoutSlot.AbilityClass->GetDefaultObject()))
             {
-                ASC->ClearAbility(Spec.Handle);
-                break;
+                InputTag = RPGAbility->StartupInputTag;
             }
         }
+        GrantResolvedSkill(LoadoutSlot.SkillID, LoadoutSlot.AbilityClass, InputTag);
+    }
+    else
+    {
+        GrantSkillToCharacter(LoadoutSlot.SkillID, LoadoutSlot.InputTag);
+    }
+    
+    // Disparar delegates
+    FName CharacterID = GetCharacterID();
+    OnSkillEquipmentEquipped.Broadcast(CharacterID, LoadoutSlot.SlotID, LoadoutSlot.SkillID);
+    
+    UTexture2D* SkillIcon = GetSkillIcon(LoadoutSlot.SkillID);
+    OnSkillEquippedInSlot.Broadcast(LoadoutSlot.SlotID, LoadoutSlot.SkillID, SkillIcon);
+}
+
+// === PRESETS DE LOADOUT ===
+
+bool USkillEquipmentComponent::SaveLoadoutPreset(const FName& PresetName, const TArray<FSkillLoadoutSlot>& Slots)
+{
+    if (PresetName.IsNone())
+    {
+        return false;
+    }
+    
+    USkillTreeSubsystem* SkillTreeSubsystem = nullptr;
+    if (UWorld* World = GetWorld())
+    {
+        if (UGameInstance* GameInstance = World->GetGameInstance())
+        {
+            SkillTreeSubsystem = GameInstance->GetSubsystem<USkillTreeSubsystem>();
+        }
+    }
+    
+    ARPGCharacter* Character = GetOwnerCharacter();
+    
+    FSkillLoadoutPreset Preset;
+    Preset.Slots.Reserve(Slots.Num());
+    
+    TSet<FName> UsedSlots;
+    TSet<FName> UsedSkills;
+    
+    for (const FSkillLoadoutSlot& Slot : Slots)
+    {
+        if (Slot.SlotID.IsNone() || Slot.SkillID.IsNone())
+        {
+            continue;
+        }
+        
+        // Ignorar slots e habilidades duplicadas
+        if (UsedSlots.Contains(Slot.SlotID) || UsedSkills.Contains(Slot.SkillID))
+        {
+            continue;
+        }
+        
+        // Apenas habilidades desbloqueadas
+        if (SkillTreeSubsystem && Character && !SkillTreeSubsystem->SkillUnlocked(Character, Slot.SkillID))
+        {
+            continue;
+        }
+        
+        // Resolver a classe uma única vez
+        FSkillLoadoutSlot& ResolvedSlot = Preset.Slots.Add_GetRef(Slot);
+        ResolvedSlot.AbilityClass = ResolveSkillAbilityClass(Slot.SkillID);
+        
+        UsedSlots.Add(Slot.SlotID);
+        UsedSkills.Add(Slot.SkillID);
+    }
+    
+    LoadoutPresets.Add(PresetName, MoveTemp(Preset));
+    return true;
+}
+
+bool USkillEquipmentComponent::SaveCurrentLoadoutAsPreset(const FName& PresetName)
+{
+    TArray<FSkillLoadoutSlot> Slots;
+    Slots.Reserve(EquippedSkills.Num());
+    
+    for (const auto& Pair : EquippedSkills)
+    {
+        FSkillLoadoutSlot& Slot = Slots.AddDefaulted_GetRef();
+        Slot.SlotID = Pair.Key;
+        Slot.SkillID = Pair.Value;
+        Slot.InputTag = EquippedSlotInputTags.FindRef(Pair.Key);
+    }
+    
+    if (!SaveLoadoutPreset(PresetName, Slots))
+    {
+        return false;
+    }
+    
+    ActiveLoadoutPreset = PresetName;
+    return true;
+}
+
+bool USkillEquipmentComponent::RemoveLoadoutPreset(const FName& PresetName)
+{
+    if (ActiveLoadoutPreset == PresetName)
+    {
+        ActiveLoadoutPreset = NAME_None;
+    }
+    return LoadoutPresets.Remove(PresetName) > 0;
+}
+
+TArray<FName> USkillEquipmentComponent::GetLoadoutPresetNames() const
+{
+    TArray<FName> PresetNames;
+    LoadoutPresets.GetKeys(PresetNames);
+    return PresetNames;
+}
+
+bool USkillEquipmentComponent::ApplyLoadoutPreset(const FName& PresetName)
+{
+    const FSkillLoadoutPreset* Preset = LoadoutPresets.Find(PresetName);
+    if (!Preset)
+    {
+        return false;
+    }
+    
+    TMap<FName, const FSkillLoadoutSlot*> TargetBySlot;
+    TargetBySlot.Reserve(Preset->Slots.Num());
+    for (const FSkillLoadoutSlot& Slot : Preset->Slots)
+    {
+        TargetBySlot.Add(Slot.SlotID, &Slot);
+    }
+    
+    // 1. Desequipar apenas os slots que mudam (ou que não existem no preset)
+    TArray<FName> SlotsToClear;
+    for (const auto& Pair : EquippedSkills)
+    {
+        const FSkillLoadoutSlot* const* TargetSlot = TargetBySlot.Find(Pair.Key);
+        if (!TargetSlot
+            || (*TargetSlot)->SkillID != Pair.Value
+            || (*TargetSlot)->InputTag != EquippedSlotInputTags.FindRef(Pair.Key))
+        {
+            SlotsToClear.Add(Pair.Key);
+        }
+    }
+    
+    for (const FName& SlotID : SlotsToClear)
+    {
+        UnequipSkill(SlotID);
+    }
+    
+    // 2. Equipar apenas os slots que ainda não batem com o preset
+    for (const FSkillLoadoutSlot& Slot : Preset->Slots)
+    {
+        if (!IsSkillEquippedInSlot(Slot.SkillID, Slot.SlotID))
+        {
+            EquipResolvedSlot(Slot);
+        }
+    }
+    
+    ActiveLoadoutPreset = PresetName;
+    OnSkillLoadoutPresetApplied.Broadcast(GetCharacterID(), PresetName);
+    
+    return true;
+}
+
+void USkillEquipmentComponent::PreGrantLoadoutPreset(const FName& PresetName)
+{
+    const FSkillLoadoutPreset* Preset = LoadoutPresets.Find(PresetName);
+    if (!Preset)
+    {
+        return;
+    }
+    
+    for (const FSkillLoadoutSlot& Slot : Preset->Slots)
+    {
+        if (GrantedSkills.Contains(Slot.SkillID))
+        {
+            continue;
+        }
+        
+        // Conceder sem InputTag: o input é ligado só quando o slot for equipado
+        TSubclassOf<UGameplayAbility> AbilityClass = Slot.AbilityClass ? Slot.AbilityClass : ResolveSkillAbilityClass(Slot.SkillID);
+        GrantResolvedSkill(Slot.SkillID, AbilityClass, FGameplayTag());
+    }
+}
+
+void USkillEquipmentComponent::ClearUnboundGrantedSkills()
+{
+    UAbilitySystemComponent* ASC = GetOwnerAbilitySystemComponent();
+    if (!ASC)
+    {
+        return;
+    }
+    
+    for (auto It = GrantedSkills.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().BoundInputTag.IsValid())
+        {
+            ASC->ClearAbility(It.Value().Handle);
+            It.RemoveCurrent();
+        }
     }
 }
 
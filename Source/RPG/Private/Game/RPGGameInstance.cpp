@@ -2,6 +2,8 @@
 
 #include "Game/RPGGameInstance.h"
 #include "Quest/QuestSubsystem.h"
+#include "Progression/ProgressionSubsystem.h"
+#include "Engine/CurveTable.h"
 
 void URPGGameInstance::Init()
 {
@@ -12,6 +14,15 @@ void URPGGameInstance::Init()
 	{
 		QuestSubsystem->SetQuestDataAssets(QuestDataAssets);
 	}
+
+	// Configurar curvas de progressão (tabelas são pré-calculadas no subsistema)
+	if (ProgressionCurveTable)
+	{
+		if (UProgressionSubsystem* ProgressionSubsystem = GetSubsystem<UProgressionSubsystem>())
+		{
+			ProgressionSubsystem->SetProgressionCurveTable(ProgressionCurveTable);
+		}
+	}
 }
 
 // Sistema de save removido do projeto
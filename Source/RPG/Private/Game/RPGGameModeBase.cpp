@@ -40,3 +40,17 @@ void ARPGGameModeBase::SetupSkillTrees()
 	}
 }
 
+const FEnemyAttributeBaseline* ARPGGameModeBase::FindEnemyAttributeBaseline(ECharacterClass CharacterClass, int32 Level) const
+{
+	return EnemyAttributeBaselines.Find(MakeEnemyAttributeBaselineKey(CharacterClass, Level));
+}
+
+void ARPGGameModeBase::StoreEnemyAttributeBaseline(ECharacterClass CharacterClass, int32 Level, FEnemyAttributeBaseline&& Baseline)
+{
+	EnemyAttributeBaselines.Add(MakeEnemyAttributeBaselineKey(CharacterClass, Level), MoveTemp(Baseline));
+}
+
+uint32 ARPGGameModeBase::MakeEnemyAttributeBaselineKey(ECharacterClass CharacterClass, int32 Level)
+{
+	return (static_cast<uint32>(CharacterClass) << 24) | (static_cast<uint32>(Level) & 0x00FFFFFF);
+}
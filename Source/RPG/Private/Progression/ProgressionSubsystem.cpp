@@ -5,6 +5,105 @@
 #include "Kismet/GameplayStatics.h"
 #include "RPGGameplayTags.h"
 #include "AbilitySystemBlueprintLibrary.h"
+#include "Algo/BinarySearch.h"
+#include "TimerManager.h"
+#include "Engine/CurveTable.h"
+
+namespace ProgressionCurveRows
+{
+	static const FName BaseXP(TEXT("BaseXP"));
+	static const FName XPMultiplier(TEXT("XPMultiplier"));
+	static const FName AttributePointsReward(TEXT("AttributePointsReward"));
+	static const FName SpellPointsReward(TEXT("SpellPointsReward"));
+}
+
+void UProgressionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	BuildProgressionTables();
+}
+
+void UProgressionSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	// Remover binding do hot reload
+	if (ProgressionCurveTable && CurveTableChangedHandle.IsValid())
+	{
+		ProgressionCurveTable->OnCurveTableChanged().Remove(CurveTableChangedHandle);
+		CurveTableChangedHandle.Reset();
+	}
+#endif
+
+	ProgressionCurveTable = nullptr;
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(GroupXPFlushTimerHandle);
+	}
+	PendingGroupXP = 0;
+	RegisteredCharacters.Empty();
+
+	Super::Deinitialize();
+}
+
+// === CURVAS DE PROGRESSÃO ===
+
+void UProgressionSubsystem::SetProgressionCurveTable(UCurveTable* InCurveTable)
+{
+#if WITH_EDITOR
+	if (ProgressionCurveTable && CurveTableChangedHandle.IsValid())
+	{
+		ProgressionCurveTable->OnCurveTableChanged().Remove(CurveTableChangedHandle);
+		CurveTableChangedHandle.Reset();
+	}
+#endif
+
+	ProgressionCurveTable = InCurveTable;
+
+#if WITH_EDITOR
+	if (ProgressionCurveTable)
+	{
+		CurveTableChangedHandle = ProgressionCurveTable->OnCurveTableChanged().AddUObject(this, &UProgressionSubsystem::HandleProgressionCurveTableChanged);
+	}
+#endif
+
+	BuildProgressionTables();
+}
+
+#if WITH_EDITOR
+void UProgressionSubsystem::HandleProgressionCurveTableChanged()
+{
+	BuildProgressionTables();
+	UE_LOG(LogTemp, Log, TEXT("ProgressionSubsystem: Tabelas de progressão reconstruídas a partir de %s"), *GetNameSafe(ProgressionCurveTable));
+}
+#endif
+
+bool UProgressionSubsystem::EvaluateProgressionCurve(FName RowName, int32 Level, float& OutValue) const
+{
+	if (!ProgressionCurveTable)
+	{
+		return false;
+	}
+
+	static const FString ContextString(TEXT("ProgressionSubsystem"));
+	if (const FRealCurve* Curve = ProgressionCurveTable->FindCurve(RowName, ContextString, false))
+	{
+		OutValue = Curve->Eval(static_cast<float>(Level));
+		return true;
+	}
+
+	return false;
+}
+
+float UProgressionSubsystem::GetBaseXP() const
+{
+	float BaseXP = 0.0f;
+	if (EvaluateProgressionCurve(ProgressionCurveRows::BaseXP, 1, BaseXP))
+	{
+		return BaseXP;
+	}
+	return static_cast<float>(BASE_XP);
+}
 
 // === GETTERS ===
 
@@ -84,26 +183,16 @@ void UProgressionSubsystem::AddCharacterXP(ARPGCharacter* Character, int32 XPToA
 		FName CharacterID = Character->GetCharacterUniqueID();
 		if (FCharacterProgressionData* Data = ProgressionDataMap.Find(CharacterID))
 		{
-			int32 OldXP = Data->XP;
-			int32 OldLevel = Data->PlayerLevel;
-			
 			Data->XP += XPToAdd;
 			
-
-			
-			// Verificar se pode subir de nível
-			int32 LevelUps = 0;
-			while (CanLevelUp(Character))
+			// Resolver todos os level ups em um único passo
+			if (ResolveLevelUps(*Data) > 0)
 			{
-				LevelUpCharacter(Character);
-				LevelUps++;
+				OnCharacterLevelUp.Broadcast(Character, Data->PlayerLevel);
 			}
 			
 			// Disparar evento de mudança de XP DEPOIS do level up
-			int32 XPForNextLevel = CalculateXPForNextLevel(Character);
-			OnCharacterXPChanged.Broadcast(Character, Data->XP, XPForNextLevel);
-			
-
+			OnCharacterXPChanged.Broadcast(Character, Data->XP, CalculateXPForLevel(Data->PlayerLevel + 1));
 		}
 	}
 }
@@ -118,17 +207,14 @@ void UProgressionSubsystem::SetCharacterXP(ARPGCharacter* Character, int32 NewXP
 		{
 			Data->XP = FMath::Max(0, NewXP);
 			
-			// Verificar se pode subir de nível
-			int32 LevelUps = 0;
-			while (CanLevelUp(Character))
+			// Resolver todos os level ups em um único passo
+			if (ResolveLevelUps(*Data) > 0)
 			{
-				LevelUpCharacter(Character);
-				LevelUps++;
+				OnCharacterLevelUp.Broadcast(Character, Data->PlayerLevel);
 			}
 			
 			// Disparar evento de mudança de XP DEPOIS do level up
-			int32 XPForNextLevel = CalculateXPForNextLevel(Character);
-			OnCharacterXPChanged.Broadcast(Character, Data->XP, XPForNextLevel);
+			OnCharacterXPChanged.Broadcast(Character, Data->XP, CalculateXPForLevel(Data->PlayerLevel + 1));
 		}
 	}
 }
@@ -191,39 +277,131 @@ int32 UProgressionSubsystem::CalculateLevelFromXP(int32 XP) const
 {
 	if (XP <= 0) return 1;
 	
-	// Como agora temos multiplicadores variáveis, usamos uma abordagem iterativa
-	// para encontrar o nível correto
-	for (int32 Level = 1; Level <= 999; Level++)
+	if (!AreProgressionTablesBuilt())
 	{
-		int32 XPForThisLevel = CalculateXPForLevel(Level);
-		int32 XPForNextLevel = CalculateXPForLevel(Level + 1);
-		
-		// Se o XP está entre este nível e o próximo, encontramos o nível correto
-		if (XP >= XPForThisLevel && XP < XPForNextLevel)
+		// Fallback iterativo caso as tabelas ainda não existam
+		for (int32 Level = 1; Level < MAX_LEVEL; Level++)
 		{
-			return Level;
+			if (XP < EvaluateXPCurve(Level + 1))
+			{
+				return Level;
+			}
 		}
+		return MAX_LEVEL;
 	}
 	
-	// Se chegou até aqui, é nível máximo
-	return 999;
+	// OTIMIZAÇÃO: busca binária na tabela de XP acumulado (níveis 1..MAX_LEVEL).
+	// O número de limiares <= XP é exatamente o nível atingido.
+	const TArrayView<const int32> Thresholds(XPThresholdTable.GetData() + 1, MAX_LEVEL);
+	const int32 Level = Algo::UpperBound(Thresholds, XP);
+	
+	return FMath::Clamp(Level, 1, MAX_LEVEL);
 }
 
 int32 UProgressionSubsystem::CalculateXPForLevel(int32 Level) const
 {
 	if (Level <= 1) return 0;
 	
+	if (AreProgressionTablesBuilt())
+	{
+		return XPThresholdTable[FMath::Min(Level, MAX_LEVEL + 1)];
+	}
+	
+	return EvaluateXPCurve(Level);
+}
+
+int32 UProgressionSubsystem::EvaluateXPCurve(int32 Level) const
+{
+	if (Level <= 1) return 0;
+	
 	// Calcular multiplicador baseado no nível
 	float DynamicMultiplier = CalculateMultiplierForLevel(Level);
 	
 	// Fórmula exponencial com multiplicador dinâmico
-	double XPForLevel = BASE_XP * FMath::Pow(DynamicMultiplier, Level - 1);
+	double XPForLevel = GetBaseXP() * FMath::Pow(DynamicMultiplier, Level - 1);
+	
+	// Saturar para evitar overflow em níveis muito altos
+	if (XPForLevel >= static_cast<double>(MAX_int32))
+	{
+		return MAX_int32;
+	}
 	
 	return FMath::RoundToInt(XPForLevel);
 }
 
+void UProgressionSubsystem::BuildProgressionTables()
+{
+	const int32 TableSize = MAX_LEVEL + 2;
+	
+	// Montar em tabelas locais e trocar no final, para que uma reconstrução
+	// (ex: hot reload da CurveTable) nunca deixe as tabelas em estado parcial
+	TArray<int32> NewXPThresholds;
+	TArray<int32> NewAttributePoints;
+	TArray<int32> NewSpellPoints;
+	NewXPThresholds.SetNumUninitialized(TableSize);
+	NewAttributePoints.SetNumUninitialized(TableSize);
+	NewSpellPoints.SetNumUninitialized(TableSize);
+	
+	NewXPThresholds[0] = 0;
+	NewAttributePoints[0] = 0;
+	NewSpellPoints[0] = 0;
+	
+	for (int32 Level = 1; Level < TableSize; Level++)
+	{
+		// Garantir que a tabela seja monotônica para a busca binária
+		NewXPThresholds[Level] = FMath::Max(NewXPThresholds[Level - 1], EvaluateXPCurve(Level));
+		
+		// O nível 1 é o inicial e não concede recompensa
+		const int32 AttributeReward = Level > 1 ? GetAttributePointsReward(Level) : 0;
+		const int32 SpellReward = Level > 1 ? GetSpellPointsReward(Level) : 0;
+		NewAttributePoints[Level] = NewAttributePoints[Level - 1] + AttributeReward;
+		NewSpellPoints[Level] = NewSpellPoints[Level - 1] + SpellReward;
+	}
+	
+	XPThresholdTable = MoveTemp(NewXPThresholds);
+	CumulativeAttributePointsTable = MoveTemp(NewAttributePoints);
+	CumulativeSpellPointsTable = MoveTemp(NewSpellPoints);
+}
+
+int32 UProgressionSubsystem::ResolveLevelUps(FCharacterProgressionData& Data) const
+{
+	const int32 OldLevel = Data.PlayerLevel;
+	const int32 NewLevel = CalculateLevelFromXP(Data.XP);
+	
+	// Nunca reduz o nível (SetCharacterLevel pode ter colocado o personagem acima da curva)
+	if (NewLevel <= OldLevel)
+	{
+		return 0;
+	}
+	
+	Data.PlayerLevel = NewLevel;
+	
+	if (AreProgressionTablesBuilt())
+	{
+		const int32 FromLevel = FMath::Clamp(OldLevel, 1, MAX_LEVEL);
+		Data.AttributePoints += CumulativeAttributePointsTable[NewLevel] - CumulativeAttributePointsTable[FromLevel];
+		Data.SpellPoints += CumulativeSpellPointsTable[NewLevel] - CumulativeSpellPointsTable[FromLevel];
+	}
+	else
+	{
+		for (int32 Level = OldLevel + 1; Level <= NewLevel; Level++)
+		{
+			Data.AttributePoints += GetAttributePointsReward(Level);
+			Data.SpellPoints += GetSpellPointsReward(Level);
+		}
+	}
+	
+	return NewLevel - OldLevel;
+}
+
 float UProgressionSubsystem::CalculateMultiplierForLevel(int32 Level) const
 {
+	float CurveMultiplier = 0.0f;
+	if (EvaluateProgressionCurve(ProgressionCurveRows::XPMultiplier, Level, CurveMultiplier))
+	{
+		return CurveMultiplier;
+	}
+	
 	if (Level <= 10)
 	{
 		// Níveis 1-10: multiplicador 1.3 (fácil)
@@ -256,7 +434,7 @@ float UProgressionSubsystem::CalculateMultiplierForLevel(int32 Level) const
 
 int32 UProgressionSubsystem::CalculateXPForNextLevel(const ARPGCharacter* Character) const
 {
-	if (!Character) return BASE_XP;
+	if (!Character) return FMath::RoundToInt(GetBaseXP());
 	
 	int32 CurrentLevel = GetCharacterLevel(Character);
 	return CalculateXPForLevel(CurrentLevel + 1);
@@ -306,13 +484,25 @@ void UProgressionSubsystem::LevelUpCharacter(ARPGCharacter* Character)
 
 int32 UProgressionSubsystem::GetAttributePointsReward(int32 Level) const
 {
-	// Base de 1 ponto por nível, pode ser expandido com fórmulas mais complexas
+	float CurveReward = 0.0f;
+	if (EvaluateProgressionCurve(ProgressionCurveRows::AttributePointsReward, Level, CurveReward))
+	{
+		return FMath::RoundToInt(CurveReward);
+	}
+	
+	// Base de 1 ponto por nível quando não há curva configurada
 	return BASE_ATTRIBUTE_POINTS;
 }
 
 int32 UProgressionSubsystem::GetSpellPointsReward(int32 Level) const
 {
-	// Base de 1 ponto por nível, pode ser expandido com fórmulas mais complexas
+	float CurveReward = 0.0f;
+	if (EvaluateProgressionCurve(ProgressionCurveRows::SpellPointsReward, Level, CurveReward))
+	{
+		return FMath::RoundToInt(CurveReward);
+	}
+	
+	// Base de 1 ponto por nível quando não há curva configurada
 	return BASE_SPELL_POINTS;
 }
 
@@ -321,6 +511,14 @@ void UProgressionSubsystem::EnsureCharacterDataExists(ARPGCharacter* Character)
 	if (Character)
 	{
 		FName CharacterID = Character->GetCharacterUniqueID();
+		
+		// Manter referência ao personagem para o XP de grupo em lote
+		TWeakObjectPtr<ARPGCharacter>& RegisteredCharacter = RegisteredCharacters.FindOrAdd(CharacterID);
+		if (RegisteredCharacter.Get() != Character)
+		{
+			RegisteredCharacter = Character;
+		}
+		
 		if (!ProgressionDataMap.Contains(CharacterID))
 		{
 			ProgressionDataMap.Add(CharacterID, FCharacterProgressionData());
@@ -341,24 +539,10 @@ void UProgressionSubsystem::AddGroupXP(int32 XPToAdd)
 	for (auto& Pair : ProgressionDataMap)
 	{
 		FCharacterProgressionData& Data = Pair.Value;
-		int32 OldXP = Data.XP;
-		int32 OldLevel = Data.PlayerLevel;
-		
 		Data.XP += XPToAdd;
 		
-		// Verificar se pode subir de nível
-		while (Data.XP >= CalculateXPForLevel(Data.PlayerLevel + 1))
-		{
-			Data.PlayerLevel++;
-			
-			// Adicionar pontos de atributo
-			int32 AttributePointsReward = GetAttributePointsReward(Data.PlayerLevel);
-			Data.AttributePoints += AttributePointsReward;
-			
-			// Adicionar pontos de magia
-			int32 SpellPointsReward = GetSpellPointsReward(Data.PlayerLevel);
-			Data.SpellPoints += SpellPointsReward;
-		}
+		// Resolver todos os level ups em um único passo
+		ResolveLevelUps(Data);
 	}
 }
 
@@ -419,4 +603,57 @@ void UProgressionSubsystem::AddGroupXPViaGAS(int32 XPToAdd)
 			}
 		}
 	}
-} 
\ No newline at end of file
+} 
+
+void UProgressionSubsystem::AddGroupXPBatched(int32 XPToAdd)
+{
+	if (XPToAdd <= 0) return;
+	
+	// Acumular e agendar uma única aplicação para o próximo tick
+	PendingGroupXP = static_cast<int32>(FMath::Min<int64>(static_cast<int64>(PendingGroupXP) + XPToAdd, MAX_int32));
+	
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		FlushPendingGroupXP();
+		return;
+	}
+	
+	if (!World->GetTimerManager().TimerExists(GroupXPFlushTimerHandle))
+	{
+		GroupXPFlushTimerHandle = World->GetTimerManager().SetTimerForNextTick(this, &UProgressionSubsystem::FlushPendingGroupXP);
+	}
+}
+
+void UProgressionSubsystem::FlushPendingGroupXP()
+{
+	GroupXPFlushTimerHandle.Invalidate();
+	
+	const int32 XPToAdd = PendingGroupXP;
+	PendingGroupXP = 0;
+	
+	if (XPToAdd <= 0) return;
+	
+	for (auto It = RegisteredCharacters.CreateIterator(); It; ++It)
+	{
+		ARPGCharacter* Character = It.Value().Get();
+		if (!Character)
+		{
+			// Remover personagens que não existem mais
+			It.RemoveCurrent();
+			continue;
+		}
+		
+		FCharacterProgressionData* Data = ProgressionDataMap.Find(It.Key());
+		if (!Data) continue;
+		
+		Data->XP += XPToAdd;
+		
+		if (ResolveLevelUps(*Data) > 0)
+		{
+			OnCharacterLevelUp.Broadcast(Character, Data->PlayerLevel);
+		}
+		
+		OnCharacterXPChanged.Broadcast(Character, Data->XP, CalculateXPForLevel(Data->PlayerLevel + 1));
+	}
+}
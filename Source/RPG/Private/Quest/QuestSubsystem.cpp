@@ -151,12 +151,12 @@ bool UQuestSubsystem::CompleteQuest(const FString& QuestID, ARPGCharacter* Chara
         {
             if (QuestData.Rewards.bShareRewardsWithGroup)
             {
-                // Distribuir XP para todo o grupo via GAS
+                // Distribuir XP para todo o grupo pelo caminho nativo em lote
                 if (UGameInstance* GameInstance = GetWorld()->GetGameInstance())
                 {
                     if (UProgressionSubsystem* ProgressionSystem = GameInstance->GetSubsystem<UProgressionSubsystem>())
                     {
-                        ProgressionSystem->AddGroupXPViaGAS(QuestData.Rewards.Experience);
+                        ProgressionSystem->AddGroupXPBatched(QuestData.Rewards.Experience);
                     }
                 }
             }
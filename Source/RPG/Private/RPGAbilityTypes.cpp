@@ -1,8 +1,99 @@
 ﻿
 #include "RPGAbilityTypes.h"
+#include "Engine/NetSerialization.h"
+#include "RPGGameplayTags.h"
+
+namespace RPGEffectContextNet
+{
+	// Índice compacto dos tipos de dano conhecidos; o valor de escape envia a tag completa
+	constexpr uint32 DAMAGE_TYPE_INDEX_BITS = 3;
+	constexpr uint32 DAMAGE_TYPE_ESCAPE = (1u << DAMAGE_TYPE_INDEX_BITS) - 1;
+
+	static const TArray<FGameplayTag>& GetCompactDamageTypes()
+	{
+		// Ordem fixa: cliente e servidor precisam da mesma tabela
+		static const TArray<FGameplayTag> DamageTypes = []
+		{
+			const FRPGGameplayTags& GameplayTags = FRPGGameplayTags::Get();
+			TArray<FGameplayTag> Types = {
+				GameplayTags.Damage,
+				GameplayTags.Damage_Physical,
+				GameplayTags.Damage_Fire,
+				GameplayTags.Damage_Lightning,
+				GameplayTags.Damage_Arcane
+			};
+			check(Types.Num() < static_cast<int32>(DAMAGE_TYPE_ESCAPE));
+			return Types;
+		}();
+		return DamageTypes;
+	}
+
+	static void SerializeDamageType(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess, FGameplayTag& DamageType)
+	{
+		uint32 TypeIndex = DAMAGE_TYPE_ESCAPE;
+		if (Ar.IsSaving())
+		{
+			const int32 FoundIndex = GetCompactDamageTypes().IndexOfByKey(DamageType);
+			if (FoundIndex != INDEX_NONE)
+			{
+				TypeIndex = static_cast<uint32>(FoundIndex);
+			}
+		}
+
+		Ar.SerializeBits(&TypeIndex, DAMAGE_TYPE_INDEX_BITS);
+
+		if (TypeIndex == DAMAGE_TYPE_ESCAPE)
+		{
+			DamageType.NetSerialize(Ar, Map, bOutSuccess);
+		}
+		else if (Ar.IsLoading())
+		{
+			const TArray<FGameplayTag>& DamageTypes = GetCompactDamageTypes();
+			DamageType = DamageTypes.IsValidIndex(TypeIndex) ? DamageTypes[TypeIndex] : FGameplayTag();
+		}
+	}
+
+	// Impulsos: direção quantizada (16 bits por eixo) + magnitude inteira empacotada
+	static void SerializeImpulse(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess, FVector& Impulse)
+	{
+		FVector_NetQuantizeNormal Direction;
+		uint32 Magnitude = 0;
+		if (Ar.IsSaving())
+		{
+			double Length = 0.0;
+			FVector Normal = FVector::ZeroVector;
+			Impulse.ToDirectionAndLength(Normal, Length);
+			Direction = Normal;
+			Magnitude = static_cast<uint32>(FMath::Min(FMath::RoundToDouble(Length), static_cast<double>(MAX_uint32)));
+		}
+
+		Direction.NetSerialize(Ar, Map, bOutSuccess);
+		Ar.SerializeIntPacked(Magnitude);
+
+		if (Ar.IsLoading())
+		{
+			Impulse = Direction.GetSafeNormal() * static_cast<double>(Magnitude);
+		}
+	}
+
+	// Raios em cm inteiros, empacotados (7 bits por grupo)
+	static void SerializeRadius(FArchive& Ar, float& Radius)
+	{
+		uint32 PackedRadius = Ar.IsSaving() ? static_cast<uint32>(FMath::Max(0, FMath::RoundToInt(Radius))) : 0;
+		Ar.SerializeIntPacked(PackedRadius);
+		if (Ar.IsLoading())
+		{
+			Radius = static_cast<float>(PackedRadius);
+		}
+	}
+}
 
 bool FRPGGameplayEffectContext::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 {
+	// OTIMIZAÇÃO: flags booleanas viajam só no RepBits; vetores e raios quantizados;
+	// tipo de dano como índice compacto (NUM_REP_BITS precisa cobrir o bit mais alto usado)
+	constexpr uint32 NUM_REP_BITS = 20;
+
 	uint32 RepBits = 0;
 	if (Ar.IsSaving())
 	{
@@ -90,7 +181,7 @@ bool FRPGGameplayEffectContext::NetSerialize(FArchive& Ar, UPackageMap* Map, boo
 		
 	}
 
-	Ar.SerializeBits(&RepBits, 19);
+	Ar.SerializeBits(&RepBits, NUM_REP_BITS);
 
 	if (RepBits & (1 << 0))
 	{
@@ -132,17 +223,13 @@ bool FRPGGameplayEffectContext::NetSerialize(FArchive& Ar, UPackageMap* Map, boo
 	{
 		bHasWorldOrigin = false;
 	}
-	if (RepBits & (1 << 7))
-	{
-		Ar << bIsBlockedHit;
-	}
-	if (RepBits & (1 << 8))
-	{
-		Ar << bIsCriticalHit;
-	}
-	if (RepBits & (1 << 9))
+	if (Ar.IsLoading())
 	{
-		Ar << bIsSuccessfulDebuff;
+		// O próprio bit é o valor
+		bIsBlockedHit = (RepBits & (1 << 7)) != 0;
+		bIsCriticalHit = (RepBits & (1 << 8)) != 0;
+		bIsSuccessfulDebuff = (RepBits & (1 << 9)) != 0;
+		bIsRadialDamage = (RepBits & (1 << 16)) != 0;
 	}
 	if (RepBits & (1 << 10))
 	{
@@ -165,31 +252,31 @@ bool FRPGGameplayEffectContext::NetSerialize(FArchive& Ar, UPackageMap* Map, boo
 				DamageType = TSharedPtr<FGameplayTag>(new FGameplayTag());
 			}
 		}
-		DamageType->NetSerialize(Ar, Map, bOutSuccess);
+		RPGEffectContextNet::SerializeDamageType(Ar, Map, bOutSuccess, *DamageType);
 	}
 	if (RepBits & (1 << 14))
 	{
-		DeathImpulse.NetSerialize(Ar, Map, bOutSuccess);
+		RPGEffectContextNet::SerializeImpulse(Ar, Map, bOutSuccess, DeathImpulse);
 	}
 	if (RepBits & (1 << 15))
 	{
-		KnockbackForce.NetSerialize(Ar, Map, bOutSuccess);
+		RPGEffectContextNet::SerializeImpulse(Ar, Map, bOutSuccess, KnockbackForce);
 	}
 	if (RepBits & (1 << 16))
 	{
-		Ar << bIsRadialDamage;
-		
 		if (RepBits & (1 << 17))
 		{
-			Ar << RadialDamageInnerRadius;
+			RPGEffectContextNet::SerializeRadius(Ar, RadialDamageInnerRadius);
 		}
 		if (RepBits & (1 << 18))
 		{
-			Ar << RadialDamageOuterRadius;
+			RPGEffectContextNet::SerializeRadius(Ar, RadialDamageOuterRadius);
 		}
 		if (RepBits & (1 << 19))
 		{
-			RadialDamageOrigin.NetSerialize(Ar, Map, bOutSuccess);
+			FVector_NetQuantize10 QuantizedOrigin = RadialDamageOrigin;
+			QuantizedOrigin.NetSerialize(Ar, Map, bOutSuccess);
+			RadialDamageOrigin = QuantizedOrigin;
 		}
 	}
 	
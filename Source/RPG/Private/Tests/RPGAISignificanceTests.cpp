@@ -0,0 +1,233 @@
+// Copyright Druid Mechanics
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/RPGAutomationTestUtils.h"
+#include "AI/RPGAIController.h"
+#include "AI/RPGAISignificanceSubsystem.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Composites/BTComposite_Selector.h"
+#include "BrainComponent.h"
+#include "GameFramework/DefaultPawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+namespace RPGAISignificanceTests
+{
+	const int32 NUM_ENEMIES = 500;
+	const float ARENA_HALF_EXTENT = 10000.f;
+	const float TICK_DELTA = 1.f / 30.f;
+	const int32 NUM_FRAMES = 900;
+
+	// Jogadores se movem em saltos a cada STEP_FRAMES; a verificação acontece no fim do passo,
+	// depois de pelo menos uma avaliação do subsistema (a cada 0.5s = 15 frames)
+	const int32 STEP_FRAMES = 30;
+
+	// Limites das faixas do subsistema (High < 2000, Dormant > 8000) com a margem de histerese
+	const float NEAR_DISTANCE = 1500.f;
+	const float DORMANT_DISTANCE = 8000.f + 250.f;
+
+	// Um a cada ENGAGED_STRIDE inimigos tem TargetActor no blackboard: nunca pode ser pausado
+	const int32 ENGAGED_STRIDE = 10;
+
+	/** BT mínimo (seletor vazio) só para o BrainComponent ficar em execução, com a chave TargetActor */
+	UBehaviorTree* MakeIdleTree()
+	{
+		UBlackboardData* Blackboard = NewObject<UBlackboardData>(GetTransientPackage(), NAME_None, RF_Transient);
+		Blackboard->UpdatePersistentKey<UBlackboardKeyType_Object>(TEXT("TargetActor"));
+
+		UBehaviorTree* Tree = NewObject<UBehaviorTree>(GetTransientPackage(), NAME_None, RF_Transient);
+		Tree->BlackboardAsset = Blackboard;
+		Tree->RootNode = NewObject<UBTComposite_Selector>(Tree);
+		return Tree;
+	}
+
+	APawn* SpawnPlayer(UWorld* World, const FVector& Location)
+	{
+		APlayerController* PlayerController = World->SpawnActor<APlayerController>();
+		APawn* Pawn = World->SpawnActor<ADefaultPawn>(Location, FRotator::ZeroRotator);
+		PlayerController->Possess(Pawn);
+		return Pawn;
+	}
+
+	float DistanceToNearest(const FVector& Location, TArrayView<APawn* const> Players)
+	{
+		float Nearest = MAX_flt;
+		for (const APawn* Player : Players)
+		{
+			Nearest = FMath::Min(Nearest, static_cast<float>(FVector::Dist(Location, Player->GetActorLocation())));
+		}
+		return Nearest;
+	}
+
+	struct FSoakTiming
+	{
+		double AverageMs = 0.0;
+		double MaxMs = 0.0;
+	};
+
+	/**
+	 * Soak completo em um mundo próprio (mesma semente a cada chamada). Com bValidate, confere as
+	 * faixas e a pausa do BT a cada passo; sem, só mede (usado com rpg.AI.Significance desligado).
+	 */
+	FSoakTiming RunSoak(FAutomationTestBase& Test, bool bValidate)
+	{
+		const FRPGTestWorld TestWorld;
+		UWorld* World = TestWorld.World;
+		const URPGAISignificanceSubsystem* Significance = World->GetSubsystem<URPGAISignificanceSubsystem>();
+		if (!Test.TestNotNull(TEXT("Subsistema de relevância"), Significance)) return FSoakTiming();
+
+		UBehaviorTree* IdleTree = MakeIdleTree();
+		FRandomStream Random(42);
+
+		TArray<ARPGAIController*> Controllers;
+		Controllers.Reserve(NUM_ENEMIES);
+		for (int32 Index = 0; Index < NUM_ENEMIES; ++Index)
+		{
+			const FVector Location(Random.FRandRange(-ARENA_HALF_EXTENT, ARENA_HALF_EXTENT), Random.FRandRange(-ARENA_HALF_EXTENT, ARENA_HALF_EXTENT), 100.f);
+			const ARPGEnemy* Enemy = TestWorld.SpawnEnemy(Location, ARPGAIController::StaticClass());
+			if (ARPGAIController* Controller = Cast<ARPGAIController>(Enemy->GetController()))
+			{
+				Controller->RunBehaviorTree(IdleTree);
+				Controllers.Add(Controller);
+			}
+		}
+		Test.TestEqual(TEXT("Todos os inimigos possuídos por ARPGAIController"), Controllers.Num(), NUM_ENEMIES);
+
+		TArray<APawn*> Players;
+		Players.Add(SpawnPlayer(World, FVector(-ARENA_HALF_EXTENT, 0.f, 100.f)));
+
+		for (int32 Index = 0; Index < Controllers.Num(); Index += ENGAGED_STRIDE)
+		{
+			Controllers[Index]->GetBlackboardComponent()->SetValueAsObject(TEXT("TargetActor"), Players[0]);
+		}
+
+		double TotalFrameSeconds = 0.0;
+		double MaxFrameSeconds = 0.0;
+		int32 NumErrors = 0;
+
+		for (int32 Frame = 0; Frame < NUM_FRAMES && NumErrors < 20; ++Frame)
+		{
+			// Jogador atravessa a arena; na metade do soak entra um segundo jogador no canto oposto
+			if (Frame % STEP_FRAMES == 0)
+			{
+				const float Alpha = static_cast<float>(Frame) / NUM_FRAMES;
+				Players[0]->SetActorLocation(FVector(FMath::Lerp(-ARENA_HALF_EXTENT, ARENA_HALF_EXTENT, Alpha), 0.f, 100.f));
+				if (Frame == NUM_FRAMES / 2)
+				{
+					Players.Add(SpawnPlayer(World, FVector(0.f, ARENA_HALF_EXTENT, 100.f)));
+				}
+			}
+
+			const double FrameStart = FPlatformTime::Seconds();
+			World->Tick(LEVELTICK_All, TICK_DELTA);
+			const double FrameSeconds = FPlatformTime::Seconds() - FrameStart;
+			TotalFrameSeconds += FrameSeconds;
+			MaxFrameSeconds = FMath::Max(MaxFrameSeconds, FrameSeconds);
+
+			if (!bValidate) continue;
+
+			int32 BucketTotal = 0;
+			for (uint8 Bucket = 0; Bucket <= static_cast<uint8>(ERPGAISignificance::Dormant); ++Bucket)
+			{
+				BucketTotal += Significance->GetNumControllersInBucket(static_cast<ERPGAISignificance>(Bucket));
+			}
+			if (BucketTotal != Controllers.Num())
+			{
+				Test.AddError(FString::Printf(TEXT("Frame %d: %d controladores nas faixas, esperado %d"), Frame, BucketTotal, Controllers.Num()));
+				++NumErrors;
+			}
+
+			if (Frame % STEP_FRAMES != STEP_FRAMES - 1) continue;
+
+			for (int32 Index = 0; Index < Controllers.Num(); ++Index)
+			{
+				const ARPGAIController* Controller = Controllers[Index];
+				const ERPGAISignificance Current = Significance->GetSignificance(Controller);
+				const bool bPaused = Controller->GetBrainComponent()->IsPaused();
+
+				// Engajados em Dormant são apenas espaçados; os demais pausam exatamente em Dormant
+				const bool bEngaged = Index % ENGAGED_STRIDE == 0;
+				const bool bShouldPause = Current == ERPGAISignificance::Dormant && !bEngaged;
+				if (bPaused != bShouldPause)
+				{
+					Test.AddError(FString::Printf(TEXT("Frame %d: %s faixa %d, engajado=%d, BT pausado=%d"), Frame, *GetNameSafe(Controller), static_cast<int32>(Current), bEngaged, bPaused));
+					++NumErrors;
+				}
+
+				// Distância medida até o jogador mais próximo (fora da tela desce uma faixa)
+				const float Distance = DistanceToNearest(Controller->GetPawn()->GetActorLocation(), Players);
+				if (Distance < NEAR_DISTANCE && Current > ERPGAISignificance::Medium)
+				{
+					Test.AddError(FString::Printf(TEXT("Frame %d: %s a %.0f do jogador mais próximo está na faixa %d"), Frame, *GetNameSafe(Controller), Distance, static_cast<int32>(Current)));
+					++NumErrors;
+				}
+				if (Distance > DORMANT_DISTANCE && Current != ERPGAISignificance::Dormant)
+				{
+					Test.AddError(FString::Printf(TEXT("Frame %d: %s a %.0f de todos os jogadores não está Dormant"), Frame, *GetNameSafe(Controller), Distance));
+					++NumErrors;
+				}
+			}
+		}
+
+		if (bValidate)
+		{
+			Test.AddInfo(FString::Printf(TEXT("Faixas no fim: High %d, Medium %d, Low %d, Dormant %d"),
+				Significance->GetNumControllersInBucket(ERPGAISignificance::High), Significance->GetNumControllersInBucket(ERPGAISignificance::Medium),
+				Significance->GetNumControllersInBucket(ERPGAISignificance::Low), Significance->GetNumControllersInBucket(ERPGAISignificance::Dormant)));
+
+			// Desregistrar devolve a lógica pausada
+			for (ARPGAIController* Controller : Controllers)
+			{
+				UBrainComponent* Brain = Controller->GetBrainComponent();
+				Controller->UnPossess();
+				if (Brain->IsPaused())
+				{
+					Test.AddError(FString::Printf(TEXT("%s continua pausado após UnPossess"), *GetNameSafe(Controller)));
+					break;
+				}
+			}
+		}
+
+		FSoakTiming Timing;
+		Timing.AverageMs = TotalFrameSeconds * 1000.0 / NUM_FRAMES;
+		Timing.MaxMs = MaxFrameSeconds * 1000.0;
+		return Timing;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGAISignificanceSoakTest, "RPG.AI.Significance.Soak",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+bool FRPGAISignificanceSoakTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGAISignificanceTests;
+
+	IConsoleVariable* EnabledCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("rpg.AI.Significance"));
+	if (!TestNotNull(TEXT("CVar rpg.AI.Significance"), EnabledCVar)) return false;
+	const bool bWasEnabled = EnabledCVar->GetBool();
+
+	// Mesmo cenário duas vezes: sem LOD (todas as IAs na taxa original) e com o subsistema ligado
+	EnabledCVar->Set(false, ECVF_SetByCode);
+	const FSoakTiming Disabled = RunSoak(*this, false);
+
+	EnabledCVar->Set(true, ECVF_SetByCode);
+	const FSoakTiming Enabled = RunSoak(*this, true);
+
+	EnabledCVar->Set(bWasEnabled, ECVF_SetByCode);
+
+	AddInfo(FString::Printf(TEXT("%d inimigos, %d frames (tick do mundo no game thread)"), NUM_ENEMIES, NUM_FRAMES));
+	AddInfo(FString::Printf(TEXT("Sem relevância: %.3f ms/frame em média, pior %.3f ms"), Disabled.AverageMs, Disabled.MaxMs));
+	AddInfo(FString::Printf(TEXT("Com relevância: %.3f ms/frame em média, pior %.3f ms"), Enabled.AverageMs, Enabled.MaxMs));
+	AddInfo(FString::Printf(TEXT("Diferença: %.3f ms/frame (%.1f%%)"),
+		Disabled.AverageMs - Enabled.AverageMs, Disabled.AverageMs > 0.0 ? 100.0 * (Disabled.AverageMs - Enabled.AverageMs) / Disabled.AverageMs : 0.0));
+	return true;
+}
+
+#endif
@@ -0,0 +1,106 @@
+// Copyright Druid Mechanics
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/RPGAutomationTestUtils.h"
+#include "Tests/RPGTestNavigationData.h"
+#include "AI/RPGAIController.h"
+#include "AI/RPGAIStressHarnessSubsystem.h"
+#include "AI/RPGPartyAIController.h"
+#include "Character/RPGCharacter.h"
+#include "HAL/FileManager.h"
+#include "NavigationSystem.h"
+
+namespace RPGAIStressHarnessTests
+{
+	const int32 NUM_ENEMIES = 200;
+	const int32 NUM_PARTY = 4;
+	const int32 NUM_FRAMES = 120;
+	const float TICK_DELTA = 1.f / 30.f;
+
+	// Folga para a granularidade do relógio ao comparar somas de escopos com o tick do mundo
+	const double TIMER_TOLERANCE_MS = 0.05;
+
+	double CategoryTotal(TConstArrayView<URPGAIStressHarnessSubsystem::FFrameSample> Samples, ERPGAIStressCategory Category)
+	{
+		double Total = 0.0;
+		for (const URPGAIStressHarnessSubsystem::FFrameSample& Sample : Samples)
+		{
+			Total += Sample.CategoryMs[static_cast<int32>(Category)];
+		}
+		return Total;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGAIStressHarnessRunTest, "RPG.AI.Stress.HarnessRun",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRPGAIStressHarnessRunTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGAIStressHarnessTests;
+
+	const FRPGTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+	URPGAIStressHarnessSubsystem* Harness = World->GetSubsystem<URPGAIStressHarnessSubsystem>();
+	if (!TestNotNull(TEXT("Harness"), Harness)) return false;
+	if (!TestNotNull(TEXT("Sistema de navegação"), FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))) return false;
+
+	// Plano todo navegável: os pawns têm dados de navegação como num mapa com navmesh
+	World->SpawnActor<ARPGTestNavigationData>();
+
+	// Inimigos e party com os controllers do jogo (percepção, significância, BT)
+	URPGAIStressHarnessSubsystem::FStressSettings Settings;
+	Settings.NumEnemies = NUM_ENEMIES;
+	Settings.NumPartyMembers = NUM_PARTY;
+	Settings.NumFrames = NUM_FRAMES;
+	Settings.EnemyClass = ARPGEnemy::StaticClass();
+	Settings.EnemyControllerClass = ARPGAIController::StaticClass();
+	Settings.PartyClass = ARPGCharacter::StaticClass();
+	Settings.PartyControllerClass = ARPGPartyAIController::StaticClass();
+	if (!TestTrue(TEXT("Execução iniciada"), Harness->StartRun(Settings))) return false;
+	TestEqual(TEXT("Inimigos e party criados"), Harness->GetNumSpawnedPawns(), NUM_ENEMIES + NUM_PARTY);
+
+	// Frames extras: a última amostra só fecha no início do frame seguinte
+	for (int32 Frame = 0; Frame < NUM_FRAMES + 5 && Harness->IsRunning(); ++Frame)
+	{
+		World->Tick(LEVELTICK_All, TICK_DELTA);
+	}
+
+	TestFalse(TEXT("Execução encerrada após os frames pedidos"), Harness->IsRunning());
+	TestEqual(TEXT("Uma amostra por frame"), Harness->GetNumSamples(), NUM_FRAMES);
+	TestTrue(TEXT("CSV gravado"), !Harness->GetLastCsvPath().IsEmpty() && IFileManager::Get().FileExists(*Harness->GetLastCsvPath()));
+
+	// Colunas por categoria: tempo exclusivo dentro do tick do mundo
+	const TConstArrayView<URPGAIStressHarnessSubsystem::FFrameSample> Samples = Harness->GetSamples();
+	int32 NumFramesOverWorldTick = 0;
+	int32 NumFramesWithGameThreadTime = 0;
+	double WorldTickTotal = 0.0;
+	for (const URPGAIStressHarnessSubsystem::FFrameSample& Sample : Samples)
+	{
+		double CategorySum = 0.0;
+		for (const double CategoryMs : Sample.CategoryMs)
+		{
+			CategorySum += CategoryMs;
+		}
+		NumFramesOverWorldTick += CategorySum > Sample.WorldTickMs + TIMER_TOLERANCE_MS ? 1 : 0;
+		NumFramesWithGameThreadTime += Sample.GameThreadMs >= 0.0 ? 1 : 0;
+		WorldTickTotal += Sample.WorldTickMs;
+	}
+	TestEqual(TEXT("Categorias cabem no tick do mundo"), NumFramesOverWorldTick, 0);
+	TestEqual(TEXT("Sem tempo de game thread com UWorld::Tick manual"), NumFramesWithGameThreadTime, 0);
+
+	const double MovementMs = CategoryTotal(Samples, ERPGAIStressCategory::Movement);
+	const double PerceptionMs = CategoryTotal(Samples, ERPGAIStressCategory::Perception);
+	TestTrue(TEXT("Movimento medido"), MovementMs > 0.0);
+	TestTrue(TEXT("Percepção medida"), PerceptionMs > 0.0);
+
+	AddInfo(FString::Printf(TEXT("%d inimigos + %d party, %d frames (ms/frame): mundo %.3f, BT %.3f, percepção %.3f, movimento %.3f, GAS %.3f; CSV em %s"),
+		NUM_ENEMIES, NUM_PARTY, NUM_FRAMES, WorldTickTotal / NUM_FRAMES,
+		CategoryTotal(Samples, ERPGAIStressCategory::BehaviorTree) / NUM_FRAMES, PerceptionMs / NUM_FRAMES, MovementMs / NUM_FRAMES,
+		CategoryTotal(Samples, ERPGAIStressCategory::AbilitySystem) / NUM_FRAMES, *Harness->GetLastCsvPath()));
+	return true;
+}
+
+#endif
@@ -0,0 +1,76 @@
+// Copyright Druid Mechanics
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/RPGAutomationTestUtils.h"
+#include "AbilitySystem/Core/RPGAbilitySystemLibrary.h"
+#include "AbilitySystem/Data/EnemyClassInfo.h"
+#include "Game/RPGGameModeBase.h"
+
+namespace RPGAttributeBaselineTests
+{
+	const TCHAR* ENEMY_CLASS_INFO_PATH = TEXT("/Game/RPG/Blueprints/AbilitySystem/DATA/EnemyClassInfo.EnemyClassInfo");
+	const int32 LEVELS[] = { 1, 2, 5, 10, 20 };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGAttributeBaselineMatchesEffectsTest, "RPG.Attributes.BaselineMatchesEffects",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGAttributeBaselineMatchesEffectsTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGAttributeBaselineTests;
+
+	UEnemyClassInfo* ClassInfo = LoadObject<UEnemyClassInfo>(nullptr, ENEMY_CLASS_INFO_PATH);
+	if (!TestNotNull(TEXT("EnemyClassInfo carregado"), ClassInfo)) return false;
+
+	const FRPGTestWorld TestWorld;
+	ARPGGameModeBase* GameMode = TestWorld.World->SpawnActor<ARPGGameModeBase>();
+	if (!TestNotNull(TEXT("Game mode"), GameMode)) return false;
+	GameMode->EnemyClassInfo = ClassInfo;
+
+	for (const TPair<ECharacterClass, FCharacterClassDefaultInfo>& ClassEntry : ClassInfo->CharacterClassInformation)
+	{
+		const ECharacterClass CharacterClass = ClassEntry.Key;
+		if (!ClassInfo->CanBakeAttributeBaselines(CharacterClass))
+		{
+			AddInfo(FString::Printf(TEXT("Classe %d não usa baseline (GEs não instantâneos)"), static_cast<int32>(CharacterClass)));
+			continue;
+		}
+
+		for (const int32 Level : LEVELS)
+		{
+			// Referência: caminho por GEs, com o baseline desligado
+			UAbilitySystemComponent* ReferenceASC = TestWorld.SpawnAbilityActor();
+			{
+				TGuardValue<bool> DisableBaselines(ClassInfo->bBakeAttributeBaselines, false);
+				URPGAbilitySystemLibrary::InitializeDefaultAttributesForGameMode(GameMode, CharacterClass, Level, ReferenceASC);
+			}
+
+			// Primeiro spawn aplica os GEs e grava o baseline; o segundo usa o baseline
+			URPGAbilitySystemLibrary::InitializeDefaultAttributesForGameMode(GameMode, CharacterClass, Level, TestWorld.SpawnAbilityActor());
+			TestNotNull(FString::Printf(TEXT("Baseline gravado (classe %d, nível %d)"), static_cast<int32>(CharacterClass), Level),
+				GameMode->FindEnemyAttributeBaseline(CharacterClass, Level));
+
+			UAbilitySystemComponent* BaselineASC = TestWorld.SpawnAbilityActor();
+			URPGAbilitySystemLibrary::InitializeDefaultAttributesForGameMode(GameMode, CharacterClass, Level, BaselineASC);
+
+			TArray<FGameplayAttribute> Attributes;
+			ReferenceASC->GetAllAttributes(Attributes);
+			for (const FGameplayAttribute& Attribute : Attributes)
+			{
+				const float Expected = ReferenceASC->GetNumericAttribute(Attribute);
+				const float Actual = BaselineASC->GetNumericAttribute(Attribute);
+				if (!FMath::IsNearlyEqual(Expected, Actual))
+				{
+					AddError(FString::Printf(TEXT("%s diverge para classe %d nível %d: GE %f, baseline %f"),
+						*Attribute.GetName(), static_cast<int32>(CharacterClass), Level, Expected, Actual));
+				}
+			}
+		}
+	}
+	return true;
+}
+
+#endif
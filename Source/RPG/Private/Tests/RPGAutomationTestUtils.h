@@ -0,0 +1,64 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystem/Core/RPGAttributeSet.h"
+#include "Character/RPGEnemy.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+/**
+ * Mundo de jogo temporário para os automation tests do módulo (subsistemas de mundo inclusos).
+ * Criado e destruído no escopo do teste; não depende de mapa.
+ */
+struct FRPGTestWorld
+{
+	FRPGTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("RPGTestWorld"));
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+	}
+
+	~FRPGTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	FRPGTestWorld(const FRPGTestWorld&) = delete;
+	FRPGTestWorld& operator=(const FRPGTestWorld&) = delete;
+
+	/** Ator simples com ASC + URPGAttributeSet, usado como avatar de GAS nos testes */
+	UAbilitySystemComponent* SpawnAbilityActor(const FVector& Location = FVector::ZeroVector) const
+	{
+		AActor* Actor = World->SpawnActor<AActor>(Location, FRotator::ZeroRotator);
+		UAbilitySystemComponent* ASC = NewObject<UAbilitySystemComponent>(Actor);
+		ASC->RegisterComponent();
+		ASC->AddSpawnedAttribute(NewObject<URPGAttributeSet>(Actor));
+		ASC->InitAbilityActorInfo(Actor, Actor);
+		return ASC;
+	}
+
+	/** ARPGEnemy sem dados de classe; possuído por AIControllerClass se informado */
+	ARPGEnemy* SpawnEnemy(const FVector& Location, TSubclassOf<AController> AIControllerClass = nullptr) const
+	{
+		ARPGEnemy* Enemy = World->SpawnActorDeferred<ARPGEnemy>(ARPGEnemy::StaticClass(), FTransform(Location), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		Enemy->AIControllerClass = AIControllerClass;
+		Enemy->AutoPossessAI = AIControllerClass ? EAutoPossessAI::Spawned : EAutoPossessAI::Disabled;
+		Enemy->Tags.Add(TEXT("Enemy"));
+		Enemy->FinishSpawning(FTransform(Location));
+		return Enemy;
+	}
+
+	UWorld* World = nullptr;
+};
+
+#endif
@@ -0,0 +1,189 @@
+// Copyright Druid Mechanics
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/RPGAutomationTestUtils.h"
+#include "Character/RPGCombatantSpatialSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Interaction/CombatInterface.h"
+#include "Kismet/GameplayStatics.h"
+#include "Utils/RPGBlueprintLibrary.h"
+#include "Math/RandomStream.h"
+
+namespace RPGCombatantSpatialTests
+{
+	const int32 NUM_COMBATANTS = 500;
+	const float ARENA_HALF_EXTENT = 5000.f;
+	const float QUERY_RADIUS = 600.f;
+
+	TArray<ARPGEnemy*> SpawnCombatants(const FRPGTestWorld& TestWorld, FRandomStream& Random)
+	{
+		TArray<ARPGEnemy*> Enemies;
+		Enemies.Reserve(NUM_COMBATANTS);
+		for (int32 Index = 0; Index < NUM_COMBATANTS; ++Index)
+		{
+			const FVector Location(Random.FRandRange(-ARENA_HALF_EXTENT, ARENA_HALF_EXTENT), Random.FRandRange(-ARENA_HALF_EXTENT, ARENA_HALF_EXTENT), 100.f);
+			Enemies.Add(TestWorld.SpawnEnemy(Location));
+		}
+		return Enemies;
+	}
+
+	/** Caminho anterior ao hash: overlap de física + filtro de CombatInterface/vivo */
+	void OverlapLiveCombatants(UWorld* World, const FVector& Origin, float Radius, TArray<AActor*>& OutActors)
+	{
+		TArray<FOverlapResult> Overlaps;
+		World->OverlapMultiByObjectType(Overlaps, Origin, FQuat::Identity, FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects), FCollisionShape::MakeSphere(Radius), FCollisionQueryParams());
+		for (const FOverlapResult& Overlap : Overlaps)
+		{
+			AActor* Actor = Overlap.GetActor();
+			if (Actor && Actor->Implements<UCombatInterface>() && !ICombatInterface::Execute_IsDead(Actor))
+			{
+				OutActors.AddUnique(Actor);
+			}
+		}
+	}
+
+	/** Caminho anterior ao hash do FindClosestActorWithTag: varredura de todos os atores do mundo */
+	AActor* FindClosestWithTagByWorldScan(UWorld* World, const FVector& Origin, FName Tag, float Range)
+	{
+		TArray<AActor*> ActorsWithTag;
+		UGameplayStatics::GetAllActorsWithTag(World, Tag, ActorsWithTag);
+
+		AActor* Closest = nullptr;
+		float ClosestDistance = Range;
+		for (AActor* Actor : ActorsWithTag)
+		{
+			const float Distance = FVector::Dist(Origin, Actor->GetActorLocation());
+			if (Distance < ClosestDistance)
+			{
+				ClosestDistance = Distance;
+				Closest = Actor;
+			}
+		}
+		return Closest;
+	}
+
+	/** Distância da superfície da cápsula até Origin (negativa se dentro) */
+	float DistanceToCapsule(const ARPGEnemy* Enemy, const FVector& Origin)
+	{
+		const UCapsuleComponent* Capsule = Enemy->GetCapsuleComponent();
+		const float HalfSegment = FMath::Max(0.f, Capsule->GetScaledCapsuleHalfHeight() - Capsule->GetScaledCapsuleRadius());
+		const FVector Center = Capsule->GetComponentLocation();
+		const FVector Closest = FMath::ClosestPointOnSegment(Origin, Center - FVector(0.f, 0.f, HalfSegment), Center + FVector(0.f, 0.f, HalfSegment));
+		return FVector::Dist(Origin, Closest) - Capsule->GetScaledCapsuleRadius();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGCombatantSpatialMatchesOverlapTest, "RPG.Combat.Spatial.MatchesPhysicsOverlap",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGCombatantSpatialMatchesOverlapTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGCombatantSpatialTests;
+
+	const FRPGTestWorld TestWorld;
+	const URPGCombatantSpatialSubsystem* CombatantSpatial = URPGCombatantSpatialSubsystem::Get(TestWorld.World);
+	if (!TestNotNull(TEXT("Subsistema espacial"), CombatantSpatial)) return false;
+
+	FRandomStream Random(38);
+	const TArray<ARPGEnemy*> Enemies = SpawnCombatants(TestWorld, Random);
+	TestEqual(TEXT("Todos os combatentes registrados"), CombatantSpatial->GetNumCombatants(), NUM_COMBATANTS);
+
+	TArray<AActor*> HashActors;
+	TArray<AActor*> OverlapActors;
+	for (int32 QueryIndex = 0; QueryIndex < 100; ++QueryIndex)
+	{
+		const FVector Origin(Random.FRandRange(-ARENA_HALF_EXTENT, ARENA_HALF_EXTENT), Random.FRandRange(-ARENA_HALF_EXTENT, ARENA_HALF_EXTENT), 100.f);
+
+		HashActors.Reset();
+		OverlapActors.Reset();
+		CombatantSpatial->QueryRadius(Origin, QUERY_RADIUS, FRPGCombatantQueryFilter(), HashActors);
+		OverlapLiveCombatants(TestWorld.World, Origin, QUERY_RADIUS, OverlapActors);
+
+		// Mesmo conjunto, ignorando cápsulas rentes à borda (tolerância de contato da física)
+		for (const ARPGEnemy* Enemy : Enemies)
+		{
+			if (FMath::Abs(DistanceToCapsule(Enemy, Origin) - QUERY_RADIUS) < 1.f) continue;
+
+			const bool bInHash = HashActors.Contains(Enemy);
+			const bool bInOverlap = OverlapActors.Contains(Enemy);
+			if (bInHash != bInOverlap)
+			{
+				AddError(FString::Printf(TEXT("Consulta %d: %s hash=%d overlap=%d"), QueryIndex, *GetNameSafe(Enemy), bInHash, bInOverlap));
+			}
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGCombatantSpatialBenchmark, "RPG.Combat.Spatial.Benchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRPGCombatantSpatialBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace RPGCombatantSpatialTests;
+
+	const FRPGTestWorld TestWorld;
+	const URPGCombatantSpatialSubsystem* CombatantSpatial = URPGCombatantSpatialSubsystem::Get(TestWorld.World);
+	if (!TestNotNull(TEXT("Subsistema espacial"), CombatantSpatial)) return false;
+
+	FRandomStream Random(38);
+	SpawnCombatants(TestWorld, Random);
+
+	const int32 NUM_QUERIES = 2000;
+	TArray<FVector> Origins;
+	Origins.Reserve(NUM_QUERIES);
+	for (int32 Index = 0; Index < NUM_QUERIES; ++Index)
+	{
+		Origins.Add(FVector(Random.FRandRange(-ARENA_HALF_EXTENT, ARENA_HALF_EXTENT), Random.FRandRange(-ARENA_HALF_EXTENT, ARENA_HALF_EXTENT), 100.f));
+	}
+
+	TArray<AActor*> Results;
+	int32 Checksum = 0;
+
+	// Raio: overlap de física vs hash
+	double StartTime = FPlatformTime::Seconds();
+	for (const FVector& Origin : Origins)
+	{
+		Results.Reset();
+		OverlapLiveCombatants(TestWorld.World, Origin, QUERY_RADIUS, Results);
+		Checksum += Results.Num();
+	}
+	const double OverlapSeconds = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (const FVector& Origin : Origins)
+	{
+		Results.Reset();
+		CombatantSpatial->QueryRadius(Origin, QUERY_RADIUS, FRPGCombatantQueryFilter(), Results);
+		Checksum -= Results.Num();
+	}
+	const double HashRadiusSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// Mais próximo com tag: GetAllActorsWithTag vs hash
+	StartTime = FPlatformTime::Seconds();
+	for (const FVector& Origin : Origins)
+	{
+		Checksum += FindClosestWithTagByWorldScan(TestWorld.World, Origin, TEXT("Enemy"), QUERY_RADIUS) != nullptr;
+	}
+	const double WorldScanSeconds = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (const FVector& Origin : Origins)
+	{
+		Checksum += URPGBlueprintLibrary::FindClosestActorWithTag(TestWorld.World, Origin, TEXT("Enemy"), QUERY_RADIUS).Actor != nullptr;
+	}
+	const double HashClosestSeconds = FPlatformTime::Seconds() - StartTime;
+
+	const double ToMicroseconds = 1e6 / NUM_QUERIES;
+	AddInfo(FString::Printf(TEXT("%d combatentes, %d consultas de raio %.0f"), NUM_COMBATANTS, NUM_QUERIES, QUERY_RADIUS));
+	AddInfo(FString::Printf(TEXT("Raio: overlap %.2f us, hash %.2f us (%.1fx)"),
+		OverlapSeconds * ToMicroseconds, HashRadiusSeconds * ToMicroseconds, OverlapSeconds / FMath::Max(HashRadiusSeconds, UE_DOUBLE_SMALL_NUMBER)));
+	AddInfo(FString::Printf(TEXT("Mais próximo com tag: GetAllActorsWithTag %.2f us, hash %.2f us (%.1fx) [checksum %d]"),
+		WorldScanSeconds * ToMicroseconds, HashClosestSeconds * ToMicroseconds, WorldScanSeconds / FMath::Max(HashClosestSeconds, UE_DOUBLE_SMALL_NUMBER), Checksum));
+	return true;
+}
+
+#endif
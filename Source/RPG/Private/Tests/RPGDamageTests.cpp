@@ -0,0 +1,116 @@
+// Copyright Druid Mechanics
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/RPGAutomationTestUtils.h"
+#include "AbilitySystem/Calculations/ExecCalc_Damage.h"
+#include "GameplayEffect.h"
+#include "GameplayEffectExecutionCalculation.h"
+#include "RPGGameplayTags.h"
+
+namespace RPGDamageTests
+{
+	UGameplayEffect* MakeDamageEffect()
+	{
+		UGameplayEffect* DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), NAME_None, RF_Transient);
+		DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+		DamageEffect->Executions.AddDefaulted_GetRef().CalculationClass = UExecCalc_Damage::StaticClass();
+		return DamageEffect;
+	}
+
+	/** Executa o UExecCalc_Damage uma vez e devolve o IncomingDamage gerado */
+	float ExecuteDamage(const UGameplayEffect* DamageEffect, FGameplayEffectSpec& Spec, UAbilitySystemComponent* TargetASC)
+	{
+		const FGameplayEffectExecutionDefinition& Execution = DamageEffect->Executions[0];
+		FGameplayEffectCustomExecutionParameters Params(Spec, Execution.CalculationModifiers, TargetASC, Execution.PassedInTags, FPredictionKey());
+		FGameplayEffectCustomExecutionOutput Output;
+		GetDefault<UExecCalc_Damage>()->Execute_Implementation(Params, Output);
+
+		float Damage = 0.f;
+		for (const FGameplayModifierEvaluatedData& Modifier : Output.GetOutputModifiersRef())
+		{
+			Damage += Modifier.Magnitude;
+		}
+		return Damage;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGDamageTypePriorityTest, "RPG.Damage.ExecCalc.TypePriority",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGDamageTypePriorityTest::RunTest(const FString& Parameters)
+{
+	const FRPGTestWorld TestWorld;
+	UAbilitySystemComponent* SourceASC = TestWorld.SpawnAbilityActor();
+	UAbilitySystemComponent* TargetASC = TestWorld.SpawnAbilityActor(FVector(200.f, 0.f, 0.f));
+	TargetASC->SetNumericAttributeBase(URPGAttributeSet::GetArmorAttribute(), 50.f);
+	TargetASC->SetNumericAttributeBase(URPGAttributeSet::GetMagicResistanceAttribute(), 20.f);
+
+	const FRPGGameplayTags& Tags = FRPGGameplayTags::Get();
+	const UGameplayEffect* DamageEffect = RPGDamageTests::MakeDamageEffect();
+
+	// Mesmos tipos inseridos em ordens diferentes: o resultado não pode depender da ordem do TMap
+	FGameplayEffectSpec PhysicalFirst(DamageEffect, SourceASC->MakeEffectContext(), 1.f);
+	PhysicalFirst.SetSetByCallerMagnitude(Tags.Damage_Physical, 40.f);
+	PhysicalFirst.SetSetByCallerMagnitude(Tags.Damage_Fire, 100.f);
+	PhysicalFirst.CaptureAttributeDataFromTarget(TargetASC);
+
+	FGameplayEffectSpec FireFirst(DamageEffect, SourceASC->MakeEffectContext(), 1.f);
+	FireFirst.SetSetByCallerMagnitude(Tags.Damage_Fire, 100.f);
+	FireFirst.SetSetByCallerMagnitude(Tags.Damage_Physical, 40.f);
+	FireFirst.CaptureAttributeDataFromTarget(TargetASC);
+
+	const float PhysicalFirstDamage = RPGDamageTests::ExecuteDamage(DamageEffect, PhysicalFirst, TargetASC);
+	const float FireFirstDamage = RPGDamageTests::ExecuteDamage(DamageEffect, FireFirst, TargetASC);
+
+	TestEqual(TEXT("Ordem do SetByCaller não altera o dano"), PhysicalFirstDamage, FireFirstDamage);
+
+	// Physical vem antes na tabela: 40 de dano reduzido pelos 50% de Armor
+	TestEqual(TEXT("Tipo de maior prioridade (Physical) decide magnitude e resistência"), PhysicalFirstDamage, 20.f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGDamageExecCalcBenchmark, "RPG.Damage.ExecCalc.Benchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRPGDamageExecCalcBenchmark::RunTest(const FString& Parameters)
+{
+	const FRPGTestWorld TestWorld;
+	UAbilitySystemComponent* SourceASC = TestWorld.SpawnAbilityActor();
+	UAbilitySystemComponent* TargetASC = TestWorld.SpawnAbilityActor(FVector(200.f, 0.f, 0.f));
+	SourceASC->SetNumericAttributeBase(URPGAttributeSet::GetAttackAttribute(), 15.f);
+	TargetASC->SetNumericAttributeBase(URPGAttributeSet::GetMagicResistanceAttribute(), 25.f);
+
+	const FRPGGameplayTags& Tags = FRPGGameplayTags::Get();
+	const UGameplayEffect* DamageEffect = RPGDamageTests::MakeDamageEffect();
+
+	// Specs sintéticos cobrindo os tipos da tabela
+	const FGameplayTag DamageTypes[] = { Tags.Damage, Tags.Damage_Physical, Tags.Damage_Fire, Tags.Damage_Lightning, Tags.Damage_Arcane };
+	TArray<FGameplayEffectSpec> Specs;
+	Specs.Reserve(UE_ARRAY_COUNT(DamageTypes));
+	for (const FGameplayTag& DamageType : DamageTypes)
+	{
+		FGameplayEffectSpec& Spec = Specs.Emplace_GetRef(DamageEffect, SourceASC->MakeEffectContext(), 1.f);
+		Spec.SetSetByCallerMagnitude(DamageType, 50.f);
+		Spec.CaptureAttributeDataFromTarget(TargetASC);
+	}
+
+	const int32 NumExecutions = 100000;
+	double TotalDamage = 0.0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumExecutions; ++Index)
+	{
+		TotalDamage += RPGDamageTests::ExecuteDamage(DamageEffect, Specs[Index % Specs.Num()], TargetASC);
+	}
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	AddInfo(FString::Printf(TEXT("UExecCalc_Damage: %d execuções em %.2f ms (%.3f us/execução)"),
+		NumExecutions, ElapsedMs, ElapsedMs * 1000.0 / NumExecutions));
+
+	TestTrue(TEXT("Execuções geraram dano"), TotalDamage > 0.0);
+	return true;
+}
+
+#endif
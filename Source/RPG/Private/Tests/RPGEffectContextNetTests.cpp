@@ -0,0 +1,145 @@
+// Copyright Druid Mechanics
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RPGAbilityTypes.h"
+#include "RPGGameplayTags.h"
+#include "Engine/NetSerialization.h"
+#include "UObject/CoreNet.h"
+
+namespace RPGEffectContextNetTests
+{
+	struct FNamedContext
+	{
+		const TCHAR* Name;
+		FRPGGameplayEffectContext Context;
+	};
+
+	/** Contextos representativos do jogo (sem referências a UObjects: não há package map no teste) */
+	TArray<FNamedContext> MakeContexts()
+	{
+		const FRPGGameplayTags& Tags = FRPGGameplayTags::Get();
+		TArray<FNamedContext> Contexts;
+
+		// Golpe físico crítico com impulso de morte
+		FRPGGameplayEffectContext& Melee = Contexts.Add_GetRef({ TEXT("Melee"), FRPGGameplayEffectContext() }).Context;
+		Melee.SetIsCriticalHit(true);
+		Melee.SetDamageType(MakeShared<FGameplayTag>(Tags.Damage_Physical));
+		Melee.SetDeathImpulse(FVector(0.6f, 0.8f, 0.f) * 1200.f);
+
+		// Projétil de fogo com debuff de queimadura e knockback
+		FRPGGameplayEffectContext& Debuff = Contexts.Add_GetRef({ TEXT("FireBolt+Debuff"), FRPGGameplayEffectContext() }).Context;
+		Debuff.SetIsSuccessfulDebuff(true);
+		Debuff.SetDebuffDamage(5.f);
+		Debuff.SetDebuffDuration(5.f);
+		Debuff.SetDebuffFrequency(1.f);
+		Debuff.SetDamageType(MakeShared<FGameplayTag>(Tags.Damage_Fire));
+		Debuff.SetDeathImpulse(FVector(1.f, 0.f, 0.2f).GetSafeNormal() * 800.f);
+		Debuff.SetKnockbackForce(FVector(0.f, 1.f, 0.5f).GetSafeNormal() * 450.f);
+
+		// Explosão radial (Fire Blast)
+		FRPGGameplayEffectContext& Radial = Contexts.Add_GetRef({ TEXT("Radial"), FRPGGameplayEffectContext() }).Context;
+		Radial.SetIsBlockedHit(true);
+		Radial.SetDamageType(MakeShared<FGameplayTag>(Tags.Damage_Fire));
+		Radial.SetDeathImpulse(FVector(-0.3f, 0.9f, 0.1f).GetSafeNormal() * 600.f);
+		Radial.SetIsRadialDamage(true);
+		Radial.SetRadialDamageInnerRadius(50.f);
+		Radial.SetRadialDamageOuterRadius(300.f);
+		Radial.SetRadialDamageOrigin(FVector(12345.67f, -8901.23f, 152.5f));
+
+		return Contexts;
+	}
+
+	/** Formato anterior à quantização, reproduzido campo a campo (apenas escrita, para comparar tamanhos) */
+	int64 CountLegacyBits(FRPGGameplayEffectContext& Context)
+	{
+		FNetBitWriter Ar(nullptr, 0);
+		bool bOutSuccess = true;
+
+		uint32 RepBits = 0;
+		bool bBlocked = Context.IsBlockedHit();
+		bool bCritical = Context.IsCriticalHit();
+		bool bDebuff = Context.IsSuccessfulDebuff();
+		bool bRadial = Context.IsRadialDamage();
+		float DebuffDamage = Context.GetDebuffDamage();
+		float DebuffDuration = Context.GetDebuffDuration();
+		float DebuffFrequency = Context.GetDebuffFrequency();
+		float InnerRadius = Context.GetRadialDamageInnerRadius();
+		float OuterRadius = Context.GetRadialDamageOuterRadius();
+		FVector DeathImpulse = Context.GetDeathImpulse();
+		FVector KnockbackForce = Context.GetKnockbackForce();
+		FVector RadialOrigin = Context.GetRadialDamageOrigin();
+
+		Ar.SerializeBits(&RepBits, 19);
+		if (bBlocked) Ar << bBlocked;
+		if (bCritical) Ar << bCritical;
+		if (bDebuff) Ar << bDebuff;
+		if (DebuffDamage > 0.f) Ar << DebuffDamage;
+		if (DebuffDuration > 0.f) Ar << DebuffDuration;
+		if (DebuffFrequency > 0.f) Ar << DebuffFrequency;
+		if (Context.GetDamageType().IsValid()) Context.GetDamageType()->NetSerialize(Ar, nullptr, bOutSuccess);
+		if (!DeathImpulse.IsZero()) DeathImpulse.NetSerialize(Ar, nullptr, bOutSuccess);
+		if (!KnockbackForce.IsZero()) KnockbackForce.NetSerialize(Ar, nullptr, bOutSuccess);
+		if (bRadial)
+		{
+			Ar << bRadial;
+			if (InnerRadius > 0.f) Ar << InnerRadius;
+			if (OuterRadius > 0.f) Ar << OuterRadius;
+			if (!RadialOrigin.IsZero()) RadialOrigin.NetSerialize(Ar, nullptr, bOutSuccess);
+		}
+		return Ar.GetNumBits();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGEffectContextNetSerializeTest, "RPG.Net.EffectContext.Serialize",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGEffectContextNetSerializeTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGEffectContextNetTests;
+
+	for (FNamedContext& Named : MakeContexts())
+	{
+		FRPGGameplayEffectContext& Source = Named.Context;
+
+		FNetBitWriter Writer(nullptr, 0);
+		bool bOutSuccess = false;
+		Source.NetSerialize(Writer, nullptr, bOutSuccess);
+		TestTrue(FString::Printf(TEXT("%s: escrita"), Named.Name), bOutSuccess && !Writer.IsError());
+
+		FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+		FRPGGameplayEffectContext Received;
+		Received.NetSerialize(Reader, nullptr, bOutSuccess);
+		TestTrue(FString::Printf(TEXT("%s: leitura"), Named.Name), bOutSuccess && !Reader.IsError());
+		TestEqual(FString::Printf(TEXT("%s: todos os bits consumidos"), Named.Name), Reader.GetPosBits(), Writer.GetNumBits());
+
+		// Flags e tipo de dano exatos
+		TestEqual(FString::Printf(TEXT("%s: bloqueado"), Named.Name), Received.IsBlockedHit(), Source.IsBlockedHit());
+		TestEqual(FString::Printf(TEXT("%s: crítico"), Named.Name), Received.IsCriticalHit(), Source.IsCriticalHit());
+		TestEqual(FString::Printf(TEXT("%s: debuff"), Named.Name), Received.IsSuccessfulDebuff(), Source.IsSuccessfulDebuff());
+		TestEqual(FString::Printf(TEXT("%s: radial"), Named.Name), Received.IsRadialDamage(), Source.IsRadialDamage());
+		TestEqual(FString::Printf(TEXT("%s: debuff damage"), Named.Name), Received.GetDebuffDamage(), Source.GetDebuffDamage());
+		TestEqual(FString::Printf(TEXT("%s: debuff duration"), Named.Name), Received.GetDebuffDuration(), Source.GetDebuffDuration());
+		TestEqual(FString::Printf(TEXT("%s: debuff frequency"), Named.Name), Received.GetDebuffFrequency(), Source.GetDebuffFrequency());
+		if (Source.GetDamageType().IsValid())
+		{
+			TestTrue(FString::Printf(TEXT("%s: tipo de dano"), Named.Name), Received.GetDamageType().IsValid() && *Received.GetDamageType() == *Source.GetDamageType());
+		}
+
+		// Valores quantizados dentro da precisão escolhida
+		TestTrue(FString::Printf(TEXT("%s: death impulse"), Named.Name), Received.GetDeathImpulse().Equals(Source.GetDeathImpulse(), 1.f));
+		TestTrue(FString::Printf(TEXT("%s: knockback"), Named.Name), Received.GetKnockbackForce().Equals(Source.GetKnockbackForce(), 1.f));
+		TestEqual(FString::Printf(TEXT("%s: raio interno"), Named.Name), Received.GetRadialDamageInnerRadius(), FMath::RoundToFloat(Source.GetRadialDamageInnerRadius()));
+		TestEqual(FString::Printf(TEXT("%s: raio externo"), Named.Name), Received.GetRadialDamageOuterRadius(), FMath::RoundToFloat(Source.GetRadialDamageOuterRadius()));
+		TestTrue(FString::Printf(TEXT("%s: origem radial"), Named.Name), Received.GetRadialDamageOrigin().Equals(Source.GetRadialDamageOrigin(), 0.1f));
+
+		const int64 LegacyBits = CountLegacyBits(Source);
+		TestTrue(FString::Printf(TEXT("%s: menor que o formato anterior"), Named.Name), Writer.GetNumBits() < LegacyBits);
+		AddInfo(FString::Printf(TEXT("%s: %lld bits (formato anterior: %lld bits)"), Named.Name, Writer.GetNumBits(), LegacyBits));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,188 @@
+// Copyright Druid Mechanics
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/RPGAutomationTestUtils.h"
+#include "Tests/RPGTestNavigationData.h"
+#include "AI/RPGPathSharingSubsystem.h"
+#include "AIController.h"
+#include "AITypes.h"
+#include "HAL/IConsoleManager.h"
+#include "NavigationSystem.h"
+#include "Math/RandomStream.h"
+
+namespace RPGPathSharingTests
+{
+	const FVector GOAL(1000.f, 0.f, 0.f);
+	const FVector LEADER_START(-500.f, 0.f, 0.f);
+
+	/**
+	 * Parede principal entre o grupo e o objetivo (contornada por (0, 400)) e um obstáculo
+	 * que bloqueia a linha reta de quem parte de baixo até esse contorno.
+	 */
+	ARPGTestNavigationData* SpawnNavData(UWorld* World)
+	{
+		ARPGTestNavigationData* NavData = World->SpawnActor<ARPGTestNavigationData>();
+		NavData->Walls.Add({ FVector2D(0.f, -300.f), FVector2D(0.f, 300.f), FVector(0.f, 400.f, 0.f) });
+		NavData->Walls.Add({ FVector2D(-300.f, -200.f), FVector2D(-300.f, 0.f), FVector(-300.f, 100.f, 0.f) });
+		return NavData;
+	}
+
+	FNavPathSharedPtr FindPath(AAIController* Controller, const ARPGTestNavigationData& NavData, const FVector& Start, const FAIMoveRequest& MoveRequest)
+	{
+		FPathFindingQuery Query(Controller, NavData, Start, GOAL, NavData.GetDefaultQueryFilter());
+		Query.SetAllowPartialPaths(true);
+
+		FNavPathSharedPtr Path;
+		URPGPathSharingSubsystem::FindPathForMoveRequest(Controller, MoveRequest, Query, Path);
+		return Path;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGPathSharingCorridorTest, "RPG.AI.PathSharing.Corridor",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGPathSharingCorridorTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGPathSharingTests;
+
+	const FRPGTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+	if (!FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+	{
+		AddError(TEXT("Mundo de teste sem sistema de navegação"));
+		return false;
+	}
+
+	const ARPGTestNavigationData* NavData = SpawnNavData(World);
+	AAIController* Controller = World->SpawnActor<AAIController>();
+	AActor* GoalActor = World->SpawnActor<AActor>();
+
+	// Líder: consulta o navmesh e grava o corredor
+	const FNavPathSharedPtr LeaderPath = FindPath(Controller, *NavData, LEADER_START, FAIMoveRequest(GOAL));
+	if (!TestTrue(TEXT("Caminho do líder"), LeaderPath.IsValid())) return false;
+	TestEqual(TEXT("Uma consulta"), NavData->NumPathQueries, 1);
+
+	// Início próximo, com obstáculo até o segundo ponto do corredor: consulta própria
+	const FVector BlockedStart(-500.f, -350.f, 0.f);
+	const FNavPathSharedPtr BlockedPath = FindPath(Controller, *NavData, BlockedStart, FAIMoveRequest(GOAL));
+	TestTrue(TEXT("Caminho do agente bloqueado"), BlockedPath.IsValid());
+	TestEqual(TEXT("Início bloqueado faz a própria consulta"), NavData->NumPathQueries, 2);
+
+	// Destino fixo: corredor compartilhado, início do agente e destino deslocado
+	const FVector SharedStart(-450.f, 50.f, 0.f);
+	const FNavPathSharedPtr SharedPath = FindPath(Controller, *NavData, SharedStart, FAIMoveRequest(GOAL));
+	if (!TestTrue(TEXT("Caminho compartilhado"), SharedPath.IsValid())) return false;
+	TestEqual(TEXT("Sem nova consulta"), NavData->NumPathQueries, 2);
+	TestTrue(TEXT("Começa no agente"), SharedPath->GetPathPoints()[0].Location.Equals(SharedStart));
+	TestTrue(TEXT("Destino fixo deslocado"), FVector::Dist(SharedPath->GetPathPoints().Last().Location, GOAL) > 1.f);
+
+	// Cópia própria do caminho consultado: dados dos pontos preservados e repath até o destino deslocado
+	TestFalse(TEXT("Caminho próprio do agente"), SharedPath == LeaderPath);
+	TestEqual(TEXT("NodeRef do contorno preservado"), SharedPath->GetPathPoints()[1].NodeRef, LeaderPath->GetPathPoints()[1].NodeRef);
+	TestTrue(TEXT("Repath até o destino deslocado"), SharedPath->GetQueryData().EndLocation.Equals(SharedPath->GetPathPoints().Last().Location));
+	TestTrue(TEXT("Caminho do líder intacto"), LeaderPath->GetPathPoints()[0].Location.Equals(LEADER_START) && LeaderPath->GetPathPoints().Last().Location.Equals(GOAL));
+
+	// MoveTo até ator: corredor compartilhado, mas o ponto final é o do objetivo
+	const FVector ActorGoalStart(-450.f, -50.f, 0.f);
+	const FNavPathSharedPtr ActorPath = FindPath(Controller, *NavData, ActorGoalStart, FAIMoveRequest(GoalActor));
+	if (!TestTrue(TEXT("Caminho até ator"), ActorPath.IsValid())) return false;
+	TestEqual(TEXT("Sem nova consulta (ator)"), NavData->NumPathQueries, 2);
+	TestTrue(TEXT("Ator: sem deslocamento"), ActorPath->GetPathPoints().Last().Location.Equals(GOAL));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGPathSharingQueryBudgetTest, "RPG.AI.PathSharing.QueryBudget",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGPathSharingQueryBudgetTest::RunTest(const FString& Parameters)
+{
+	const FRPGTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+	URPGPathSharingSubsystem* PathSharing = World->GetSubsystem<URPGPathSharingSubsystem>();
+	if (!TestNotNull(TEXT("Subsistema de caminhos"), PathSharing)) return false;
+
+	IConsoleVariable* BudgetCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("rpg.AI.PathQueryBudget"));
+	if (!TestNotNull(TEXT("CVar rpg.AI.PathQueryBudget"), BudgetCVar)) return false;
+	const int32 PreviousBudget = BudgetCVar->GetInt();
+
+	const int32 BUDGET = 2;
+	const int32 NUM_FRAMES = 3;
+	const int32 NUM_REQUESTS = BUDGET * NUM_FRAMES;
+	BudgetCVar->Set(BUDGET, ECVF_SetByCode);
+
+	const ARPGTestNavigationData* NavData = World->SpawnActor<ARPGTestNavigationData>();
+
+	// Inícios e destinos distantes entre si: nenhum pedido aproveita o corredor de outro
+	int32 NumReady = 0;
+	int32 NumValidPaths = 0;
+	for (int32 Index = 0; Index < NUM_REQUESTS; ++Index)
+	{
+		const ARPGEnemy* Enemy = TestWorld.SpawnEnemy(FVector(0.f, Index * 1000.f, 0.f), AAIController::StaticClass());
+		AAIController* Controller = Enemy ? Cast<AAIController>(Enemy->GetController()) : nullptr;
+		if (!TestNotNull(TEXT("Inimigo possuído"), Controller)) break;
+
+		const uint32 RequestId = PathSharing->RequestPath(Controller, FVector(2000.f, Index * 1000.f, 0.f),
+			FOnSharedPathReady::CreateLambda([&NumReady, &NumValidPaths](uint32, FNavPathSharedPtr Path)
+			{
+				++NumReady;
+				NumValidPaths += Path.IsValid() ? 1 : 0;
+			}), NavData);
+		TestTrue(TEXT("Pedido enfileirado"), RequestId != 0);
+	}
+	TestEqual(TEXT("Pedidos pendentes"), PathSharing->GetNumPendingRequests(), NUM_REQUESTS);
+
+	// Cada frame consulta no máximo o orçamento; o restante espera na fila
+	for (int32 Frame = 1; Frame <= NUM_FRAMES; ++Frame)
+	{
+		const int32 QueriesBefore = NavData->NumPathQueries;
+		World->Tick(LEVELTICK_All, 1.f / 30.f);
+		TestTrue(TEXT("Consultas dentro do orçamento"), NavData->NumPathQueries - QueriesBefore <= BUDGET);
+		TestEqual(TEXT("Pendentes após o frame"), PathSharing->GetNumPendingRequests(), NUM_REQUESTS - Frame * BUDGET);
+		TestEqual(TEXT("Prontos após o frame"), NumReady, Frame * BUDGET);
+	}
+
+	BudgetCVar->Set(PreviousBudget, ECVF_SetByCode);
+
+	TestEqual(TEXT("Todos os pedidos com caminho"), NumValidPaths, NUM_REQUESTS);
+	TestEqual(TEXT("Uma consulta por pedido"), NavData->NumPathQueries, NUM_REQUESTS);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGPathSharingGroupBenchmark, "RPG.AI.PathSharing.GroupQueries",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRPGPathSharingGroupBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace RPGPathSharingTests;
+
+	const FRPGTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+	if (!FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+	{
+		AddError(TEXT("Mundo de teste sem sistema de navegação"));
+		return false;
+	}
+
+	const ARPGTestNavigationData* NavData = SpawnNavData(World);
+	AAIController* Controller = World->SpawnActor<AAIController>();
+
+	// Grupo de 50 agentes saindo juntos para o mesmo objetivo (linha reta livre até o contorno)
+	const int32 NUM_AGENTS = 50;
+	FRandomStream Random(50);
+	int32 NumPaths = 0;
+	for (int32 Index = 0; Index < NUM_AGENTS; ++Index)
+	{
+		const FVector Start = Index == 0 ? LEADER_START : FVector(Random.FRandRange(-600.f, -400.f), Random.FRandRange(0.f, 200.f), 0.f);
+		NumPaths += FindPath(Controller, *NavData, Start, FAIMoveRequest(GOAL)).IsValid() ? 1 : 0;
+	}
+
+	TestEqual(TEXT("Todos os agentes com caminho"), NumPaths, NUM_AGENTS);
+	TestEqual(TEXT("Uma consulta para o grupo"), NavData->NumPathQueries, 1);
+	AddInfo(FString::Printf(TEXT("%d pedidos de caminho, %d consultas ao navmesh"), NUM_AGENTS, NavData->NumPathQueries));
+	return true;
+}
+
+#endif
@@ -0,0 +1,66 @@
+// Copyright Druid Mechanics
+
+#include "Misc/AutomationTest.h"
+#include "Progression/ProgressionSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGProgressionXPLookupBenchmark, "RPG.Progression.XPLookupBenchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRPGProgressionXPLookupBenchmark::RunTest(const FString& Parameters)
+{
+	// Sem tabelas: fallback iterativo (mesmo custo por nível do cálculo antigo)
+	UProgressionSubsystem* Iterative = NewObject<UProgressionSubsystem>();
+
+	// Com tabelas: SetProgressionCurveTable(nullptr) monta as tabelas da curva padrão
+	UProgressionSubsystem* Tabled = NewObject<UProgressionSubsystem>();
+	Tabled->SetProgressionCurveTable(nullptr);
+
+	// Grants grandes: XP espalhado por toda a curva, incluindo saltos de vários níveis
+	FRandomStream Stream(1337);
+	TArray<int32> XPValues;
+	const int32 NumSamples = 2000;
+	XPValues.Reserve(NumSamples);
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		XPValues.Add(Stream.RandRange(0, MAX_int32 - 1));
+	}
+
+	// Equivalência antes de medir
+	for (const int32 XP : XPValues)
+	{
+		if (Iterative->CalculateLevelFromXP(XP) != Tabled->CalculateLevelFromXP(XP))
+		{
+			AddError(FString::Printf(TEXT("Nível divergente para XP %d: iterativo %d, tabela %d"), XP,
+				Iterative->CalculateLevelFromXP(XP), Tabled->CalculateLevelFromXP(XP)));
+			return false;
+		}
+	}
+
+	auto Measure = [&XPValues](const UProgressionSubsystem* Subsystem, int32 Iterations)
+	{
+		int64 Checksum = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const int32 XP : XPValues)
+			{
+				Checksum += Subsystem->CalculateLevelFromXP(XP);
+			}
+		}
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		return TPair<double, int64>(ElapsedMs / (Iterations * XPValues.Num()), Checksum);
+	};
+
+	const TPair<double, int64> IterativeResult = Measure(Iterative, 1);
+	const TPair<double, int64> TabledResult = Measure(Tabled, 100);
+
+	AddInfo(FString::Printf(TEXT("CalculateLevelFromXP: iterativo %.5f ms/chamada, tabela %.5f ms/chamada (%.0fx)"),
+		IterativeResult.Key, TabledResult.Key, TabledResult.Key > 0.0 ? IterativeResult.Key / TabledResult.Key : 0.0));
+
+	TestEqual(TEXT("Checksum por chamada"), IterativeResult.Value * 100, TabledResult.Value);
+	return true;
+}
+
+#endif
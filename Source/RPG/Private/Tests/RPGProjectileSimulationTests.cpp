@@ -0,0 +1,93 @@
+// Copyright Druid Mechanics
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/RPGAutomationTestUtils.h"
+#include "Actor/RPGProjectileSimulationSubsystem.h"
+
+namespace RPGProjectileSimulationTests
+{
+	const int32 NUM_PROJECTILES = 1000;
+	const int32 NUM_FRAMES = 120;
+	const float TICK_DELTA = 1.f / 30.f;
+
+	/** Anéis concêntricos em alturas diferentes, cada projétil apontando para fora */
+	TArray<FTransform> MakeRingTransforms()
+	{
+		const int32 PER_RING = 50;
+		TArray<FTransform> Transforms;
+		Transforms.Reserve(NUM_PROJECTILES);
+		for (int32 Index = 0; Index < NUM_PROJECTILES; ++Index)
+		{
+			const float Yaw = 360.f * (Index % PER_RING) / PER_RING;
+			const float Height = 100.f + 50.f * (Index / PER_RING);
+			const FRotator Rotation(0.f, Yaw, 0.f);
+			Transforms.Add(FTransform(Rotation, Rotation.Vector() * 100.f + FVector(0.f, 0.f, Height)));
+		}
+		return Transforms;
+	}
+
+	/** Média e pior frame (em segundos) de NumFrames ticks do mundo */
+	void TickFrames(UWorld* World, int32 NumFrames, double& OutAverage, double& OutMax)
+	{
+		double Total = 0.0;
+		OutMax = 0.0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const double FrameStart = FPlatformTime::Seconds();
+			World->Tick(LEVELTICK_All, TICK_DELTA);
+			const double FrameSeconds = FPlatformTime::Seconds() - FrameStart;
+			Total += FrameSeconds;
+			OutMax = FMath::Max(OutMax, FrameSeconds);
+		}
+		OutAverage = Total / NumFrames;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGProjectileSimulationBenchmark, "RPG.Combat.ProjectileSimulation.Benchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRPGProjectileSimulationBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace RPGProjectileSimulationTests;
+
+	const FRPGTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+	URPGProjectileSimulationSubsystem* Simulation = World->GetSubsystem<URPGProjectileSimulationSubsystem>();
+	if (!TestNotNull(TEXT("Subsistema de projéteis"), Simulation)) return false;
+
+	// Frames sem projéteis: custo base do tick do mundo de teste
+	double BaseAverage = 0.0;
+	double BaseMax = 0.0;
+	TickFrames(World, NUM_FRAMES, BaseAverage, BaseMax);
+
+	FDamageEffectParams DamageParams;
+	DamageParams.SourceAbilitySystemComponent = TestWorld.SpawnAbilityActor();
+
+	// Vida longa o bastante para todos continuarem vivos durante a medição (sem geometria para colidir)
+	FRPGSimulatedProjectileParams Params;
+	Params.LifeSpan = NUM_FRAMES * TICK_DELTA + 5.f;
+
+	const TArray<FTransform> Transforms = MakeRingTransforms();
+	TestEqual(TEXT("Rajada criada"), Simulation->SpawnSimulatedProjectiles(Transforms, Params, DamageParams), NUM_PROJECTILES);
+	TestEqual(TEXT("Projéteis vivos após o disparo"), Simulation->GetNumLiveProjectiles(), NUM_PROJECTILES);
+
+	double SimAverage = 0.0;
+	double SimMax = 0.0;
+	TickFrames(World, NUM_FRAMES, SimAverage, SimMax);
+	TestEqual(TEXT("Todos vivos durante a medição"), Simulation->GetNumLiveProjectiles(), NUM_PROJECTILES);
+
+	AddInfo(FString::Printf(TEXT("%d projéteis simulados, %d frames a %.0f FPS"), NUM_PROJECTILES, NUM_FRAMES, 1.f / TICK_DELTA));
+	AddInfo(FString::Printf(TEXT("Tick do mundo: base %.3f ms (pior %.3f), com projéteis %.3f ms (pior %.3f); custo da simulação %.3f ms/frame"),
+		BaseAverage * 1000.0, BaseMax * 1000.0, SimAverage * 1000.0, SimMax * 1000.0, (SimAverage - BaseAverage) * 1000.0));
+
+	// Ao fim da vida útil todos expiram
+	double Unused = 0.0;
+	TickFrames(World, FMath::CeilToInt(6.f / TICK_DELTA), Unused, Unused);
+	TestEqual(TEXT("Projéteis expirados"), Simulation->GetNumLiveProjectiles(), 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,80 @@
+// Copyright Druid Mechanics
+
+#include "Tests/RPGTestNavigationData.h"
+
+ARPGTestNavigationData::ARPGTestNavigationData(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		FindPathImplementation = FindPathTest;
+		FindHierarchicalPathImplementation = FindPathTest;
+		RaycastImplementation = RaycastTest;
+	}
+}
+
+bool ARPGTestNavigationData::ProjectPoint(const FVector& Point, FNavLocation& OutLocation, const FVector& Extent,
+	FSharedConstNavQueryFilter Filter, const UObject* Querier) const
+{
+	OutLocation = FNavLocation(Point);
+	return true;
+}
+
+const ARPGTestNavigationData::FWall* ARPGTestNavigationData::FindBlockingWall(const FVector& Start, const FVector& End, FVector& OutHitLocation) const
+{
+	const FWall* Closest = nullptr;
+	float ClosestDistanceSq = MAX_flt;
+	for (const FWall& Wall : Walls)
+	{
+		FVector Intersection;
+		if (FMath::SegmentIntersection2D(Start, End, FVector(Wall.A, Start.Z), FVector(Wall.B, Start.Z), Intersection))
+		{
+			const float DistanceSq = FVector::DistSquared2D(Start, Intersection);
+			if (DistanceSq < ClosestDistanceSq)
+			{
+				ClosestDistanceSq = DistanceSq;
+				Closest = &Wall;
+				OutHitLocation = Intersection;
+			}
+		}
+	}
+	return Closest;
+}
+
+FPathFindingResult ARPGTestNavigationData::FindPathTest(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query)
+{
+	const ARPGTestNavigationData* NavData = Cast<const ARPGTestNavigationData>(Query.NavData.Get());
+	if (!NavData) return FPathFindingResult(ENavigationQueryResult::Error);
+
+	++NavData->NumPathQueries;
+
+	TArray<FVector> Points = { Query.StartLocation };
+	FVector HitLocation;
+	if (const FWall* Wall = NavData->FindBlockingWall(Query.StartLocation, Query.EndLocation, HitLocation))
+	{
+		Points.Add(Wall->Detour);
+	}
+	Points.Add(Query.EndLocation);
+
+	FPathFindingResult Result(ENavigationQueryResult::Success);
+	Result.Path = MakeShared<FNavigationPath, ESPMode::ThreadSafe>(Points, nullptr);
+
+	// NodeRef sequencial (1, 2, ...): permite verificar que cópias do caminho preservam os dados dos pontos
+	TArray<FNavPathPoint>& PathPoints = Result.Path->GetPathPoints();
+	for (int32 Index = 0; Index < PathPoints.Num(); ++Index)
+	{
+		PathPoints[Index].NodeRef = Index + 1;
+	}
+	Result.Path->SetNavigationDataUsed(NavData);
+	Result.Path->SetQueryData(Query);
+	Result.Path->MarkReady();
+	return Result;
+}
+
+bool ARPGTestNavigationData::RaycastTest(const ANavigationData* NavDataInstance, const FVector& RayStart, const FVector& RayEnd, FVector& HitLocation,
+	FNavigationRaycastAdditionalResults* AdditionalResults, FSharedConstNavQueryFilter QueryFilter, const UObject* Querier)
+{
+	const ARPGTestNavigationData* NavData = Cast<const ARPGTestNavigationData>(NavDataInstance);
+	HitLocation = RayEnd;
+	return NavData && NavData->FindBlockingWall(RayStart, RayEnd, HitLocation) != nullptr;
+}
@@ -0,0 +1,45 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavigationData.h"
+#include "RPGTestNavigationData.generated.h"
+
+/**
+ * Dados de navegação determinísticos para os automation tests (não depende de navmesh gerado).
+ * O plano é todo navegável exceto por paredes 2D: Raycast para na primeira parede cruzada,
+ * FindPath contorna a primeira parede no caminho pelo ponto Detour dela (NodeRef dos pontos = índice + 1) e
+ * ProjectPoint devolve o próprio ponto.
+ */
+UCLASS(NotPlaceable, Transient, HideDropdown)
+class ARPGTestNavigationData : public ANavigationData
+{
+	GENERATED_BODY()
+
+public:
+	ARPGTestNavigationData(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	struct FWall
+	{
+		FVector2D A;
+		FVector2D B;
+		FVector Detour;
+	};
+
+	virtual bool ProjectPoint(const FVector& Point, FNavLocation& OutLocation, const FVector& Extent,
+		FSharedConstNavQueryFilter Filter = nullptr, const UObject* Querier = nullptr) const override;
+
+	/** Primeira parede cruzada pelo segmento Start-End (nula se livre) */
+	const FWall* FindBlockingWall(const FVector& Start, const FVector& End, FVector& OutHitLocation) const;
+
+	TArray<FWall> Walls;
+
+	// Consultas de caminho recebidas (FindPath)
+	mutable int32 NumPathQueries = 0;
+
+private:
+	static FPathFindingResult FindPathTest(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query);
+	static bool RaycastTest(const ANavigationData* NavDataInstance, const FVector& RayStart, const FVector& RayEnd, FVector& HitLocation,
+		FNavigationRaycastAdditionalResults* AdditionalResults, FSharedConstNavQueryFilter QueryFilter, const UObject* Querier);
+};
@@ -0,0 +1,275 @@
+// Copyright Druid Mechanics
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/RPGAutomationTestUtils.h"
+#include "AI/RPGThreatTable.h"
+#include "AI/RPGAIController.h"
+#include "Character/RPGCharacter.h"
+#include "Perception/AISense_Sight.h"
+
+namespace RPGThreatTableTests
+{
+	/** Valor esperado de uma ameaça somada em AddedAt e lida em Now */
+	float Decayed(float Amount, double AddedAt, double Now)
+	{
+		return static_cast<float>(Amount * FMath::Exp(-FRPGThreatTable::DECAY_RATE * (Now - AddedAt)));
+	}
+
+	TArray<AActor*> SpawnActors(const FRPGTestWorld& TestWorld, int32 Count)
+	{
+		TArray<AActor*> Actors;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Actors.Add(TestWorld.World->SpawnActor<AActor>());
+		}
+		return Actors;
+	}
+
+	/** Estímulo de visão de Target (visto ou perdido), entregue como o da percepção própria */
+	FAIStimulus SightStimulus(const AActor& Target, bool bSensed)
+	{
+		return FAIStimulus(*GetDefault<UAISense_Sight>(), 1.f, Target.GetActorLocation(), FVector::ZeroVector,
+			bSensed ? FAIStimulus::SensingSucceeded : FAIStimulus::SensingFailed);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGThreatTableDecayTest, "RPG.AI.Threat.Table.Decay",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGThreatTableDecayTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGThreatTableTests;
+
+	const FRPGTestWorld TestWorld;
+	const TArray<AActor*> Actors = SpawnActors(TestWorld, 2);
+	FRPGThreatTable Table;
+
+	TestTrue(TEXT("Primeira entrada vira o topo"), Table.AddThreat(Actors[0], 100.f, 0.0));
+	TestEqual(TEXT("Ameaça sem decaimento"), Table.GetThreat(Actors[0], 0.0), 100.f, 0.01f);
+	TestEqual(TEXT("Ameaça após 10s"), Table.GetThreat(Actors[0], 10.0), Decayed(100.f, 0.0, 10.0), 0.01f);
+
+	// Somas em tempos diferentes decaem cada uma a partir do próprio instante
+	Table.AddThreat(Actors[0], 50.f, 5.0);
+	TestEqual(TEXT("Ameaça acumulada"), Table.GetThreat(Actors[0], 12.0), Decayed(100.f, 0.0, 12.0) + Decayed(50.f, 5.0, 12.0), 0.01f);
+
+	// Entrada nova pequena, mas recente, supera a antiga decaída
+	TestTrue(TEXT("Recente supera a decaída"), Table.AddThreat(Actors[1], 30.f, 20.0));
+	TestTrue(TEXT("Topo é o ator recente"), Table.GetTopActor() == Actors[1]);
+
+	TestEqual(TEXT("Ator fora da tabela"), Table.GetThreat(nullptr, 20.0), 0.f);
+	TestFalse(TEXT("Quantidade não positiva ignorada"), Table.AddThreat(Actors[0], 0.f, 20.0) || Table.AddThreat(Actors[0], -10.f, 20.0));
+	TestFalse(TEXT("Ator nulo ignorado"), Table.AddThreat(nullptr, 10.f, 20.0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGThreatTableSwitchMarginTest, "RPG.AI.Threat.Table.SwitchMargin",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGThreatTableSwitchMarginTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGThreatTableTests;
+
+	const FRPGTestWorld TestWorld;
+	const TArray<AActor*> Actors = SpawnActors(TestWorld, 2);
+	FRPGThreatTable Table;
+
+	Table.AddThreat(Actors[0], 100.f, 0.0);
+
+	// Dentro da margem de 10%: o topo não troca
+	TestFalse(TEXT("105 não desbanca 100"), Table.AddThreat(Actors[1], 105.f, 0.0));
+	TestTrue(TEXT("Topo mantido"), Table.GetTopActor() == Actors[0]);
+
+	// Acima da margem: troca e reporta
+	TestTrue(TEXT("115 desbanca 100"), Table.AddThreat(Actors[1], 10.f, 0.0));
+	TestTrue(TEXT("Topo trocado"), Table.GetTopActor() == Actors[1]);
+
+	// O antigo topo precisa superar o novo com a mesma margem para voltar
+	TestFalse(TEXT("120 não desbanca 115"), Table.AddThreat(Actors[0], 20.f, 0.0));
+	TestTrue(TEXT("130 desbanca 115"), Table.AddThreat(Actors[0], 10.f, 0.0));
+	TestTrue(TEXT("Topo de volta"), Table.GetTopActor() == Actors[0]);
+
+	// Somar ao próprio topo nunca reporta troca
+	TestFalse(TEXT("Soma no topo"), Table.AddThreat(Actors[0], 500.f, 1.0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGThreatTableRemoveTest, "RPG.AI.Threat.Table.Remove",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGThreatTableRemoveTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGThreatTableTests;
+
+	const FRPGTestWorld TestWorld;
+	const TArray<AActor*> Actors = SpawnActors(TestWorld, 3);
+	FRPGThreatTable Table;
+
+	Table.AddThreat(Actors[0], 300.f, 0.0);
+	Table.AddThreat(Actors[1], 200.f, 0.0);
+	Table.AddThreat(Actors[2], 100.f, 0.0);
+
+	int32 NumActors = 0;
+	Table.ForEachActor([&NumActors](AActor*) { ++NumActors; });
+	TestEqual(TEXT("Três atores na tabela"), NumActors, 3);
+
+	TestFalse(TEXT("Remover fora do topo não troca"), Table.RemoveThreat(Actors[2]));
+	TestFalse(TEXT("Removido"), Table.Contains(Actors[2]));
+	TestFalse(TEXT("Remover ausente"), Table.RemoveThreat(Actors[2]));
+
+	// Sem o topo, o maior restante assume mesmo sem superar a margem
+	TestTrue(TEXT("Remover o topo troca"), Table.RemoveThreat(Actors[0]));
+	TestTrue(TEXT("Segundo maior assume"), Table.GetTopActor() == Actors[1]);
+
+	TestTrue(TEXT("Remover o último esvazia"), Table.RemoveThreat(Actors[1]));
+	TestTrue(TEXT("Tabela vazia"), Table.IsEmpty());
+	TestNull(TEXT("Sem topo"), Table.GetTopActor());
+
+	Table.AddThreat(Actors[0], 10.f, 0.0);
+	Table.Reset();
+	TestTrue(TEXT("Reset esvazia"), Table.IsEmpty() && !Table.GetTopActor());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGThreatTableUnseenTest, "RPG.AI.Threat.Table.Unseen",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGThreatTableUnseenTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGThreatTableTests;
+
+	const FRPGTestWorld TestWorld;
+	const TArray<AActor*> Actors = SpawnActors(TestWorld, 2);
+	FRPGThreatTable Table;
+
+	Table.AddThreat(Actors[0], 100.f, 0.0);
+	Table.AddThreat(Actors[1], 20.f, 0.0);
+
+	// Topo fora de vista: o maior visível assume sem a margem, e a ameaça do antigo topo continua decaindo
+	TestTrue(TEXT("Topo fora de vista troca"), Table.SetUnseen(Actors[0], true));
+	TestTrue(TEXT("Visível assume"), Table.GetTopActor() == Actors[1]);
+	TestTrue(TEXT("Entrada mantida"), Table.Contains(Actors[0]) && Table.IsUnseen(Actors[0]));
+	TestEqual(TEXT("Ameaça mantida"), Table.GetThreat(Actors[0], 2.0), Decayed(100.f, 0.0, 2.0), 0.01f);
+
+	// Somas numa entrada fora de vista não a colocam no topo
+	TestFalse(TEXT("Soma fora de vista não troca"), Table.AddThreat(Actors[0], 500.f, 2.0));
+	TestFalse(TEXT("Marcar de novo não muda nada"), Table.SetUnseen(Actors[0], true));
+
+	// De volta à vista: a ameaça acumulada disputa o topo com a margem
+	TestTrue(TEXT("Visto de novo retoma o topo"), Table.SetUnseen(Actors[0], false));
+	TestTrue(TEXT("Topo de volta"), Table.GetTopActor() == Actors[0]);
+
+	// Todos fora de vista: sem topo
+	Table.SetUnseen(Actors[0], true);
+	TestTrue(TEXT("Último visível fora de vista"), Table.SetUnseen(Actors[1], true));
+	TestNull(TEXT("Sem topo com todos fora de vista"), Table.GetTopActor());
+	TestFalse(TEXT("Ator fora da tabela"), Table.SetUnseen(nullptr, true));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGThreatTableDestroyedActorTest, "RPG.AI.Threat.Table.DestroyedActor",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGThreatTableDestroyedActorTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGThreatTableTests;
+
+	const FRPGTestWorld TestWorld;
+	const TArray<AActor*> Actors = SpawnActors(TestWorld, 3);
+	FRPGThreatTable Table;
+
+	Table.AddThreat(Actors[0], 300.f, 0.0);
+	Table.AddThreat(Actors[1], 100.f, 0.0);
+	Table.AddThreat(Actors[2], 50.f, 0.0);
+
+	// Topo destruído: a próxima soma reavalia o topo entre os válidos, sem exigir a margem
+	Actors[0]->Destroy();
+	TestNull(TEXT("Topo destruído some"), Table.GetTopActor());
+	TestTrue(TEXT("Soma reavalia o topo"), Table.AddThreat(Actors[2], 1.f, 1.0));
+	TestTrue(TEXT("Maior válido assume"), Table.GetTopActor() == Actors[1]);
+
+	// Remoção compacta as entradas inválidas
+	TestFalse(TEXT("Remover fora do topo"), Table.RemoveThreat(Actors[2]));
+	int32 NumActors = 0;
+	Table.ForEachActor([&NumActors](AActor*) { ++NumActors; });
+	TestEqual(TEXT("Só o ator válido restante"), NumActors, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGThreatTableLongFightTest, "RPG.AI.Threat.Table.LongFight",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGThreatTableLongFightTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGThreatTableTests;
+
+	const FRPGTestWorld TestWorld;
+	const TArray<AActor*> Actors = SpawnActors(TestWorld, 2);
+	FRPGThreatTable Table;
+
+	// Uma hora de luta com somas a cada segundo atravessa vários rebases; o valor lido
+	// deve continuar igual à soma analítica dos decaimentos (série geométrica)
+	const float AMOUNT = 10.f;
+	const double DURATION = 3600.0;
+
+	// Entrada antiga, sem somas depois do início: decai a ~0 sem estourar nos rebases
+	Table.AddThreat(Actors[1], 1000.f, 0.0);
+
+	for (double Now = 0.0; Now <= DURATION; Now += 1.0)
+	{
+		Table.AddThreat(Actors[0], AMOUNT, Now);
+	}
+
+	const double Ratio = FMath::Exp(-FRPGThreatTable::DECAY_RATE);
+	const float Expected = static_cast<float>(AMOUNT * (1.0 - FMath::Pow(Ratio, DURATION + 1.0)) / (1.0 - Ratio));
+	const float Actual = Table.GetThreat(Actors[0], DURATION);
+	TestTrue(TEXT("Ameaça finita"), FMath::IsFinite(Actual));
+	TestEqual(TEXT("Ameaça após uma hora"), Actual, Expected, Expected * 1e-4f);
+	TestTrue(TEXT("Entrada antiga finita"), FMath::IsFinite(Table.GetThreat(Actors[1], DURATION)));
+	TestTrue(TEXT("Ator ativo assume o topo"), Table.GetTopActor() == Actors[0]);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRPGThreatControllerSightLossTest, "RPG.AI.Threat.Controller.SightLoss",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRPGThreatControllerSightLossTest::RunTest(const FString& Parameters)
+{
+	using namespace RPGThreatTableTests;
+
+	const FRPGTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+	const ARPGEnemy* Enemy = TestWorld.SpawnEnemy(FVector::ZeroVector, ARPGAIController::StaticClass());
+	ARPGAIController* Controller = Cast<ARPGAIController>(Enemy->GetController());
+	if (!TestNotNull(TEXT("Controller do inimigo"), Controller)) return false;
+
+	// Time do inimigo no controller: o time do jogador é hostil
+	Controller->SetGenericTeamId(FGenericTeamId(static_cast<uint8>(ERPGTeam::Enemy)));
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	ARPGCharacter* AttackerA = World->SpawnActor<ARPGCharacter>(FVector(400.f, 0.f, 0.f), FRotator::ZeroRotator, SpawnParams);
+	ARPGCharacter* AttackerB = World->SpawnActor<ARPGCharacter>(FVector(0.f, 400.f, 0.f), FRotator::ZeroRotator, SpawnParams);
+	if (!TestTrue(TEXT("Atacantes criados"), AttackerA && AttackerB)) return false;
+
+	// A causa dano e vira o alvo; B só é avistado (ameaça bem menor)
+	Controller->AddDamageThreat(AttackerA, 100.f);
+	Controller->ReceiveSquadStimulus(AttackerB, SightStimulus(*AttackerB, true));
+	TestTrue(TEXT("Alvo é quem causou dano"), Controller->GetTargetCharacter() == AttackerA);
+
+	// A sai de vista por um instante: B assume, mas a ameaça de A continua na tabela
+	Controller->ReceiveSquadStimulus(AttackerA, SightStimulus(*AttackerA, false));
+	TestTrue(TEXT("Visível assume durante a perda de visão"), Controller->GetTargetCharacter() == AttackerB);
+	TestTrue(TEXT("A fora de vista, mas na tabela"), Controller->GetThreatTable().IsUnseen(AttackerA));
+	TestTrue(TEXT("Ameaça de A mantida"), Controller->GetThreatTable().GetThreat(AttackerA, World->GetTimeSeconds()) >= 100.f);
+
+	// A volta à vista: a ameaça acumulada devolve o alvo a A
+	Controller->ReceiveSquadStimulus(AttackerA, SightStimulus(*AttackerA, true));
+	TestTrue(TEXT("Alvo volta a A"), Controller->GetTargetCharacter() == AttackerA);
+	TestFalse(TEXT("A visível de novo"), Controller->GetThreatTable().IsUnseen(AttackerA));
+	return true;
+}
+
+#endif
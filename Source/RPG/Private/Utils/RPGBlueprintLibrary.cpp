@@ -7,6 +7,7 @@
 #include "Character/RPGCharacterBase.h"
 #include "Character/RPGEnemy.h"
 #include "Character/RPGCharacter.h"
+#include "Character/RPGCombatantSpatialSubsystem.h"
 #include "AbilitySystem/Core/RPGAttributeSet.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
@@ -65,6 +66,31 @@ FClosestActorWithTagResult URPGBlueprintLibrary::FindClosestActorWithTag(UObject
 		return Result;
 	}
 
+	// OTIMIZAÇÃO: candidatos vivos dentro do alcance vêm do hash espacial (sem varrer o mundo inteiro)
+	if (const URPGCombatantSpatialSubsystem* CombatantSpatial = URPGCombatantSpatialSubsystem::Get(World))
+	{
+		FRPGCombatantQueryFilter Filter;
+		Filter.bInflateByBounds = false;
+
+		TArray<AActor*> Candidates;
+		CombatantSpatial->QueryRadius(Origin, SearchRange, Filter, Candidates);
+		for (AActor* Actor : Candidates)
+		{
+			if (!Actor->ActorHasTag(Tag)) continue;
+
+			const float Distance = FVector::Dist(Origin, Actor->GetActorLocation());
+			if (Distance < ClosestDistance)
+			{
+				ClosestDistance = Distance;
+				ClosestActor = Actor;
+			}
+		}
+
+		Result.Actor = ClosestActor;
+		Result.Distance = ClosestDistance;
+		return Result;
+	}
+
 	TArray<AActor*> ActorsWithTag;
 	UGameplayStatics::GetAllActorsWithTag(World, Tag, ActorsWithTag);
 
@@ -91,12 +117,12 @@ FClosestActorWithTagResult URPGBlueprintLibrary::FindClosestActorWithTag(UObject
 	return Result;
 }
 
-void URPGBlueprintLibrary::SendDamageEventToPlayer(AActor* Target, const TSubclassOf<UGameplayEffect>& DamageEffect,
-	FGameplayEventData& Payload, const FGameplayTag& DataTag, float Damage, const FGameplayTag& EventTagOverride, UObject* OptionalParticleSystem)
+UAbilitySystemComponent* URPGBlueprintLibrary::SendDamageEventOnly(AActor* Target, FGameplayEventData& Payload, float Damage,
+	const FGameplayTag& EventTagOverride, UObject* OptionalParticleSystem)
 {
 	ARPGCharacterBase* PlayerCharacter = Cast<ARPGCharacterBase>(Target);
-	if (!IsValid(PlayerCharacter)) return;
-	if (PlayerCharacter->IsDead_Implementation()) return;
+	if (!IsValid(PlayerCharacter)) return nullptr;
+	if (PlayerCharacter->IsDead_Implementation()) return nullptr;
 
 	FGameplayTag EventTag;
 	if (!EventTagOverride.MatchesTagExact(FGameplayTag::EmptyTag))
@@ -106,7 +132,7 @@ void URPGBlueprintLibrary::SendDamageEventToPlayer(AActor* Target, const TSubcla
 	else
 	{
 		URPGAttributeSet* AttributeSet = PlayerCharacter->GetAttributeSet();
-		if (!IsValid(AttributeSet)) return;
+		if (!IsValid(AttributeSet)) return nullptr;
 
 		const float CurrentHealth = AttributeSet->GetHealth();
 		const bool bLethal = CurrentHealth - Damage <= 0.f;
@@ -119,7 +145,14 @@ void URPGBlueprintLibrary::SendDamageEventToPlayer(AActor* Target, const TSubcla
 	UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(PlayerCharacter, EventTag, Payload);
 
 	UAbilitySystemComponent* TargetASC = PlayerCharacter->GetAbilitySystemComponent();
-	if (!IsValid(TargetASC)) return;
+	return IsValid(TargetASC) ? TargetASC : nullptr;
+}
+
+void URPGBlueprintLibrary::SendDamageEventToPlayer(AActor* Target, const TSubclassOf<UGameplayEffect>& DamageEffect,
+	FGameplayEventData& Payload, const FGameplayTag& DataTag, float Damage, const FGameplayTag& EventTagOverride, UObject* OptionalParticleSystem)
+{
+	UAbilitySystemComponent* TargetASC = SendDamageEventOnly(Target, Payload, Damage, EventTagOverride, OptionalParticleSystem);
+	if (!TargetASC) return;
 
 	FGameplayEffectContextHandle ContextHandle = TargetASC->MakeEffectContext();
 	FGameplayEffectSpecHandle SpecHandle = TargetASC->MakeOutgoingSpec(DamageEffect, 1.f, ContextHandle);
@@ -133,9 +166,33 @@ void URPGBlueprintLibrary::SendDamageEventToPlayers(TArray<AActor*> Targets,
 	const TSubclassOf<UGameplayEffect>& DamageEffect, FGameplayEventData& Payload, const FGameplayTag& DataTag,
 	float Damage, const FGameplayTag& EventTagOverride, UObject* OptionalParticleSystem)
 {
+	TArray<UAbilitySystemComponent*, TInlineAllocator<16>> TargetASCs;
 	for (AActor* Target : Targets)
 	{
-		SendDamageEventToPlayer(Target, DamageEffect, Payload, DataTag, Damage, EventTagOverride, OptionalParticleSystem);
+		if (UAbilitySystemComponent* TargetASC = SendDamageEventOnly(Target, Payload, Damage, EventTagOverride, OptionalParticleSystem))
+		{
+			TargetASCs.AddUnique(TargetASC);
+		}
+	}
+	if (TargetASCs.Num() == 0) return;
+
+	// Cada alvo aplica o dano em si mesmo: um spec por ASC, pois as capturas de Source são do próprio alvo
+	TArray<FGameplayEffectSpecHandle, TInlineAllocator<16>> SpecHandles;
+	SpecHandles.Reserve(TargetASCs.Num());
+	for (UAbilitySystemComponent* TargetASC : TargetASCs)
+	{
+		FGameplayEffectSpecHandle SpecHandle = TargetASC->MakeOutgoingSpec(DamageEffect, 1.f, TargetASC->MakeEffectContext());
+		UAbilitySystemBlueprintLibrary::AssignTagSetByCallerMagnitude(SpecHandle, DataTag, -Damage);
+		SpecHandles.Add(SpecHandle);
+	}
+
+	// OTIMIZAÇÃO: aplicação em uma única passada, depois de todos os eventos e specs prontos
+	for (int32 Index = 0; Index < TargetASCs.Num(); ++Index)
+	{
+		if (SpecHandles[Index].IsValid())
+		{
+			TargetASCs[Index]->ApplyGameplayEffectSpecToSelf(*SpecHandles[Index].Data.Get());
+		}
 	}
 }
 
@@ -157,6 +214,22 @@ TArray<AActor*> URPGBlueprintLibrary::HitBoxOverlapTest(AActor* AvatarActor, flo
 	const FVector Forward = AvatarActor->GetActorForwardVector() * HitBoxForwardOffset;
 	const FVector HitBoxLocation = AvatarActor->GetActorLocation() + Forward + FVector(0.f, 0.f, HitBoxElevationOffset);
 
+	// OTIMIZAÇÃO: esfera contra as cápsulas do hash espacial, sem overlap de física
+	if (const URPGCombatantSpatialSubsystem* CombatantSpatial = URPGCombatantSpatialSubsystem::Get(AvatarActor))
+	{
+		FRPGCombatantQueryFilter Filter;
+		Filter.IgnoredActor = AvatarActor;
+
+		TArray<AActor*> ActorsHit;
+		CombatantSpatial->QueryRadius(HitBoxLocation, HitBoxRadius, Filter, ActorsHit);
+
+		if (bDrawDebugs)
+		{
+			DrawHitBoxActorDebugs(AvatarActor, ActorsHit, HitBoxLocation, HitBoxRadius);
+		}
+		return ActorsHit;
+	}
+
 	UWorld* World = GEngine->GetWorldFromContextObject(AvatarActor, EGetWorldErrorMode::LogAndReturnNull);
 	if (!IsValid(World)) return TArray<AActor*>();
 	World->OverlapMultiByChannel(OverlapResults, HitBoxLocation, FQuat::Identity, ECC_Visibility, Sphere, QueryParams, ResponseParams);
@@ -196,6 +269,24 @@ void URPGBlueprintLibrary::DrawHitBoxOverlapDebugs(const UObject* WorldContextOb
 	}
 }
 
+void URPGBlueprintLibrary::DrawHitBoxActorDebugs(const UObject* WorldContextObject, const TArray<AActor*>& HitActors, const FVector& HitBoxLocation, float HitBoxRadius)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!IsValid(World)) return;
+
+	DrawDebugSphere(World, HitBoxLocation, HitBoxRadius, 16, FColor::Red, false, 3.f);
+
+	for (const AActor* HitActor : HitActors)
+	{
+		if (IsValid(HitActor))
+		{
+			FVector DebugLocation = HitActor->GetActorLocation();
+			DebugLocation.Z += 100.f;
+			DrawDebugSphere(World, DebugLocation, 30.f, 10, FColor::Green, false, 3.f);
+		}
+	}
+}
+
 TArray<AActor*> URPGBlueprintLibrary::ApplyKnockback(AActor* AvatarActor, const TArray<AActor*>& HitActors, float InnerRadius,
 	float OuterRadius, float LaunchForceMagnitude, float RotationAngle, bool bDrawDebugs)
 {
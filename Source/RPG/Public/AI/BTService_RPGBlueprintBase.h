@@ -0,0 +1,21 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Services/BTService_BlueprintBase.h"
+#include "BTService_RPGBlueprintBase.generated.h"
+
+/**
+ * Base para serviços Blueprint das árvores de IA.
+ * O intervalo configurado no nó é multiplicado pela faixa de relevância da IA
+ * (URPGAISignificanceSubsystem::GetServiceIntervalScale): em High o serviço roda na taxa original.
+ */
+UCLASS(Abstract, Blueprintable)
+class RPG_API UBTService_RPGBlueprintBase : public UBTService_BlueprintBase
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void ScheduleNextTick(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+};
@@ -7,7 +7,9 @@
 #include "BTService_UpdateDistance.generated.h"
 
 /**
- * 
+ * Registra o par (controlador, alvo) no URPGAIDistanceSubsystem enquanto o nó está ativo.
+ * O cálculo e a escrita no blackboard acontecem em lote no subsistema, no Interval/RandomDeviation
+ * deste nó escalado pela relevância da IA (debug: rpg.AI.DebugDistance).
  */
 UCLASS()
 class RPG_API UBTService_UpdateDistance : public UBTService
@@ -17,8 +19,11 @@ class RPG_API UBTService_UpdateDistance : public UBTService
 public:
 	UBTService_UpdateDistance();
 
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+
 protected:
-	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 
 	UPROPERTY(EditAnywhere, Category = "Blackboard")
 	FBlackboardKeySelector TargetActorSelector;
@@ -26,7 +31,11 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Blackboard")
 	FBlackboardKeySelector DistanceToTargetSelector;
 
-private:
-	float DebugTimer = 0.f;
-	
-}; 
\ No newline at end of file
+	/** Opcional: direção normalizada até o alvo */
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	FBlackboardKeySelector DirectionToTargetSelector;
+
+	/** Opcional: velocidade do pawn na direção do alvo (positivo = aproximando) */
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	FBlackboardKeySelector ClosingSpeedSelector;
+};
@@ -8,7 +8,8 @@
 /**
  * BT Task que simula input por GameplayTag no Ability System (Pressed/Held/Released).
  * - Pressiona no ExecuteTask
- * - Opcionalmente espera HoldTime e solta no Tick
+ * - Opcionalmente espera HoldTime e solta (timer)
+ * - Avança quando a habilidade termina/é cancelada (callbacks do ASC), sem tick por frame
  */
 UCLASS()
 class RPG_API UBTTask_PressInputTag : public UBTTaskNode
@@ -51,22 +52,46 @@ public:
     float ComboDetectionDelay = 0.15f;
 
 protected:
-    struct FTaskMemory
-    {
-        float Elapsed = 0.f;        // tempo acumulado do estado atual
-        bool bPressedSent = false;  // se o Press deste clique já foi enviado
-        int32 ClicksDone = 0;       // quantos cliques já foram concluídos
-        bool bWaitingForCombo = false; // se está esperando evento de combo
-        enum class EState : uint8 { Holding, Releasing, Gap, WaitingForCombo } State = EState::Holding;
-    };
+    enum class EPressState : uint8 { Holding, Releasing, WaitingForCombo, Gap };
 
     virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
-    virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
-    virtual uint16 GetInstanceMemorySize() const override { return sizeof(FTaskMemory); }
+    virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
     virtual FString GetStaticDescription() const override;
 
 private:
     class UAbilitySystemComponent* ResolveASC(const UBehaviorTreeComponent& OwnerComp) const;
-};
 
+    // === TRANSIÇÕES (timers e callbacks do ASC, sem TickTask) ===
+    void PressClick();
+    void HandleHoldElapsed();
+    void HandleComboCheck();
+    void HandleReleaseTimeout();
+    void HandleGapElapsed();
+    void EnterGap();
+    void Finish(EBTNodeResult::Type Result);
+
+    void HandleAbilityActivated(class UGameplayAbility* Ability);
+    void HandleAbilityEnded(const struct FAbilityEndedData& EndedData);
+    bool IsInputTagAbility(const struct FGameplayAbilitySpecHandle& SpecHandle) const;
+
+    /** Agenda Callback após Delay (Delay <= 0 = próximo frame, como no antigo tick) */
+    void ScheduleStep(FTimerHandle& Handle, float Delay, void (UBTTask_PressInputTag::*Callback)(), bool bLoop = false);
+    void ClearTimersAndDelegates();
+
+    // Estado da execução atual (nó instanciado por IA)
+    TWeakObjectPtr<UBehaviorTreeComponent> OwnerCompPtr;
+    TWeakObjectPtr<class URPGAbilitySystemComponent> ASCPtr;
+    EPressState State = EPressState::Holding;
+    int32 ClicksDone = 0;
 
+    FTimerHandle StepTimerHandle;
+    FTimerHandle ReleaseTimeoutHandle;
+    FDelegateHandle AbilityActivatedHandle;
+    FDelegateHandle AbilityEndedHandle;
+
+    // Intervalo entre reenvios de input enquanto o combo continua
+    const float COMBO_RETRY_INTERVAL = 0.15f;
+
+    // Tempo máximo esperando a habilidade terminar após o Release
+    const float RELEASE_TIMEOUT = 1.0f;
+};
@@ -0,0 +1,54 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "AITypes.h"
+#include "NavigationData.h"
+#include "BTTask_SharedMoveTo.generated.h"
+
+class AAIController;
+struct FPathFollowingResult;
+
+/**
+ * MoveTo com pathfinding fatiado e compartilhado (URPGPathSharingSubsystem).
+ * O pedido de caminho entra na fila do subsistema, que resolve no máximo rpg.AI.PathQueryBudget
+ * consultas por frame e reaproveita corredores de agentes com destinos próximos. Com o caminho
+ * pronto, o movimento segue pelo PathFollowingComponent; o fim chega por callback, sem TickTask.
+ * Substitui o MoveTo padrão onde um grupo inteiro se move ao mesmo tempo (aggro de um encontro, party).
+ */
+UCLASS()
+class RPG_API UBTTask_SharedMoveTo : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_SharedMoveTo();
+
+	/** Distância ao destino considerada como chegada */
+	UPROPERTY(EditAnywhere, Category = "Node", meta = (ClampMin = "0.0"))
+	float AcceptableRadius = 50.f;
+
+protected:
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+	virtual FString GetStaticDescription() const override;
+
+private:
+	bool ResolveGoal(const UBehaviorTreeComponent& OwnerComp, AActor*& OutGoalActor, FVector& OutGoalLocation) const;
+
+	void HandlePathReady(uint32 RequestId, FNavPathSharedPtr Path);
+	void HandleMoveFinished(FAIRequestID RequestID, const FPathFollowingResult& Result);
+	void Finish(EBTNodeResult::Type Result);
+	void ClearRequests(bool bAbortMove);
+
+	// Estado da execução atual (nó instanciado por IA)
+	TWeakObjectPtr<UBehaviorTreeComponent> OwnerCompPtr;
+	TWeakObjectPtr<AAIController> ControllerPtr;
+	TWeakObjectPtr<AActor> GoalActor;
+	uint32 PathRequestId = 0;
+	FAIRequestID MoveRequestId;
+	FDelegateHandle MoveFinishedHandle;
+};
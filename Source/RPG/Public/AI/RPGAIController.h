@@ -7,6 +7,8 @@
 #include "Perception/AISense_Sight.h"
 #include "Engine/Engine.h"
 #include "Interaction/CombatInterface.h"
+#include "AI/RPGBlackboardKeys.h"
+#include "AI/RPGThreatTable.h"
 #include "RPGAIController.generated.h"
 
 class UBehaviorTreeComponent;
@@ -30,8 +32,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AI")
 	void UpdateTargetLocation(const FVector& NewLocation);
 
+	/** IDs das chaves do blackboard atual (re-resolvidos só quando o asset muda) */
+	const FRPGBlackboardKeys& GetBlackboardKeys();
+
+	/** Estímulo de visão/audição vindo do URPGSquadPerceptionSubsystem (mesmo tratamento da percepção própria) */
+	void ReceiveSquadStimulus(AActor* Actor, const FAIStimulus& Stimulus);
+
+	/** Soma ameaça de Source (cura, proximidade); o alvo só muda quando o topo da tabela muda */
+	void AddThreat(AActor* Source, float Amount);
+
+	/** Ameaça de dano sofrido; sem alvos na tabela, ignora atacantes além de MAX_DAMAGE_RESPONSE_DISTANCE */
+	void AddDamageThreat(AActor* Instigator, float Amount);
+
+	ARPGCharacterBase* GetTargetCharacter() const { return TargetCharacter; }
+	const FRPGThreatTable& GetThreatTable() const { return ThreatTable; }
+
 protected:
 	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+	virtual void FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const override;
+
+	/** Callback da percepção própria: o líder de squad compartilha a audição antes de tratar */
+	UFUNCTION()
+	void HandlePerceptionUpdated(AActor* Actor, FAIStimulus Stimulus);
 
 	UFUNCTION()
 	void OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus);
@@ -41,6 +64,10 @@ protected:
 
 	void SetTarget(ARPGCharacterBase* NewTarget);
 	void ClearTarget();
+
+	void RemoveThreat(AActor* Source);
+	void RetargetToTopThreat();
+	bool IsValidThreatSource(const ARPGCharacterBase* Candidate) const;
 	
 	UPROPERTY()
 	TObjectPtr<ARPGCharacterBase> TargetCharacter;
@@ -50,4 +77,17 @@ protected:
 
 	UPROPERTY(VisibleAnywhere)
 	TObjectPtr<UAIPerceptionComponent> AIPerceptionComponent;
+
+private:
+	FRPGBlackboardKeyCache BlackboardKeyCache;
+
+	// === AMEAÇA ===
+	FRPGThreatTable ThreatTable;
+
+	// Ameaça ao avistar um alvo, escalada pela proximidade dentro do raio de visão
+	const float SIGHT_THREAT = 10.f;
+	const float SIGHT_THREAT_RADIUS = 1000.f;
+
+	// Igual ao raio de visão para consistência
+	const float MAX_DAMAGE_RESPONSE_DISTANCE = 1000.f;
 }; 
\ No newline at end of file
@@ -0,0 +1,84 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "RPGAIDistanceSubsystem.generated.h"
+
+class AAIController;
+
+// Chaves de blackboard já resolvidas (IDs) para um par (controlador, alvo)
+struct FRPGAIDistanceKeys
+{
+	FBlackboard::FKey TargetActorKey = FBlackboard::InvalidKey;
+	FBlackboard::FKey LastKnownLocationKey = FBlackboard::InvalidKey;
+	FBlackboard::FKey DistanceKey = FBlackboard::InvalidKey;
+	FBlackboard::FKey DirectionToTargetKey = FBlackboard::InvalidKey;
+	FBlackboard::FKey ClosingSpeedKey = FBlackboard::InvalidKey;
+};
+
+/**
+ * Serviço centralizado de distância até o alvo para todos os controladores de IA.
+ * Cada par (controlador, alvo) registrado pelo UBTService_UpdateDistance é atualizado no
+ * Interval/RandomDeviation do próprio nó, escalado pela faixa de relevância da IA
+ * (URPGAISignificanceSubsystem). Os pares que vencem no mesmo frame são processados em uma
+ * passada contígua (distância, direção e velocidade de aproximação) e gravados de volta no
+ * blackboard pelos IDs das chaves.
+ */
+UCLASS()
+class RPG_API URPGAIDistanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Interval/RandomDeviation: agenda do nó que registra, como no UBTService::ScheduleNextTick */
+	void RegisterController(UBlackboardComponent* Blackboard, AAIController* Controller, const FRPGAIDistanceKeys& Keys, const UObject* Owner, float Interval, float RandomDeviation);
+	void UnregisterController(const UBlackboardComponent* Blackboard, const UObject* Owner);
+
+	UFUNCTION(BlueprintPure, Category = "AI|Distance")
+	int32 GetNumRegisteredControllers() const { return Entries.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FDistanceEntry
+	{
+		TWeakObjectPtr<UBlackboardComponent> Blackboard;
+		TWeakObjectPtr<AAIController> Controller;
+		TWeakObjectPtr<const UObject> Owner;
+		FRPGAIDistanceKeys Keys;
+
+		float Interval = 0.5f;
+		float RandomDeviation = 0.f;
+
+		// Tempo até a próxima atualização (0 = no próximo tick)
+		float TimeUntilUpdate = 0.f;
+	};
+
+	// Estado de um frame, em arrays contíguos (um índice por entrada que venceu neste frame)
+	void GatherPairs(float DeltaTime);
+	void ComputeResults();
+	void WriteResults();
+
+#if !UE_BUILD_SHIPPING
+	void DrawDebugMessages() const;
+#endif
+
+	TArray<FDistanceEntry> Entries;
+
+	TArray<int32> FrameEntryIndices;
+	TArray<FVector> FramePawnLocations;
+	TArray<FVector> FramePawnVelocities;
+	TArray<FVector> FrameTargetLocations;
+	TArray<bool> FrameHasTargetActor;
+	TArray<float> FrameDistances;
+	TArray<FVector> FrameDirections;
+	TArray<float> FrameClosingSpeeds;
+};
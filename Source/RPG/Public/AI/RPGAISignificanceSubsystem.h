@@ -0,0 +1,108 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "AI/RPGBlackboardKeys.h"
+#include "RPGAISignificanceSubsystem.generated.h"
+
+class AAIController;
+class UBehaviorTreeComponent;
+
+// Faixas de relevância das IAs em relação ao jogador mais próximo
+UENUM(BlueprintType)
+enum class ERPGAISignificance : uint8
+{
+	High,
+	Medium,
+	Low,
+	Dormant
+};
+
+/**
+ * Gerenciador de relevância (LOD) das IAs.
+ * Agrupa os pawns de IA por distância (até o pawn de jogador mais próximo) e visibilidade e,
+ * por faixa, ajusta o intervalo de tick da percepção e do CharacterMovement e o
+ * VisibilityBasedAnimTickOption da mesh. IAs em High rodam na taxa original.
+ *
+ * BehaviorTree: a escala de intervalo da faixa (GetIntervalScale) chega ao UBTService_UpdateDistance
+ * (via URPGAIDistanceSubsystem) e aos serviços Blueprint derivados de UBTService_RPGBlueprintBase;
+ * tasks, decorators e serviços da engine seguem a taxa do próprio BT. Em Dormant a lógica é pausada
+ * (PauseLogic/ResumeLogic), exceto em IAs engajadas (TargetActor no blackboard) ou registradas sem
+ * pausa (party seguindo o líder): essas são apenas espaçadas e mantêm visão/audição.
+ * Desligável por rpg.AI.Significance (todas voltam a High).
+ */
+UCLASS()
+class RPG_API URPGAISignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** bAllowPause = false: em Dormant a IA só é espaçada, nunca pausada (ex.: party seguindo o líder) */
+	void RegisterController(AAIController* Controller, bool bAllowPause = true);
+	void UnregisterController(AAIController* Controller);
+
+	UFUNCTION(BlueprintPure, Category = "AI|Significance")
+	ERPGAISignificance GetSignificance(const AAIController* Controller) const;
+
+	UFUNCTION(BlueprintPure, Category = "AI|Significance")
+	int32 GetNumControllersInBucket(ERPGAISignificance Significance) const;
+
+	/** Multiplicador do intervalo dos serviços do BT de OwnerComp (1 em High ou sem registro) */
+	static float GetServiceIntervalScale(const UBehaviorTreeComponent& OwnerComp);
+
+	/** Multiplicador de intervalo da faixa atual de Controller (1 em High ou sem registro) */
+	float GetIntervalScale(const AAIController* Controller) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FTrackedController
+	{
+		TWeakObjectPtr<AAIController> Controller;
+		TWeakObjectPtr<APawn> Pawn;
+		ERPGAISignificance Significance = ERPGAISignificance::High;
+
+		// BT pausado por esta faixa (Dormant); só retomamos o que nós pausamos
+		bool bLogicPaused = false;
+
+		// Registro permite pausar e, na última avaliação, a IA não estava engajada
+		bool bAllowPause = true;
+		bool bCanPause = true;
+
+		FRPGBlackboardKeyCache BlackboardKeys;
+
+		// Valores originais, restaurados em High e ao desregistrar
+		float PerceptionTickInterval = 0.f;
+		float MovementTickInterval = 0.f;
+		EVisibilityBasedAnimTickOption AnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	};
+
+	/** Posições de todos os pawns de jogador (multiplayer: a faixa vem do mais próximo) */
+	bool GetReferenceLocations(TArray<FVector, TInlineAllocator<4>>& OutLocations) const;
+	ERPGAISignificance EvaluateSignificance(const APawn* Pawn, TArrayView<const FVector> ReferenceLocations, bool bUseVisibility, ERPGAISignificance CurrentSignificance) const;
+	void ApplySignificance(FTrackedController& Tracked, ERPGAISignificance Significance);
+
+	/** Pausar só IAs sem alvo: uma IA engajada ou seguindo o líder fora da tela não pode congelar */
+	bool CanPauseLogic(FTrackedController& Tracked) const;
+
+	/** rpg.AI.Significance desligado: devolve todas as IAs à taxa original */
+	void RestoreAllToHigh();
+
+	TArray<FTrackedController> TrackedControllers;
+
+	// Consulta O(1) da faixa (serviços do BT perguntam a cada agendamento)
+	TMap<TObjectKey<AAIController>, ERPGAISignificance> SignificanceByController;
+
+	float TimeSinceEvaluation = 0.f;
+
+	// Reavaliar as faixas não precisa ser por frame
+	const float EVALUATION_INTERVAL = 0.5f;
+};
@@ -0,0 +1,102 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AI/RPGAIStressStats.h"
+#include "RPGAIStressHarnessSubsystem.generated.h"
+
+class AController;
+class APawn;
+
+/**
+ * Harness de carga de IA (apenas builds não-shipping).
+ * Disparado por "rpg.AI.Stress Enemies=N Party=M Frames=F Seed=S EnemyClass=<path> [PartyClass=<path>]
+ * [EnemyController=<path>] [PartyController=<path>] [Spacing=cm] [FixedFPS=30] [Quit]".
+ * Spawna os pawns em grade determinística ao redor do jogador (projetada no navmesh do mapa) e
+ * roda N frames com timestep fixo, sem interferir nos ticks do jogo. Grava um CSV por frame em
+ * Saved/Profiling/AIStress com o tick do mundo, o tempo exclusivo de BT, percepção, movimento e GAS
+ * (FRPGAIStressScope nos caminhos de tick do RPG) e o tempo do game thread quando o frame vem do
+ * loop da engine. Com o CSV profiler disponível, grava também uma captura do mesmo intervalo com
+ * os stat scopes da engine. Uso headless: -game -nullrhi -ExecCmds="rpg.AI.Stress ... Quit".
+ */
+UCLASS()
+class RPG_API URPGAIStressHarnessSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	struct FStressSettings
+	{
+		int32 NumEnemies = 50;
+		int32 NumPartyMembers = 0;
+		int32 NumFrames = 600;
+		int32 Seed = 1337;
+		float Spacing = 300.f;
+		float FixedFPS = 30.f;
+		TSubclassOf<APawn> EnemyClass;
+		TSubclassOf<APawn> PartyClass;
+
+		// Substituem o AIControllerClass do pawn quando informados
+		TSubclassOf<AController> EnemyControllerClass;
+		TSubclassOf<AController> PartyControllerClass;
+
+		bool bQuitWhenDone = false;
+	};
+
+	struct FFrameSample
+	{
+		float DeltaTime = 0.f;
+		double WorldTickMs = 0.0;
+
+		// Negativo quando o frame não veio do loop da engine (ex.: UWorld::Tick manual nos testes)
+		double GameThreadMs = -1.0;
+
+		double CategoryMs[static_cast<int32>(ERPGAIStressCategory::Num)] = {};
+	};
+
+	virtual void Deinitialize() override;
+
+	bool StartRun(const FStressSettings& InSettings);
+	void StopRun();
+
+	UFUNCTION(BlueprintPure, Category = "AI|Stress")
+	bool IsRunning() const { return bRunning; }
+
+	/** Amostras completas da execução atual (ou da última, até a próxima StartRun) */
+	int32 GetNumSamples() const;
+	TConstArrayView<FFrameSample> GetSamples() const { return MakeArrayView(Samples.GetData(), GetNumSamples()); }
+
+	/** Pawns criados pela execução atual */
+	int32 GetNumSpawnedPawns() const { return SpawnedPawns.Num(); }
+
+	/** Caminho do último CSV gravado pelo harness */
+	const FString& GetLastCsvPath() const { return LastCsvPath; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	APawn* SpawnStressPawn(TSubclassOf<APawn> PawnClass, TSubclassOf<AController> ControllerClass, const FVector& Location, const FRotator& Rotation);
+	void HandleWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds);
+	void HandleWorldTickEnd(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds);
+	void FinishRun();
+	void WriteCsv();
+
+	FStressSettings Settings;
+	TArray<TWeakObjectPtr<APawn>> SpawnedPawns;
+	TArray<FFrameSample> Samples;
+	FString RunName;
+	FString LastCsvPath;
+
+	FDelegateHandle TickStartHandle;
+	FDelegateHandle TickEndHandle;
+	uint64 WorldTickStartCycles = 0;
+	uint64 WorldTickStartFrame = 0;
+
+	bool bRunning = false;
+	bool bOwnsCsvCapture = false;
+	bool bPreviousUseFixedTimeStep = false;
+	double PreviousFixedDeltaTime = 0.0;
+};
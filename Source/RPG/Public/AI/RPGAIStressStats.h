@@ -0,0 +1,57 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Categorias de custo da IA medidas pelo harness de carga (uma coluna do CSV cada) */
+enum class ERPGAIStressCategory : uint8
+{
+	BehaviorTree,
+	Perception,
+	Movement,
+	AbilitySystem,
+	Num
+};
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Tempo exclusivo por categoria nos caminhos de tick do RPG, acumulado só durante uma execução
+ * do URPGAIStressHarnessSubsystem (fora dela o escopo é um teste de bool). Um escopo de outra
+ * categoria aberto dentro de um escopo pausa o de fora, então a soma das colunas cabe no tick do mundo.
+ */
+class RPG_API FRPGAIStressScope
+{
+public:
+	explicit FRPGAIStressScope(ERPGAIStressCategory InCategory);
+	~FRPGAIStressScope();
+
+	FRPGAIStressScope(const FRPGAIStressScope&) = delete;
+	FRPGAIStressScope& operator=(const FRPGAIStressScope&) = delete;
+
+	static void SetEnabled(bool bInEnabled);
+
+	/** Tempo acumulado por categoria desde a última chamada (ms), zerando os acumuladores */
+	static void ConsumeFrame(double (&OutCategoryMs)[static_cast<int32>(ERPGAIStressCategory::Num)]);
+
+	static const TCHAR* GetCategoryName(ERPGAIStressCategory Category);
+
+private:
+	ERPGAIStressCategory Category;
+	uint64 StartCycles = 0;
+	FRPGAIStressScope* Parent = nullptr;
+	bool bActive = false;
+
+	static bool bEnabled;
+	static FRPGAIStressScope* Current;
+	static uint64 CategoryCycles[static_cast<int32>(ERPGAIStressCategory::Num)];
+};
+
+#define RPG_AI_STRESS_SCOPE(Category) const FRPGAIStressScope PREPROCESSOR_JOIN(RPGAIStressScope_, __LINE__)(ERPGAIStressCategory::Category)
+
+#else
+
+#define RPG_AI_STRESS_SCOPE(Category)
+
+#endif
@@ -0,0 +1,20 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "RPGBehaviorTreeComponent.generated.h"
+
+/**
+ * BehaviorTreeComponent das IAs do RPG (BrainComponent dos controllers, reaproveitado por RunBehaviorTree).
+ * Só acrescenta a medição do tick para a coluna BehaviorTree do harness de carga.
+ */
+UCLASS()
+class RPG_API URPGBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+};
@@ -0,0 +1,50 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BlackboardComponent.h"
+
+class UBlackboardData;
+
+/**
+ * IDs das chaves de blackboard usadas pelos controladores de IA (inimigos e party).
+ * Resolvidos uma única vez por asset de blackboard (registro global), evitando a
+ * construção de FName + busca linear de chave em cada leitura/escrita.
+ * Chaves ausentes no asset ficam como FBlackboard::InvalidKey e as escritas são ignoradas.
+ */
+struct RPG_API FRPGBlackboardKeys
+{
+	FBlackboard::FKey TargetActor = FBlackboard::InvalidKey;
+	FBlackboard::FKey LastKnownLocation = FBlackboard::InvalidKey;
+	FBlackboard::FKey NoiseLocation = FBlackboard::InvalidKey;
+	FBlackboard::FKey PartyMember = FBlackboard::InvalidKey;
+	FBlackboard::FKey ActivePlayerLocation = FBlackboard::InvalidKey;
+	FBlackboard::FKey HitReacting = FBlackboard::InvalidKey;
+	FBlackboard::FKey Dead = FBlackboard::InvalidKey;
+
+	/** IDs já resolvidos para o asset (resolve e guarda no registro na primeira chamada) */
+	static const FRPGBlackboardKeys& Get(const UBlackboardData* BlackboardAsset);
+};
+
+/**
+ * Cache por controlador: guarda uma cópia dos IDs do asset atual do blackboard
+ * e só consulta o registro quando o asset muda (comparação de ponteiro).
+ */
+struct RPG_API FRPGBlackboardKeyCache
+{
+	const FRPGBlackboardKeys& Resolve(const UBlackboardComponent* Blackboard);
+
+private:
+	TWeakObjectPtr<const UBlackboardData> CachedAsset;
+	FRPGBlackboardKeys CachedKeys;
+};
+
+// Acessores tipados por ID de chave
+namespace RPGBlackboard
+{
+	RPG_API void SetObject(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, UObject* Value);
+	RPG_API void SetVector(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, const FVector& Value);
+	RPG_API void SetBool(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, bool bValue);
+	RPG_API void Clear(UBlackboardComponent* Blackboard, FBlackboard::FKey Key);
+}
@@ -7,6 +7,8 @@
 #include "Perception/AISense_Sight.h"
 #include "Engine/Engine.h"
 #include "Interaction/CombatInterface.h"
+#include "AI/RPGBlackboardKeys.h"
+#include "Components/SceneComponent.h"
 #include "RPGPartyAIController.generated.h"
 
 class UBehaviorTreeComponent;
@@ -15,6 +17,8 @@ class UAIPerceptionComponent;
 struct FAIStimulus;
 
 class ARPGCharacterBase;
+class ARPGCharacter;
+class UPartySubsystem;
 
 /**
  * 
@@ -30,9 +34,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AI")
 	void UpdateTargetLocation(const FVector& NewLocation);
 
-	/** Atualiza PartyMember apenas quando está em paz (sem inimigos, sons ou dano) */
-	UFUNCTION()
-	void UpdatePartyMemberWhenSafe();
+	/** IDs das chaves do blackboard atual (re-resolvidos só quando o asset muda) */
+	const FRPGBlackboardKeys& GetBlackboardKeys();
 
   /** Força o controlador a alinhar seu estado com o PartySubsystem (ativo x não-ativo) */
   UFUNCTION(BlueprintCallable, Category = "AI")
@@ -41,6 +44,7 @@ public:
 protected:
 	virtual void OnPossess(APawn* InPawn) override;
   virtual void OnUnPossess() override;
+  virtual void FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const override;
 
 	UFUNCTION()
 	void OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus);
@@ -67,8 +71,36 @@ protected:
 	TObjectPtr<UAIPerceptionComponent> AIPerceptionComponent;
 
 private:
-	/** Timer handle para atualizar PartyMember quando seguro */
-	FTimerHandle UpdatePartyMemberTimerHandle;
+	// === SEGUIR O MEMBRO ATIVO ===
+	// Máquina de estados orientada a eventos: morte do alvo, perda de percepção, troca do
+	// membro ativo e deslocamento do líder. Sem timer: membros ociosos não custam nada por frame.
+
+	/** Entra/sai do estado de seguir conforme alvo atual e membro ativo */
+	void RefreshFollowState();
+
+	void WriteFollowKeys(ARPGCharacter* Leader);
+	void ClearFollowKeys();
+
+	void BindLeaderMovement(ARPGCharacter* Leader);
+	void UnbindLeaderMovement();
+	void HandleLeaderTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	UPartySubsystem* GetPartySubsystem() const;
+
+	FRPGBlackboardKeyCache BlackboardKeyCache;
+
+	TWeakObjectPtr<ARPGCharacter> FollowedLeader;
+	TWeakObjectPtr<USceneComponent> FollowedLeaderRoot;
+	FDelegateHandle LeaderTransformHandle;
+
+	/** Último valor gravado em ActivePlayerLocation */
+	FVector LastWrittenLeaderLocation = FVector::ZeroVector;
+
+	/** PartyMember/ActivePlayerLocation estão preenchidos no blackboard */
+	bool bFollowKeysWritten = false;
+
+	// Deslocamento mínimo do líder para regravar ActivePlayerLocation
+	const float LEADER_MOVE_THRESHOLD = 150.f;
 
   /** Marca se já vinculamos ao PartySubsystem para eventos */
   bool bBoundToPartySubsystem = false;
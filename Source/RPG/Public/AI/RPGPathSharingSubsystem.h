@@ -0,0 +1,119 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationData.h"
+#include "RPGPathSharingSubsystem.generated.h"
+
+class AAIController;
+struct FAIMoveRequest;
+struct FPathFindingQuery;
+
+/** Caminho pronto para uma requisição (Path inválido = falha) */
+DECLARE_DELEGATE_TwoParams(FOnSharedPathReady, uint32 /*RequestId*/, FNavPathSharedPtr /*Path*/);
+
+/**
+ * Compartilhamento e fatiamento de pathfinding para IA em grupo.
+ * Requisições com início e destino próximos (START/GOAL_TOLERANCE) dentro de SHARE_WINDOW
+ * reaproveitam o mesmo corredor já calculado; cada agente recebe uma cópia do caminho consultado
+ * (FNavMeshPath com polígonos, flags e links customizados) com o próprio ponto de partida (se houver
+ * linha reta no navmesh até o ponto seguinte) e, para destinos fixos, um destino deslocado (slot em
+ * espiral ao redor do objetivo), que também vira o destino de um repath. MoveTo até um ator
+ * mantém o ponto final do corredor, que acompanha o ator.
+ * - Síncrono: ARPGAIController/ARPGPartyAIController passam o MoveTo padrão por FindPathForMoveRequest.
+ * - Assíncrono: UBTTask_SharedMoveTo enfileira o pedido; o Tick resolve no máximo
+ *   rpg.AI.PathQueryBudget consultas ao navmesh por frame (acertos no cache não contam).
+ */
+UCLASS()
+class RPG_API URPGPathSharingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Enfileira um pedido de caminho até Goal; OnReady é chamado num Tick futuro. Retorna o id (0 = falha).
+	 * NavData nulo usa os dados de navegação do agente no sistema de navegação.
+	 */
+	uint32 RequestPath(AAIController* Controller, const FVector& Goal, FOnSharedPathReady OnReady, const ANavigationData* NavData = nullptr);
+	void CancelRequest(uint32 RequestId);
+
+	/**
+	 * Substituto do AAIController::FindPathForMoveRequest: usa um corredor compartilhado quando possível.
+	 * Retorna false se o subsistema não existir no mundo do controlador (usar a implementação padrão).
+	 */
+	static bool FindPathForMoveRequest(const AAIController* Controller, const FAIMoveRequest& MoveRequest, const FPathFindingQuery& Query, FNavPathSharedPtr& OutPath);
+
+	UFUNCTION(BlueprintPure, Category = "AI|Navigation")
+	int32 GetNumQueriesLastFrame() const { return QueriesLastFrame; }
+
+	UFUNCTION(BlueprintPure, Category = "AI|Navigation")
+	int32 GetNumSharedPathsLastFrame() const { return SharedLastFrame; }
+
+	UFUNCTION(BlueprintPure, Category = "AI|Navigation")
+	int32 GetNumPendingRequests() const { return PendingRequests.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FCorridor
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector Goal = FVector::ZeroVector;
+
+		// Cópia privada do caminho consultado (nunca observada nem atualizada por repath), base das cópias dos agentes
+		FNavPathSharedPtr Template;
+		TWeakObjectPtr<const ANavigationData> NavData;
+		FSharedConstNavQueryFilter QueryFilter;
+		double Time = 0.0;
+		int32 NumSharers = 0;
+		bool bPartial = false;
+	};
+
+	struct FPendingRequest
+	{
+		uint32 Id = 0;
+		TWeakObjectPtr<AAIController> Controller;
+		FVector Goal = FVector::ZeroVector;
+		FOnSharedPathReady OnReady;
+		TWeakObjectPtr<const ANavigationData> NavData;
+		bool bExplicitNavData = false;
+	};
+
+	/** Caminho para Query: corredor compartilhado ou uma nova consulta ao navmesh (sempre síncrono) */
+	FNavPathSharedPtr FindSharedPath(const FPathFindingQuery& Query, bool bOffsetGoal);
+
+	FCorridor* FindCorridor(const FPathFindingQuery& Query);
+
+	/** Corredor com o início do agente; nulo se o trecho até o segundo ponto não for navegável em linha reta */
+	FNavPathSharedPtr BuildAgentPath(FCorridor& Corridor, const FPathFindingQuery& Query, bool bOffsetGoal);
+	FNavPathSharedPtr QueryNavMesh(const FPathFindingQuery& Query);
+
+	/** Cópia independente de Source, mantendo o tipo (FNavMeshPath ou FNavigationPath) */
+	static FNavPathSharedPtr CopyPath(const FNavigationPath& Source);
+
+	TArray<FCorridor> Corridors;
+	TArray<FPendingRequest> PendingRequests;
+	uint32 NextRequestId = 1;
+
+	int32 QueriesThisFrame = 0;
+	int32 QueriesLastFrame = 0;
+	int32 SharedThisFrame = 0;
+	int32 SharedLastFrame = 0;
+
+	// Janela em que um corredor calculado pode ser reaproveitado
+	const float SHARE_WINDOW = 0.5f;
+
+	// Distância máxima entre destinos / pontos de partida para compartilhar o corredor
+	const float GOAL_TOLERANCE = 150.f;
+	const float START_TOLERANCE = 400.f;
+
+	// Espaçamento entre os destinos deslocados dos agentes que compartilham um corredor
+	const float AGENT_SPACING = 90.f;
+};
@@ -0,0 +1,89 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Perception/AISense_Sight.h"
+#include "Perception/AISightTargetInterface.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+#include "RPGSightTraceSubsystem.generated.h"
+
+/**
+ * Linha de visão assíncrona e com orçamento para a percepção de visão.
+ * ARPGCharacterBase (IAISightTargetInterface) consulta este subsistema em vez de
+ * fazer traces síncronos: o resultado vem do cache do par (observador, alvo) e,
+ * quando vencido, é renovado com traces assíncronos para os pontos (sockets) do alvo,
+ * respeitando um limite de traces por frame (rpg.AI.SightTraceBudget). Com o delegate da
+ * engine, a renovação responde Pending e o resultado é entregue quando os traces terminam.
+ * Raio, LoseSightRadius e ângulo continuam sendo avaliados pelo UAISense_Sight.
+ */
+UCLASS()
+class RPG_API URPGSightTraceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Visibilidade de Target a partir de ObserverLocation.
+	 * Resultado recente: responde do cache. Vencido e com orçamento: agenda os traces e, com Delegate,
+	 * responde Pending e chama o delegate ao terminar. Sem orçamento: último resultado conhecido.
+	 */
+	UAISense_Sight::EVisibilityResult QueryVisibility(const FCanBeSeenFromContext& Context, const AActor* Target,
+		TConstArrayView<FVector> TargetPoints, FVector& OutSeenLocation, int32& OutNumAsyncTracesRequested,
+		const int32* UserData = nullptr, const FOnPendingVisibilityQueryProcessedDelegate* Delegate = nullptr);
+
+	UFUNCTION(BlueprintPure, Category = "AI|Sight")
+	int32 GetNumTracesLastFrame() const { return TracesLastFrame; }
+
+	/** Bloqueio que não esconde o alvo: o hit é o próprio Target ou algo que ele possui (ex.: arma) */
+	static bool IsHitOnTarget(const FHitResult& Hit, const AActor* Target);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	using FSightPairKey = TPair<TObjectKey<const AActor>, TObjectKey<const AActor>>;
+
+	struct FSightResult
+	{
+		TWeakObjectPtr<const AActor> Target;
+		FVector SeenLocation = FVector::ZeroVector;
+		double ResultTime = -1.0;
+		bool bVisible = false;
+
+		// Requisição em andamento (0 = nenhuma)
+		uint32 PendingRequestId = 0;
+		int32 PendingTraces = 0;
+		bool bPendingVisible = false;
+		FVector PendingSeenLocation = FVector::ZeroVector;
+
+		// Consulta do UAISense_Sight que recebeu Pending e espera este resultado
+		FOnPendingVisibilityQueryProcessedDelegate PendingDelegate;
+		FAISightQueryID PendingQueryID;
+		TOptional<int32> PendingUserData;
+	};
+
+	void OnTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	void PruneStaleResults(double Now);
+
+	TMap<FSightPairKey, FSightResult> Results;
+	TMap<uint32, FSightPairKey> PendingRequests;
+	FTraceDelegate TraceDelegate;
+	uint32 NextRequestId = 1;
+
+	int32 TracesThisFrame = 0;
+	int32 TracesLastFrame = 0;
+	double LastPruneTime = 0.0;
+
+	// Idade máxima de um resultado antes de pedir nova verificação
+	const float RESULT_MAX_AGE = 0.1f;
+
+	// Pares sem consulta há mais que isso saem do cache
+	const float STALE_RESULT_TIME = 5.f;
+};
@@ -0,0 +1,86 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RPGSquadPerceptionSubsystem.generated.h"
+
+class AAIController;
+class ARPGAIController;
+struct FAIStimulus;
+
+/**
+ * Percepção compartilhada por squad (opt-in via ARPGEnemy::SquadId).
+ * Membros de um squad não rodam a própria visão: o subsistema faz os testes de
+ * cone e linha de visão uma vez por squad, em intervalos escalonados (trace a partir do
+ * membro mais próximo, recorrendo aos seguintes se bloqueado), e repassa
+ * ganho/perda de visão ao OnTargetPerceptionUpdated de cada membro. A audição
+ * fica só no líder, que compartilha os estímulos com os demais. Dano continua individual.
+ */
+UCLASS()
+class RPG_API URPGSquadPerceptionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterMember(FName SquadId, ARPGAIController* Controller);
+	void UnregisterMember(ARPGAIController* Controller);
+	bool IsSquadMember(const AAIController* Controller) const { return SquadByController.Contains(Controller); }
+
+	/** Repassa um estímulo de audição recebido pelo líder aos demais membros do squad */
+	void ShareHearingStimulus(const ARPGAIController* Source, AActor* Actor, const FAIStimulus& Stimulus);
+
+	UFUNCTION(BlueprintPure, Category = "AI|Squad")
+	int32 GetNumSquads() const { return Squads.Num(); }
+
+	/** Traces de linha de visão feitos na última janela de atualização (todos os squads) */
+	UFUNCTION(BlueprintPure, Category = "AI|Squad")
+	int32 GetNumSightTracesLastInterval() const { return SightTracesLastInterval; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FSquad
+	{
+		TArray<TWeakObjectPtr<ARPGAIController>> Members;
+		TWeakObjectPtr<ARPGAIController> Leader;
+		TArray<TWeakObjectPtr<AActor>> SeenTargets;
+		double NextUpdateTime = 0.0;
+	};
+
+	struct FObserver
+	{
+		float DistanceSq;
+		const APawn* Pawn;
+	};
+
+	void UpdateSquadSight(FSquad& Squad);
+	void SelectLeader(FSquad& Squad) const;
+	void BroadcastStimulus(const FSquad& Squad, AActor* Actor, const FAIStimulus& Stimulus, const ARPGAIController* Except) const;
+
+	/** Visão desligada em todos os membros; audição apenas no líder */
+	static void ConfigureMemberSenses(ARPGAIController* Controller, bool bLeader);
+	static void RestoreMemberSenses(ARPGAIController* Controller);
+
+	TMap<FName, FSquad> Squads;
+	TMap<TObjectKey<AAIController>, FName> SquadByController;
+
+	// Buffers reaproveitados entre atualizações
+	TArray<AActor*> CandidateScratch;
+	TArray<const AActor*> MemberPawnScratch;
+	TArray<FObserver> ObserverScratch;
+
+	int32 SightTracesThisInterval = 0;
+	int32 SightTracesLastInterval = 0;
+	double IntervalStartTime = 0.0;
+
+	// Intervalo entre atualizações de visão de um mesmo squad (squads são escalonados dentro dele)
+	const float UPDATE_INTERVAL = 0.25f;
+};
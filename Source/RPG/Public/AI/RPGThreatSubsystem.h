@@ -0,0 +1,45 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RPGThreatSubsystem.generated.h"
+
+class ARPGAIController;
+
+/**
+ * Roteia eventos de dano e cura do URPGAttributeSet para as tabelas de ameaça dos inimigos.
+ * Mantém um índice reverso ator -> inimigos que o têm na tabela, para que uma cura gere
+ * ameaça apenas nos inimigos engajados com o alvo curado (O(k), sem varrer todos os inimigos).
+ */
+UCLASS()
+class RPG_API URPGThreatSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Dano aplicado em Victim por Instigator (chamado do PostGameplayEffectExecute) */
+	static void ReportDamage(const AActor* Victim, AActor* Instigator, float Damage);
+
+	/** Cura aplicada em Healed por Healer (chamado do PostGameplayEffectExecute) */
+	static void ReportHealing(const AActor* Healed, AActor* Healer, float Amount);
+
+	void RegisterEngagement(ARPGAIController* Controller, const AActor* Actor);
+	void UnregisterEngagement(ARPGAIController* Controller, const AActor* Actor);
+
+	// Ameaça por ponto de dano / de vida curada
+	static constexpr float DAMAGE_THREAT_SCALE = 1.f;
+	static constexpr float HEAL_THREAT_SCALE = 0.5f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	using FEngagedControllers = TArray<TWeakObjectPtr<ARPGAIController>, TInlineAllocator<4>>;
+
+	TMap<TObjectKey<AActor>, FEngagedControllers> EngagedControllers;
+};
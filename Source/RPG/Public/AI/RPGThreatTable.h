@@ -0,0 +1,71 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Tabela de ameaça (aggro) de um inimigo.
+ * A ameaça decai exponencialmente com o tempo, de forma preguiçosa: cada entrada guarda o valor
+ * escalado por exp(DECAY_RATE * (T - Epoch)), então a ordem entre entradas não muda com o tempo
+ * e o topo só precisa ser reavaliado quando uma entrada é somada ou removida.
+ * Entradas fora de vista continuam na tabela (decaindo), mas não concorrem ao topo até serem vistas de novo.
+ */
+struct RPG_API FRPGThreatTable
+{
+	/** Soma Amount à ameaça de Actor. Retorna true se o ator no topo mudou */
+	bool AddThreat(AActor* Actor, float Amount, double Now);
+
+	/** Remove Actor da tabela. Retorna true se o ator no topo mudou */
+	bool RemoveThreat(const AActor* Actor);
+
+	/** Marca Actor como fora de vista (ou visto de novo) sem perder a ameaça. Retorna true se o ator no topo mudou */
+	bool SetUnseen(const AActor* Actor, bool bUnseen);
+	bool IsUnseen(const AActor* Actor) const;
+
+	void Reset();
+
+	AActor* GetTopActor() const;
+	float GetThreat(const AActor* Actor, double Now) const;
+	bool Contains(const AActor* Actor) const { return FindIndex(Actor) != INDEX_NONE; }
+	bool IsEmpty() const { return Entries.Num() == 0; }
+
+	/** Atores presentes na tabela (inclui os já inválidos ainda não compactados) */
+	template <typename FunctorType>
+	void ForEachActor(FunctorType&& Functor) const
+	{
+		for (const FEntry& Entry : Entries)
+		{
+			if (AActor* Actor = Entry.Actor.Get())
+			{
+				Functor(Actor);
+			}
+		}
+	}
+
+	// Meia-vida de ~7s
+	static constexpr double DECAY_RATE = 0.1;
+
+	// Um desafiante precisa superar o topo em 10% para trocar o alvo (evita alternância)
+	static constexpr double SWITCH_MARGIN = 1.1;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		double ScaledThreat = 0.0;
+		bool bUnseen = false;
+	};
+
+	int32 FindIndex(const AActor* Actor) const;
+	int32 FindTopIndex() const;
+	bool CanBeTop(int32 EntryIndex) const;
+	void Rebase(double Now);
+
+	TArray<FEntry, TInlineAllocator<4>> Entries;
+	int32 TopIndex = INDEX_NONE;
+	double Epoch = 0.0;
+
+	// Rebase antes de exp() crescer demais (exp(0.1 * 300) ~ 1e13)
+	static constexpr double REBASE_INTERVAL = 300.0;
+};
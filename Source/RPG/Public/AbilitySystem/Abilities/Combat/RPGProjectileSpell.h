@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystem/Abilities/Base/RPGDamageGameplayAbility.h"
+#include "Actor/RPGProjectileSimulationSubsystem.h"
 #include "RPGProjectileSpell.generated.h"
 
 class ARPGProjectile;
@@ -31,4 +32,12 @@ public:
     /** Classe do projétil a ser instanciado */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ability")
     TSubclassOf<ARPGProjectile> ProjectileClass;
+
+    /** Usa o URPGProjectileSimulationSubsystem (sem ator por projétil) em vez de ProjectileClass */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ability|Simulation")
+    bool bUseSimulatedProjectile = false;
+
+    /** Parâmetros do projétil simulado (velocidade, raio, visual ISM) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ability|Simulation", meta=(EditCondition="bUseSimulatedProjectile"))
+    FRPGSimulatedProjectileParams SimulatedProjectileParams;
 }; 
\ No newline at end of file
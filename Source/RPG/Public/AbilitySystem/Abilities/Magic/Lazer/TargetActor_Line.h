@@ -54,6 +54,14 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "VFX")
     FName LazerFXLengthParamName = "Length";
 
+    // Usa AsyncSweepByChannel: o resultado é consumido no frame seguinte, fora do caminho crítico do game thread
+    UPROPERTY(EditDefaultsOnly, Category = "Targeting")
+    bool bUseAsyncTrace = false;
+
+    // Intervalo do trace visual do laser (0 = todo frame). Independente do TargetingInterval do dano
+    UPROPERTY(EditDefaultsOnly, Category = "Targeting", meta = (ClampMin = "0"))
+    float VisualTraceInterval = 0.f;
+
     UPROPERTY(VisibleDefaultsOnly, Category = "Component")
     class USceneComponent* RootComp;
 
@@ -68,7 +76,26 @@ private:
 
     void DoTargetCheckAndReport();
 
-    void UpdateTargetTrace();
+    // Orienta o ator para o ponto de mira do avatar e retorna a rotação
+    FRotator UpdateAimRotation();
+
+    void UpdateTargetTrace(const FRotator& LookRotation);
+
+    // === TRACE ASSÍNCRONO ===
+    void IssueAsyncTargetTrace(const FRotator& LookRotation);
+    void ConsumeAsyncTargetTrace(const FRotator& LookRotation);
+
+    // Primeiro hit não-aliado define o fim do laser; retorna false se não houve
+    bool FindLineEnd(const TArray<FHitResult>& HitResults, FVector& OutLineEndLocation) const;
+
+    // Posiciona a esfera de detecção e o VFX no fim do laser
+    void ApplyLineEnd(const FVector& LineEndLocation);
+
+    FCollisionQueryParams MakeTargetTraceQueryParams() const;
+
+    FTraceHandle PendingTargetTraceHandle;
+    float TimeSinceVisualTrace = 0.f;
+    float CurrentLineLength = 0.f;
 
     bool ShouldReportActorAsTarget(const AActor* ActorToCheck) const;
 };
@@ -44,6 +44,17 @@ public:
     UFUNCTION(BlueprintPure, Category="AbilitySystem|Input")
     bool HasActiveAbilityWithInputTag(const FGameplayTag& InputTag) const;
 
+    /** Marca a tabela InputTag -> spec para reconstrução (chamar ao alterar tags dinâmicas de um spec) */
+    void MarkInputTagRoutingDirty() { bInputTagRoutingDirty = true; }
+
+    /** Se verdadeiro, o evento genérico Events_Abilities_InputHeld não é enviado */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AbilitySystem|Input")
+    bool bSuppressInputHeldEvent = false;
+
+    /** Intervalo mínimo (segundos) entre eventos InputHeld da mesma tag. 0 = todo frame */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AbilitySystem|Input", meta=(ClampMin="0.0"))
+    float InputHeldEventInterval = 0.f;
+
     // === ABILITY LEVEL MANAGEMENT ===
 
     /** Define o nível da ability diretamente (substitui o nível atual) */
@@ -69,10 +80,39 @@ private:
 
     // === OVERRIDES ===
 
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
     virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+    virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
     virtual void OnRep_ActivateAbilities() override;
 
 private:
     void HandleAutoActivateAbility(const FGameplayAbilitySpec& AbilitySpec);
 
+    // === ROTEAMENTO DE INPUT ===
+
+    /** Referência a um spec em ActivatableAbilities (índice validado pelo handle) */
+    struct FInputTagSpecRef
+    {
+        int32 SpecIndex = INDEX_NONE;
+        FGameplayAbilitySpecHandle Handle;
+    };
+
+    /** Reconstrói a tabela InputTag -> specs a partir das habilidades ativáveis */
+    void RebuildInputTagRouting() const;
+
+    /** Copia as referências de spec para a InputTag (reconstrói a tabela se estiver desatualizada) */
+    void GetInputTagSpecRefs(const FGameplayTag& InputTag, TArray<FInputTagSpecRef, TInlineAllocator<4>>& OutSpecRefs) const;
+
+    /** Resolve uma referência para o spec, ou nullptr se ele não estiver mais no mesmo índice */
+    FGameplayAbilitySpec* ResolveInputTagSpecRef(const FInputTagSpecRef& SpecRef);
+
+    /** Tabela InputTag -> specs com essa tag dinâmica */
+    mutable TMap<FGameplayTag, TArray<FInputTagSpecRef>> InputTagRouting;
+
+    /** Tabela precisa ser reconstruída (habilidade concedida/removida/tag alterada) */
+    mutable bool bInputTagRoutingDirty = true;
+
+    /** Último envio do evento InputHeld por InputTag (para InputHeldEventInterval) */
+    TMap<FGameplayTag, double> LastInputHeldEventTime;
+
 }; 
\ No newline at end of file
@@ -9,7 +9,11 @@
 class UAbilitySystemComponent;
 enum class ECharacterClass : uint8;
 class UEnemyClassInfo;
+class ARPGGameModeBase;
 struct FGameplayEffectContextHandle;
+struct FGameplayEffectSpecHandle;
+struct FDamageEffectParams;
+struct FEnemyAttributeBaseline;
 
 /**
  * Biblioteca do Ability System para funcionalidades utilitárias, como controle de widgets e inicialização de atributos de classe.
@@ -68,6 +72,9 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category="RPGAbilitySystemLibrary|CharacterClassDefaults")
 	static void InitializeDefaultAttributes(const UObject* WorldContextObject, ECharacterClass CharacterClass, float Level, UAbilitySystemComponent* ASC);
+
+	/** InitializeDefaultAttributes com o game mode (dono do EnemyClassInfo e dos baselines) já resolvido */
+	static void InitializeDefaultAttributesForGameMode(ARPGGameModeBase* RPGGameMode, ECharacterClass CharacterClass, float Level, UAbilitySystemComponent* ASC);
     UFUNCTION(BlueprintCallable, Category="RPGAbilitySystemLibrary|CharacterClassDefaults")
     static void GiveStartupAbilities(const UObject* WorldContextObject, UAbilitySystemComponent* ASC, ECharacterClass CharacterClass);
     UFUNCTION(BlueprintCallable, Category="RPGAbilitySystemLibrary|CharacterClassDefaults")
@@ -102,6 +109,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "RPGAbilitySystemLibrary|Damage")
 	static FGameplayEffectContextHandle ApplyDamageEffect(const FDamageEffectParams& DamageEffectParams);
 
+	/**
+	* Aplica o mesmo efeito de dano a vários alvos (AoE): o spec é montado uma única vez
+	* e cada alvo recebe uma cópia do contexto. Retorna o número de alvos atingidos.
+	*/
+	static int32 ApplyDamageEffectToTargets(const FDamageEffectParams& DamageEffectParams, TArrayView<AActor* const> TargetActors);
+
+	/**
+	* Versão Blueprint de ApplyDamageEffectToTargets
+	*/
+	UFUNCTION(BlueprintCallable, Category = "RPGAbilitySystemLibrary|Damage")
+	static int32 ApplyDamageEffectToActors(const FDamageEffectParams& DamageEffectParams, const TArray<AActor*>& TargetActors);
+
 	/**
 	* Cria um array de rotadores distribuídos uniformemente em torno de um eixo
 	*/
@@ -131,4 +150,15 @@ public:
 	*/
 	UFUNCTION(BlueprintCallable, Category = "RPGAbilitySystemLibrary|DamageEffect")
 	static void SetKnockbackDirection(UPARAM(ref) FDamageEffectParams& DamageEffectParams, FVector KnockbackDirection, float Magnitude = 0.f);
+
+private:
+
+	/** Monta contexto + spec de dano a partir dos parâmetros (compartilhado entre alvo único e AoE) */
+	static FGameplayEffectSpecHandle MakeDamageEffectSpec(const FDamageEffectParams& DamageEffectParams);
+
+	/** Caminho por GEs (primários, secundários, vitais) usado no primeiro spawn e como fallback */
+	static void ApplyDefaultAttributeEffects(UEnemyClassInfo* CharacterClassInfo, ECharacterClass CharacterClass, float Level, UAbilitySystemComponent* ASC);
+
+	/** Captura os valores atuais dos atributos (exceto meta) modificados pelos GEs de inicialização da classe */
+	static FEnemyAttributeBaseline MakeAttributeBaseline(UEnemyClassInfo* CharacterClassInfo, ECharacterClass CharacterClass, UAbilitySystemComponent* ASC);
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Engine/DataAsset.h"
 #include "Engine/CurveTable.h"
 #include "ScalableFloat.h"
+#include "AttributeSet.h"
 #include "EnemyClassInfo.generated.h"
 
 class UGameplayEffect;
@@ -19,6 +20,12 @@ enum class ECharacterClass : uint8
     Ranger
 };
 
+// Valores finais dos atributos após os GEs de inicialização de um (classe, nível)
+struct FEnemyAttributeBaseline
+{
+    TArray<TPair<FGameplayAttribute, float>> Values;
+};
+
 USTRUCT(BlueprintType)
 struct FCharacterClassDefaultInfo
 {
@@ -54,5 +61,19 @@ public:
     UPROPERTY(EditDefaultsOnly, Category = "Common Class Defaults|Damage")
     TObjectPtr<UCurveTable> DamageCalculationCoefficients;
 
+    /** Usa valores de atributos pré-calculados por (classe, nível) em vez de aplicar os GEs a cada spawn */
+    UPROPERTY(EditDefaultsOnly, Category = "Common Class Defaults|Performance")
+    bool bBakeAttributeBaselines = true;
+
+    /**
+     * Permite pré-calcular também GEs não instantâneos (ex.: secundários Infinite via MMC).
+     * Os valores derivados ficam fixos: mudanças posteriores nos primários não os recalculam.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Common Class Defaults|Performance", meta = (EditCondition = "bBakeAttributeBaselines"))
+    bool bBakeNonInstantAttributeEffects = false;
+
     FCharacterClassDefaultInfo GetClassDefaultInfo(ECharacterClass CharacterClass);
+
+    /** Se os GEs de inicialização desta classe podem ser substituídos por um baseline */
+    bool CanBakeAttributeBaselines(ECharacterClass CharacterClass) const;
 }; 
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "Abilities/Tasks/AbilityTask.h"
 #include "TargetDataUnderMouse.generated.h"
 
+struct FTraceDatum;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMouseTargetDataSignature, const FGameplayAbilityTargetDataHandle&, DataHandle);
 /**
  * 
@@ -21,7 +23,8 @@ public:
 		UGameplayAbility* OwningAbility,
 		float MaxTraceRange = 3000.f,
 		bool bDrawDebugTrace = false,
-		bool bUsePawnViewPoint = false
+		bool bUsePawnViewPoint = false,
+		bool bUseAsyncTrace = false
 	);
 
 	UPROPERTY(BlueprintAssignable)
@@ -42,8 +45,20 @@ private:
 	// Se true, usa a visão do Pawn (ActorLocation + ControlRotation); se false, usa PlayerController ViewPoint
 	bool bUsePawnViewPoint = false;
 
+	// Se true, usa AsyncLineTraceByChannel e envia o TargetData quando o resultado chega (frame seguinte)
+	bool bUseAsyncTrace = false;
+
 	virtual void Activate() override;
 	void SendMouseCursorData();
 
+	// Calcula início/fim do trace a partir da visão configurada; false se o avatar não for RPGCharacter
+	bool GetCursorTraceSegment(FVector& OutStart, FVector& OutEnd) const;
+
+	// Debug/log e envio do TargetData (comum aos modos síncrono e assíncrono)
+	void SendCursorHit(const FHitResult& CursorHit, const FVector& Start, const FVector& End, const FPredictionKey& CurrentPredictionKey);
+
+	// Resultado do trace assíncrono: abre a própria janela de predição antes de enviar o TargetData
+	void OnAsyncCursorTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
 	void OnTargetDataReplicatedCallback(const FGameplayAbilityTargetDataHandle& DataHandle, FGameplayTag ActivationTag);
 };
@@ -24,13 +24,34 @@ public:
 
 	UPROPERTY(BlueprintReadWrite)
 	FDamageEffectParams ExplosionDamageParams;
+
+	/**
+	 * Aplica a explosão nativamente em OnHit (ApplyExplosionDamage). Desligado por padrão enquanto o
+	 * BP_FireBall ainda aplica a explosão pelo próprio grafo; ligar só depois de remover esse caminho
+	 * do Blueprint, senão o dano é aplicado duas vezes.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Explosion")
+	bool bApplyNativeExplosion = false;
+
+	/**
+	 * Aplica o dano de explosão a todos os inimigos vivos no raio (ExplosionDamageParams.RadialDamageOuterRadius)
+	 * em uma única passada. Retorna o número de alvos atingidos.
+	 */
+	UFUNCTION(BlueprintCallable)
+	int32 ApplyExplosionDamage();
 	
 protected:
 	virtual void BeginPlay() override;
-	void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
+	/** Explosão da bola de fogo (chamada ao retornar): com bApplyNativeExplosion, aplica ApplyExplosionDamage uma vez por lançamento; devolve ao pool */
 	virtual void OnHit() override;
+	virtual void OnPoolActivated() override;
+	virtual void OnPoolDeactivated() override;
 	
 	// Função para verificar se o overlap é válido
 	bool IsValidOverlap(AActor* OtherActor);
+
+private:
+	// Evita aplicar a explosão duas vezes no mesmo lançamento
+	bool bExploded = false;
 }; 
\ No newline at end of file
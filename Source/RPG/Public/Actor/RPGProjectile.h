@@ -26,9 +26,16 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
     TObjectPtr<USphereComponent> Sphere;
 
+    /** Devolve o projétil ao URPGProjectilePoolSubsystem (se veio dele) ou destrói */
+    UFUNCTION(BlueprintCallable, Category = "Projectile|Pool")
+    void ReleaseToPoolOrDestroy();
+
+    bool IsPooled() const { return bIsPooled; }
+
 protected:
     virtual void BeginPlay() override;
     virtual void Destroyed() override;
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
     UFUNCTION()
     void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
@@ -39,6 +46,15 @@ protected:
     UFUNCTION(BlueprintCallable)
     virtual void OnHit();
 
+    /** Chamado quando um projétil do pool é reativado com novo transform */
+    virtual void OnPoolActivated() {}
+
+    /** Chamado quando o projétil volta para o pool */
+    virtual void OnPoolDeactivated() {}
+
+    /** true enquanto o projétil está inativo dentro do pool */
+    bool IsPoolDormant() const { return bPoolDormant; }
+
 private:
     // Tempo de vida antes de autodestruição
     UPROPERTY(EditDefaultsOnly)
@@ -47,5 +63,28 @@ private:
     // Indica que houve impacto sem autoridade, para suprimir som de Destroyed
     bool bHit = false;
 
+    // === POOL ===
+    friend class URPGProjectilePoolSubsystem;
+
+    void ActivateFromPool(const FTransform& SpawnTransform);
+    void DeactivateToPool();
+    void StartLifeSpan();
+
+    /** Estado local de dormência (movimento, colisão e visibilidade); aplicado no servidor e nos clientes */
+    void SetDormantState(bool bDormant);
+
+    UFUNCTION()
+    void OnRep_PoolDormant();
+
+    // Projétil gerenciado pelo pool (não é destruído no impacto)
+    bool bIsPooled = false;
+
+    // Inativo dentro do pool (replicado: clientes não recebem Destroy de projéteis do pool)
+    UPROPERTY(ReplicatedUsing=OnRep_PoolDormant)
+    bool bPoolDormant = false;
+
+    // Tempo de vida de projéteis do pool (SetLifeSpan destruiria o ator)
+    FTimerHandle PooledLifeSpanTimerHandle;
+
 
 }; 
\ No newline at end of file
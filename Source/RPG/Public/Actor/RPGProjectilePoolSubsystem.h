@@ -0,0 +1,71 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RPGProjectilePoolSubsystem.generated.h"
+
+class ARPGProjectile;
+
+// Projéteis inativos de uma mesma classe
+USTRUCT()
+struct FRPGProjectilePoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TWeakObjectPtr<ARPGProjectile>> InactiveProjectiles;
+};
+
+/**
+ * Pool de projéteis por mundo.
+ * Em vez de SpawnActorDeferred/Destroy a cada disparo, projéteis são pré-aquecidos por classe,
+ * reativados com novo transform/parâmetros de dano e devolvidos ao pool no impacto ou ao expirar.
+ *
+ * Fluxo de uso:
+ *   ARPGProjectile* P = Pool->AcquireProjectile(Class, Transform, Owner, Instigator);
+ *   // configurar dano / parâmetros
+ *   Pool->LaunchProjectile(P, Transform);
+ */
+UCLASS()
+class RPG_API URPGProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Cria Count projéteis inativos da classe para evitar hitches no primeiro uso */
+	UFUNCTION(BlueprintCallable, Category = "Projectile|Pool")
+	void PrewarmPool(TSubclassOf<ARPGProjectile> ProjectileClass, int32 Count);
+
+	/**
+	 * Retorna um projétil inativo, reutilizado do pool ou recém-criado (spawn deferred).
+	 * O projétil só é ativado em LaunchProjectile, depois que o chamador o configurar.
+	 */
+	ARPGProjectile* AcquireProjectile(TSubclassOf<ARPGProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator);
+
+	/** Ativa um projétil obtido com AcquireProjectile (FinishSpawning ou reativação do pool) */
+	void LaunchProjectile(ARPGProjectile* Projectile, const FTransform& SpawnTransform);
+
+	/** Devolve o projétil ao pool; destrói se o pool da classe estiver cheio */
+	void ReleaseProjectile(ARPGProjectile* Projectile);
+
+	/** Número de projéteis inativos disponíveis para a classe */
+	UFUNCTION(BlueprintPure, Category = "Projectile|Pool")
+	int32 GetNumPooledProjectiles(TSubclassOf<ARPGProjectile> ProjectileClass) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Spawn deferred de um novo projétil já marcado como pertencente ao pool */
+	ARPGProjectile* SpawnPooledProjectile(TSubclassOf<ARPGProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator);
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FRPGProjectilePoolBucket> Pools;
+
+	// Limite de projéteis inativos mantidos por classe
+	const int32 MAX_POOLED_PER_CLASS = 64;
+};
@@ -0,0 +1,25 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Actor/RPGProjectileSimulationSubsystem.h"
+#include "RPGProjectileSimulationProxy.generated.h"
+
+/**
+ * Canal de rede do URPGProjectileSimulationSubsystem (subsystems não replicam).
+ * Criado pelo servidor; repassa cada disparo simulado aos clientes, que rodam
+ * uma simulação apenas visual (sem dano) com os mesmos parâmetros de spawn.
+ */
+UCLASS(NotPlaceable, Transient)
+class RPG_API ARPGProjectileSimulationProxy : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	ARPGProjectileSimulationProxy();
+
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastSpawnProjectiles(const TArray<FTransform>& SpawnTransforms, const FRPGSimulatedProjectileParams& Params, AActor* SourceAvatar);
+};
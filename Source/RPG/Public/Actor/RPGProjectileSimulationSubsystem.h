@@ -0,0 +1,154 @@
+// Copyright Druid Mechanics
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/SparseArray.h"
+#include "RPGAbilityTypes.h"
+#include "RPGProjectileSimulationSubsystem.generated.h"
+
+class ARPGProjectileSimulationProxy;
+class UAbilitySystemComponent;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+// Parâmetros de spawn de um projétil simulado (sem ator próprio)
+USTRUCT(BlueprintType)
+struct FRPGSimulatedProjectileParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	float Speed = 550.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	float CollisionRadius = 16.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	float LifeSpan = 15.f;
+
+	/** Mesh opcional renderizado via ISM compartilhado (ignorado em servidor dedicado) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	TObjectPtr<UStaticMesh> VisualMesh = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	FVector VisualScale = FVector::OneVector;
+};
+
+// Lote de instâncias ISM de um mesmo mesh
+USTRUCT()
+struct FRPGProjectileVisualBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> InstancedMesh = nullptr;
+
+	// Instâncias ocultas (escala zero) prontas para reuso
+	TArray<int32> FreeInstances;
+};
+
+/**
+ * Simulação orientada a dados para projéteis em massa (rajadas, anéis de Fire Blast).
+ * O estado fica em arrays SoA, é integrado em um único tick (ParallelFor) e as colisões
+ * usam sweeps assíncronos em lote, resolvidos no frame seguinte. O dano passa pelo
+ * FDamageEffectParams existente. Dano apenas no servidor; cada disparo é repassado aos clientes
+ * pelo ARPGProjectileSimulationProxy, que rodam a mesma simulação só para os visuais (ISM local).
+ */
+UCLASS()
+class RPG_API URPGProjectileSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Dispara um projétil simulado. Retorna false se não houver autoridade/ASC de origem */
+	bool SpawnSimulatedProjectile(const FTransform& SpawnTransform, const FRPGSimulatedProjectileParams& Params, const FDamageEffectParams& DamageParams);
+
+	/** Dispara uma rajada que compartilha os mesmos parâmetros de dano. Retorna quantos foram criados */
+	int32 SpawnSimulatedProjectiles(TArrayView<const FTransform> SpawnTransforms, const FRPGSimulatedProjectileParams& Params, const FDamageEffectParams& DamageParams);
+
+	/**
+	 * Clientes: projéteis apenas visuais, recebidos do servidor. Percorrem os mesmos sweeps
+	 * para sumir no impacto, mas nunca aplicam dano.
+	 */
+	int32 SpawnVisualProjectiles(TArrayView<const FTransform> SpawnTransforms, const FRPGSimulatedProjectileParams& Params, AActor* SourceAvatar);
+
+	UFUNCTION(BlueprintPure, Category = "Projectile|Simulation")
+	int32 GetNumLiveProjectiles() const { return Positions.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Parâmetros de dano compartilhados por todos os projéteis de um disparo
+	// (fora do GC: o ASC de origem é validado pelo ponteiro fraco antes de aplicar dano)
+	struct FDamageEntry
+	{
+		FDamageEffectParams Params;
+		TWeakObjectPtr<UAbilitySystemComponent> SourceASC;
+		TWeakObjectPtr<AActor> SourceAvatar;
+		FCollisionQueryParams QueryParams;
+		int32 RefCount = 0;
+
+		// Réplica visual no cliente: colide normalmente, mas não aplica dano
+		bool bVisualOnly = false;
+	};
+
+	int32 AddDamageEntry(const FDamageEffectParams& DamageParams);
+	int32 AddVisualEntry(AActor* SourceAvatar);
+	void AddProjectiles(TArrayView<const FTransform> SpawnTransforms, const FRPGSimulatedProjectileParams& Params, int32 DamageEntryIndex);
+	void AddProjectile(const FTransform& SpawnTransform, const FRPGSimulatedProjectileParams& Params, int32 DamageEntryIndex);
+
+	/** Proxy replicado usado para repassar disparos aos clientes (criado sob demanda no servidor) */
+	ARPGProjectileSimulationProxy* GetReplicationProxy();
+
+	// Etapas do tick
+	void ResolvePendingSweeps(TArray<bool>& OutKill);
+	void RemoveDeadProjectiles(const TArray<bool>& Kill);
+	void IntegrateProjectiles(float DeltaTime);
+	void IssueSweeps();
+	void UpdateVisuals();
+
+	/** Aplica dano ao primeiro alvo hostil do sweep. Retorna true se o projétil deve morrer */
+	bool HandleSweepHits(int32 Index, const TArray<FHitResult>& Hits);
+
+	// Visuais
+	int32 AcquireVisualInstance(UStaticMesh* Mesh, int32& OutBatchIndex);
+	void ReleaseVisualInstance(int32 BatchIndex, int32 InstanceIndex);
+	bool ShouldRenderVisuals() const;
+
+	// === ESTADO SoA (um índice por projétil vivo) ===
+	TArray<FVector> Positions;
+	TArray<FVector> PreviousPositions;
+	TArray<FVector> Velocities;
+	TArray<float> CollisionRadii;
+	TArray<float> RemainingLifeSpans;
+	TArray<int32> DamageEntryIndices;
+	TArray<FTraceHandle> PendingSweeps;
+	TArray<int32> VisualBatchIndices;
+	TArray<int32> VisualInstanceIndices;
+	TArray<FVector> VisualScales;
+
+	TSparseArray<FDamageEntry> DamageEntries;
+
+	UPROPERTY()
+	TArray<FRPGProjectileVisualBatch> VisualBatches;
+
+	TMap<TObjectPtr<UStaticMesh>, int32> VisualBatchByMesh;
+
+	// Ator que hospeda os componentes ISM
+	UPROPERTY()
+	TObjectPtr<AActor> VisualsActor = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<ARPGProjectileSimulationProxy> ReplicationProxy = nullptr;
+
+	// Tamanho mínimo de lote para o ParallelFor de integração
+	const int32 INTEGRATION_BATCH_SIZE = 64;
+};
@@ -0,0 +1,102 @@
+// Copyright (c) 2025 RPG Yumi Project. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "GameplayTagContainer.h"
+#include "GenericTeamAgentInterface.h"
+#include "ANS_SendTargetGroup.generated.h"
+
+/**
+ * Animation Notify State variant of UAN_SendTargetGroup.
+ * Samples the socket chain every frame of the window and sub-steps between samples at a fixed rate,
+ * sweeping the volume swept by the weapon so hit registration does not depend on frame rate.
+ * Each actor is reported at most once per window.
+ */
+UCLASS()
+class RPG_API UANS_SendTargetGroup : public UAnimNotifyState
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
+	virtual void NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime, const FAnimNotifyEventReference& EventReference) override;
+	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+
+private:
+	/** Gameplay cue tags to trigger on hit */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	FGameplayTagContainer TriggerGameplayCueTags;
+
+	/** Team attitude to target (Hostile, Friendly, Neutral) */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	TEnumAsByte<ETeamAttitude::Type> TargetTeam = ETeamAttitude::Hostile;
+
+	/** Radius of the sphere sweep for target detection */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	float SphereSweepRadius = 60.f;
+
+	/** Maximum time between two sampled poses; longer frames are sub-stepped */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability", meta = (ClampMin = "0.001"))
+	float SubstepInterval = 1.f / 60.f;
+
+	/** Upper bound of sub-steps per frame (protects against hitches) */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability", meta = (ClampMin = "1"))
+	int32 MaxSubstepsPerFrame = 8;
+
+	/** Whether to draw debug traces */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	bool bDrawDebug = false;
+
+	/** Whether to ignore the owner actor in traces */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	bool bIgnoreOwner = true;
+
+	/** Event tag to send with target data */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	FGameplayTag EventTag;
+
+	/** Socket names forming the weapon chain */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	TArray<FName> TargetSocketNames;
+
+	/**
+	 * Use the equipped weapon's combat sockets (resolved once per equip by ARPGCharacter) as the chain
+	 * instead of TargetSocketNames. Falls back to TargetSocketNames when the owner has fewer than two.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	bool bUseWeaponCombatSockets = false;
+
+	/** Per-mesh state for the active window (notify states are shared between instances) */
+	struct FSweepWindow
+	{
+		/** Socket locations in component space at the previous sample */
+		TArray<FVector> PreviousSocketLocations;
+
+		/** Component transform at the previous sample (blended with the current one while sub-stepping) */
+		FTransform PreviousComponentTransform;
+
+		/** Scratch buffer for the current sample */
+		TArray<FVector> CurrentSocketLocations;
+
+		/** Chain read from the owner's weapon socket cache instead of TargetSocketNames */
+		bool bWeaponSockets = false;
+
+		/** Actors already reported during this window */
+		TSet<TWeakObjectPtr<AActor>> HitActors;
+
+		FCollisionQueryParams QueryParams;
+		TArray<FHitResult> HitResults;
+	};
+
+	TMap<TWeakObjectPtr<USkeletalMeshComponent>, FSweepWindow> ActiveWindows;
+
+	void SampleSocketLocations(const USkeletalMeshComponent* MeshComp, const FSweepWindow& Window, TArray<FVector>& OutLocations) const;
+
+	/** Sweeps from the previous sample to the current one and sends newly hit targets */
+	void SweepWindow(USkeletalMeshComponent* MeshComp, FSweepWindow& Window, float DeltaTime);
+
+	/** Sweeps one segment and appends valid, not yet reported hits to the event data */
+	void SweepSegment(USkeletalMeshComponent* MeshComp, FSweepWindow& Window, const FVector& Start, const FVector& End, FGameplayEventData& OutData) const;
+};
@@ -20,6 +20,15 @@ class RPG_API UAN_SendTargetGroup : public UAnimNotify
 public:	
 	virtual void Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
 
+	/** Executes each gameplay cue tag locally at the hit location (shared with UANS_SendTargetGroup) */
+	static void SendLocalGameplayCues(const FGameplayTagContainer& GameplayCueTags, const FHitResult& HitResult);
+
+	/**
+	 * World locations of the owner's cached weapon combat sockets (ARPGCharacter), without name lookups.
+	 * Returns false, leaving OutLocations empty, when the owner has fewer than two (shared with UANS_SendTargetGroup).
+	 */
+	static bool GetWeaponCombatSocketLocations(const AActor* OwnerActor, TArray<FVector, TInlineAllocator<8>>& OutLocations);
+
 private:
 	/** Gameplay cue tags to trigger on hit */
 	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
@@ -49,6 +58,13 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
 	TArray<FName> TargetSocketNames;
 
+	/**
+	 * Trace between the equipped weapon's combat sockets (resolved once per equip by ARPGCharacter)
+	 * instead of TargetSocketNames. Falls back to TargetSocketNames when the owner has fewer than two.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	bool bUseWeaponCombatSockets = false;
+
 	/** Send local gameplay cue to hit result */
 	void SendLocalGameplayCue(const FHitResult& HitResult) const;
 };
@@ -71,6 +71,15 @@ public:
     UFUNCTION(BlueprintPure, Category = "Combat|Sockets")
     TArray<FVector> GetCurrentWeaponCombatSocketLocations() const;
 
+    /** Número de sockets de combate resolvidos para a arma atual */
+    int32 GetNumWeaponCombatSockets() const;
+
+    /**
+     * Escreve as posições dos sockets de combate em um buffer do chamador, sem buscas por nome
+     * nem alocações. Retorna quantas posições foram escritas (no máximo OutLocations.Num()).
+     */
+    int32 WriteWeaponCombatSocketLocations(TArrayView<FVector> OutLocations) const;
+
     UFUNCTION(BlueprintPure, Category = "Equipment|Runtime")
     UMeshComponent* GetEquippedMeshForSlot(EEquipmentSlot Slot) const;
 
@@ -274,4 +283,23 @@ private:
 
     FTimerHandle DeathTimer;
     bool bAttributesInitialized = false;
+
+    // === CACHE DE SOCKETS DE COMBATE ===
+    // Socket resolvido: posição = SocketLocalTransform * transform do osso no componente
+    struct FCachedCombatSocket
+    {
+        TWeakObjectPtr<const USkeletalMeshComponent> Component;
+        int32 BoneIndex = INDEX_NONE;
+        FTransform SocketLocalTransform = FTransform::Identity;
+    };
+
+    /** Resolve sockets (componente, osso, transform local) e nomes da arma equipada */
+    void RebuildWeaponCombatSocketCache() const;
+    void EnsureWeaponCombatSocketCache() const;
+    static bool ResolveCombatSocket(const USkeletalMeshComponent* SkelComp, FName SocketName, FCachedCombatSocket& OutSocket);
+
+    mutable TArray<FCachedCombatSocket> CachedWeaponCombatSockets;
+    mutable TArray<FName> CachedWeaponCombatSocketNames;
+    mutable FName CachedWeaponCombatSocketName = NAME_None;
+    mutable bool bWeaponCombatSocketCacheValid = false;
 };
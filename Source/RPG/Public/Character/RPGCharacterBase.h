@@ -7,6 +7,7 @@
 
 #include "Interaction/CombatInterface.h"
 #include "GenericTeamAgentInterface.h"
+#include "Perception/AISightTargetInterface.h"
 #include "RPGTeam.h"
 #include "RPGCharacterBase.generated.h"
 
@@ -19,9 +20,11 @@ class UGameplayAbility;
 class UAnimMontage;
 class USkeletalMeshComponent;
 class URPGCustomMovementComponent;
+class USkeletalMeshSocket;
+class USkinnedAsset;
 
 UCLASS(Abstract)
-class RPG_API ARPGCharacterBase : public ACharacter, public IAbilitySystemInterface, public ICombatInterface, public IGenericTeamAgentInterface
+class RPG_API ARPGCharacterBase : public ACharacter, public IAbilitySystemInterface, public ICombatInterface, public IGenericTeamAgentInterface, public IAISightTargetInterface
 {
 	GENERATED_BODY()
 
@@ -51,6 +54,10 @@ public:
 	virtual int32 GetMinionCount_Implementation() override;
 	virtual void IncremenetMinionCount_Implementation(int32 Amount) override;
 
+	// AI Sight Target Interface (linha de visão assíncrona via URPGSightTraceSubsystem)
+	virtual UAISense_Sight::EVisibilityResult CanBeSeenFrom(const FCanBeSeenFromContext& Context, FVector& OutSeenLocation, int32& OutNumberOfLoSChecksPerformed,
+		int32& OutNumberOfAsyncLosCheckRequested, float& OutSightStrength, int32* UserData = nullptr, const FOnPendingVisibilityQueryProcessedDelegate* Delegate = nullptr) override;
+
 	virtual FOnASCRegistered& GetOnASCRegisteredDelegate() override;
 	virtual void SetIsBeingShocked_Implementation(bool bInShock) override;
 	virtual bool IsBeingShocked_Implementation() const override;
@@ -101,6 +108,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat")
 	FName LeftHandSocketName = "LeftHandSocket";
 
+	/** Sockets da mesh testados pela visão das IAs (visível se qualquer um estiver desobstruído). Vazio = centro do ator */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI")
+	TArray<FName> SightTargetSocketNames;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat")
 	TObjectPtr<UMaterialInstance> WeaponDissolveMaterialInstance;
 
@@ -112,6 +123,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(BlueprintReadOnly)
 	bool bDead = false;
@@ -174,8 +186,22 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Combat")
 	TObjectPtr<UAnimMontage> HitReactMontage;
 
+	/** SightTargetSocketNames resolvidos na mesh atual: socket da mesh ou, na falta dele, osso */
+	struct FSightTargetPoint
+	{
+		const USkeletalMeshSocket* Socket = nullptr;
+		int32 BoneIndex = INDEX_NONE;
+	};
+
+	/** Reconstrói SightTargetPoints quando a mesh do personagem muda */
+	void ResolveSightTargetPoints(const USkeletalMeshComponent& MeshComponent);
+
+	TArray<FSightTargetPoint> SightTargetPoints;
+	TWeakObjectPtr<const USkinnedAsset> SightTargetPointsAsset;
+	bool bSightTargetPointsResolved = false;
+
 protected:
-	virtual void SetGenericTeamId(const FGenericTeamId& InTeamID) override { TeamID = InTeamID; }
+	virtual void SetGenericTeamId(const FGenericTeamId& InTeamID) override;
 	virtual FGenericTeamId GetGenericTeamId() const override { return TeamID; }
 	
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Team")
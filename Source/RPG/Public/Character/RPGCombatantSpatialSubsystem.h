@@ -0,0 +1,113 @@
+// Copyright (c) 2025 RPG Yumi Project. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "Containers/SparseArray.h"
+#include "GenericTeamAgentInterface.h"
+#include "RPGCombatantSpatialSubsystem.generated.h"
+
+class ARPGCharacterBase;
+
+// Filtro de time aplicado às consultas
+enum class ERPGCombatantTeamFilter : uint8
+{
+	Any,
+	SameTeam,
+	OtherTeam
+};
+
+// Filtros compartilhados por todas as consultas do hash espacial
+struct FRPGCombatantQueryFilter
+{
+	/** Inclui combatentes mortos (por padrão apenas vivos) */
+	bool bIncludeDead = false;
+
+	/** Soma o raio da cápsula do combatente ao teste de distância (equivale a um overlap com a cápsula) */
+	bool bInflateByBounds = true;
+
+	ERPGCombatantTeamFilter TeamFilter = ERPGCombatantTeamFilter::Any;
+	FGenericTeamId TeamId = FGenericTeamId::NoTeam;
+
+	const AActor* IgnoredActor = nullptr;
+	TArrayView<AActor* const> IgnoredActors;
+};
+
+/**
+ * Hash espacial uniforme (plano XY) com todos os combatentes vivos do mundo.
+ * Cada ARPGCharacterBase se registra no BeginPlay; a célula é atualizada pelo
+ * TransformUpdated do componente raiz, e time/estado de vida ficam inline na entrada.
+ * Responde consultas de raio, cone, caixa e k-mais-próximos sem tocar na física.
+ */
+UCLASS()
+class RPG_API URPGCombatantSpatialSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	static URPGCombatantSpatialSubsystem* Get(const UObject* WorldContextObject);
+
+	// === REGISTRO ===
+	void RegisterCombatant(ARPGCharacterBase* Combatant);
+	void UnregisterCombatant(ARPGCharacterBase* Combatant);
+	void SetCombatantAlive(const ARPGCharacterBase* Combatant, bool bAlive);
+	void SetCombatantTeam(const ARPGCharacterBase* Combatant, FGenericTeamId TeamId);
+
+	// === CONSULTAS (anexam a OutActors, cada combatente no máximo uma vez; retornam quantos foram adicionados) ===
+	int32 QueryRadius(const FVector& Origin, float Radius, const FRPGCombatantQueryFilter& Filter, TArray<AActor*>& OutActors) const;
+	int32 QueryCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees, const FRPGCombatantQueryFilter& Filter, TArray<AActor*>& OutActors) const;
+	int32 QueryBox(const FTransform& BoxTransform, const FVector& HalfExtent, const FRPGCombatantQueryFilter& Filter, TArray<AActor*>& OutActors) const;
+
+	/** Até MaxResults combatentes mais próximos dentro de MaxRadius, ordenados por distância */
+	int32 QueryNearest(const FVector& Origin, int32 MaxResults, float MaxRadius, const FRPGCombatantQueryFilter& Filter, TArray<AActor*>& OutActors) const;
+
+	UFUNCTION(BlueprintPure, Category = "Combat|Spatial")
+	int32 GetNumCombatants() const { return Entries.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FCombatantEntry
+	{
+		TWeakObjectPtr<ARPGCharacterBase> Combatant;
+		TWeakObjectPtr<USceneComponent> RootComponent;
+		FDelegateHandle TransformUpdatedHandle;
+		FVector Location = FVector::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		float BoundsRadius = 0.f;
+		float BoundsSegmentHalfLength = 0.f;
+		FGenericTeamId TeamId = FGenericTeamId::NoTeam;
+		bool bAlive = true;
+	};
+
+	using FCellEntries = TArray<int32, TInlineAllocator<8>>;
+
+	FIntPoint GetCell(const FVector& Location) const;
+	void AddToCell(int32 EntryIndex, const FIntPoint& Cell);
+	void RemoveFromCell(int32 EntryIndex, const FIntPoint& Cell);
+	void OnCombatantTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, int32 EntryIndex);
+
+	bool PassesFilter(const FCombatantEntry& Entry, const FRPGCombatantQueryFilter& Filter) const;
+
+	/** Ponto do eixo da cápsula mais próximo de Point (o próprio centro se bInflateByBounds for false) */
+	static FVector GetClosestAxisPoint(const FCombatantEntry& Entry, const FVector& Point, bool bInflateByBounds);
+
+	/** Visita cada entrada das células que cobrem o retângulo XY [Min, Max] */
+	template <typename FunctorType>
+	void ForEachEntryInBounds(const FVector& Min, const FVector& Max, FunctorType&& Functor) const;
+
+	TSparseArray<FCombatantEntry> Entries;
+	TMap<FIntPoint, FCellEntries> Cells;
+	TMap<TObjectKey<ARPGCharacterBase>, int32> EntryIndexByCombatant;
+
+	// Maior raio de cápsula já registrado: margem das células visitadas quando bInflateByBounds
+	float MaxBoundsRadius = 0.f;
+
+	// Tamanho da célula (cm); próximo do raio típico das consultas de combate
+	const float CELL_SIZE = 500.f;
+};
@@ -16,5 +16,7 @@ class RPG_API URPGCustomMovementComponent : public UCharacterMovementComponent
 
 public:
 	URPGCustomMovementComponent(const FObjectInitializer& ObjectInitializer);
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 };
 
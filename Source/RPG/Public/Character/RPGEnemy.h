@@ -65,6 +65,8 @@ public:
 	float LifeSpan = 5.f;
 
 	void SetLevel(int32 InLevel) { Level = InLevel; }
+
+	FName GetSquadId() const { return SquadId; }
 protected:
 	virtual void BeginPlay() override;
 	virtual void InitAbilityActorInfo() override;
@@ -75,6 +77,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
 	TObjectPtr<UBehaviorTree> BehaviorTree;
 
+	/** Inimigos com o mesmo SquadId compartilham a percepção (visão/audição) do grupo. None = percepção própria */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+	FName SquadId = NAME_None;
+
 	UPROPERTY()
 	TObjectPtr<ARPGAIController> RPGAIController;
 
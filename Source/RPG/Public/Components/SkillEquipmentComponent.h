@@ -4,15 +4,71 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "GameplayTagContainer.h"
+#include "GameplayAbilitySpecHandle.h"
 #include "SkillEquipmentComponent.generated.h"
 
 class ARPGCharacter;
 class USkillTreeSubsystem;
+class UGameplayAbility;
+class UAbilitySystemComponent;
 
 // Delegate para notificar mudanças de equipamento
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnSkillEquipmentEquipped, FName, CharacterID, FName, SlotID, FName, SkillID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnSkillEquipmentUnequipped, FName, CharacterID, FName, SlotID, FName, SkillID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnSkillEquippedInSlot, FName, SlotID, FName, SkillID, UTexture2D*, SkillIcon);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSkillLoadoutPresetApplied, FName, CharacterID, FName, PresetName);
+
+/**
+ * Slot de um preset de loadout (SlotID -> SkillID + InputTag)
+ * A classe da habilidade é resolvida uma única vez quando o preset é salvo
+ */
+USTRUCT(BlueprintType)
+struct FSkillLoadoutSlot
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkillEquipment|Loadout")
+    FName SlotID = NAME_None;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkillEquipment|Loadout")
+    FName SkillID = NAME_None;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkillEquipment|Loadout")
+    FGameplayTag InputTag;
+
+    /** Classe da habilidade pré-resolvida (preenchida ao salvar o preset) */
+    UPROPERTY(BlueprintReadOnly, Category = "SkillEquipment|Loadout")
+    TSubclassOf<UGameplayAbility> AbilityClass = nullptr;
+};
+
+/**
+ * Preset nomeado de loadout de habilidades
+ */
+USTRUCT(BlueprintType)
+struct FSkillLoadoutPreset
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkillEquipment|Loadout")
+    TArray<FSkillLoadoutSlot> Slots;
+};
+
+/**
+ * Habilidade concedida via GAS por este componente
+ */
+USTRUCT()
+struct FGrantedSkillEntry
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FGameplayAbilitySpecHandle Handle;
+
+    /** InputTag atualmente ligada ao spec (vazia = concedida mas sem input) */
+    UPROPERTY()
+    FGameplayTag BoundInputTag;
+};
 
 /**
  * Componente dedicado para gerenciar equipamento de habilidades
@@ -108,6 +164,57 @@ public:
     UFUNCTION(BlueprintPure, Category = "SkillEquipment")
     UTexture2D* GetDefaultSlotIcon() const;
     
+    // === PRESETS DE LOADOUT ===
+    
+    /** Salva um preset de loadout, resolvendo as classes das habilidades uma única vez */
+    UFUNCTION(BlueprintCallable, Category = "SkillEquipment|Loadout")
+    bool SaveLoadoutPreset(const FName& PresetName, const TArray<FSkillLoadoutSlot>& Slots);
+    
+    /** Salva o loadout atualmente equipado como preset */
+    UFUNCTION(BlueprintCallable, Category = "SkillEquipment|Loadout")
+    bool SaveCurrentLoadoutAsPreset(const FName& PresetName);
+    
+    /** Remove um preset de loadout */
+    UFUNCTION(BlueprintCallable, Category = "SkillEquipment|Loadout")
+    bool RemoveLoadoutPreset(const FName& PresetName);
+    
+    /** Verifica se um preset existe */
+    UFUNCTION(BlueprintPure, Category = "SkillEquipment|Loadout")
+    bool HasLoadoutPreset(const FName& PresetName) const { return LoadoutPresets.Contains(PresetName); }
+    
+    /** Retorna os nomes de todos os presets */
+    UFUNCTION(BlueprintPure, Category = "SkillEquipment|Loadout")
+    TArray<FName> GetLoadoutPresetNames() const;
+    
+    /** Retorna o preset ativo (NAME_None se nenhum) */
+    UFUNCTION(BlueprintPure, Category = "SkillEquipment|Loadout")
+    FName GetActiveLoadoutPreset() const { return ActiveLoadoutPreset; }
+    
+    /**
+     * Aplica um preset de loadout. Compara o loadout atual com o alvo e só
+     * desequipa/equipa os slots que realmente mudaram.
+     */
+    UFUNCTION(BlueprintCallable, Category = "SkillEquipment|Loadout")
+    bool ApplyLoadoutPreset(const FName& PresetName);
+    
+    /**
+     * Concede antecipadamente (sem InputTag) todas as habilidades de um preset.
+     * Trocas posteriores só religam a InputTag, sem GiveAbility/ClearAbility.
+     */
+    UFUNCTION(BlueprintCallable, Category = "SkillEquipment|Loadout")
+    void PreGrantLoadoutPreset(const FName& PresetName);
+    
+    /** Remove do GAS todas as habilidades concedidas mas sem InputTag ligada */
+    UFUNCTION(BlueprintCallable, Category = "SkillEquipment|Loadout")
+    void ClearUnboundGrantedSkills();
+    
+    /**
+     * Se verdadeiro, habilidades desequipadas continuam concedidas no GAS apenas
+     * com a InputTag removida, evitando o custo de GiveAbility/ClearAbility em combate.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkillEquipment|Loadout")
+    bool bKeepUnequippedSkillsGranted = false;
+    
     // === UTILIDADES ===
     
     /** Retorna o número de slots ativos (com habilidades equipadas) */
@@ -132,6 +239,10 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "SkillEquipment")
     FOnSkillEquippedInSlot OnSkillEquippedInSlot;
     
+    /** Disparado quando um preset de loadout é aplicado */
+    UPROPERTY(BlueprintAssignable, Category = "SkillEquipment|Loadout")
+    FOnSkillLoadoutPresetApplied OnSkillLoadoutPresetApplied;
+    
 protected:
     // === DADOS INTERNOS ===
     
@@ -139,6 +250,26 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "SkillEquipment")
     TMap<FName, FName> EquippedSkills;
     
+    /** InputTag usada ao equipar cada slot (SlotID -> InputTag) */
+    UPROPERTY()
+    TMap<FName, FGameplayTag> EquippedSlotInputTags;
+    
+    /** Presets de loadout nomeados deste personagem */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SkillEquipment|Loadout")
+    TMap<FName, FSkillLoadoutPreset> LoadoutPresets;
+    
+    /** Preset aplicado por último */
+    UPROPERTY(BlueprintReadOnly, Category = "SkillEquipment|Loadout")
+    FName ActiveLoadoutPreset = NAME_None;
+    
+    /** Habilidades concedidas via GAS por este componente (SkillID -> spec) */
+    UPROPERTY()
+    TMap<FName, FGrantedSkillEntry> GrantedSkills;
+    
+    /** Cache SkillID -> classe da habilidade (evita varrer o DataTable a cada equip) */
+    UPROPERTY()
+    TMap<FName, TSubclassOf<UGameplayAbility>> SkillAbilityClassCache;
+    
     // === HELPERS ===
     
     /** Valida com o SkillTreeSubsystem */
@@ -147,9 +278,24 @@ protected:
     /** Concede uma habilidade ao personagem via GAS */
     void GrantSkillToCharacter(const FName& SkillID, const FGameplayTag& SlotInputTag);
     
+    /** Concede (ou religa a InputTag de) uma habilidade já resolvida */
+    void GrantResolvedSkill(const FName& SkillID, TSubclassOf<UGameplayAbility> AbilityClass, const FGameplayTag& SlotInputTag);
+    
     /** Remove uma habilidade do personagem via GAS */
     void RemoveSkillFromCharacter(const FName& SkillID);
     
+    /** Resolve a classe da habilidade pelo cache (reconstrói a partir do DataTable se necessário) */
+    TSubclassOf<UGameplayAbility> ResolveSkillAbilityClass(const FName& SkillID);
+    
+    /** Reconstrói o cache SkillID -> classe a partir do DataTable do personagem */
+    void RebuildSkillAbilityClassCache();
+    
+    /** Retorna o ASC do personagem dono */
+    UAbilitySystemComponent* GetOwnerAbilitySystemComponent() const;
+    
+    /** Equipa um slot de preset já resolvido (sem revalidar no SkillTreeSubsystem) */
+    void EquipResolvedSlot(const FSkillLoadoutSlot& LoadoutSlot);
+    
     // === EVENTOS ===
     
     /** Conecta aos eventos do SkillTreeSubsystem */
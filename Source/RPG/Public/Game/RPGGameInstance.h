@@ -7,6 +7,8 @@
 #include "Quest/QuestDataAsset.h"
 #include "RPGGameInstance.generated.h"
 
+class UCurveTable;
+
 /**
  * 
  */
@@ -33,6 +35,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quest System")
 	TArray<UQuestDataAsset*> QuestDataAssets;
 
+	// === PROGRESSION SYSTEM ===
+
+	/** CurveTable com as curvas de XP e recompensas por nível (opcional) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Progression")
+	TObjectPtr<UCurveTable> ProgressionCurveTable;
+
 protected:
 	/** Inicialização do Game Instance */
 	virtual void Init() override;
@@ -4,9 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "AbilitySystem/Data/EnemyClassInfo.h"
 #include "RPGGameModeBase.generated.h"
 
-class UEnemyClassInfo;
 class UPlayerClassInfo;
 
 /**
@@ -30,10 +30,20 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Skill Trees")
 	TMap<FName, UDataTable*> CharacterSkillTables;
 
+	// === BASELINES DE ATRIBUTOS DE INIMIGOS ===
+	// Preenchidos sob demanda na primeira inicialização de cada (classe, nível); vivem com a partida
+	const FEnemyAttributeBaseline* FindEnemyAttributeBaseline(ECharacterClass CharacterClass, int32 Level) const;
+	void StoreEnemyAttributeBaseline(ECharacterClass CharacterClass, int32 Level, FEnemyAttributeBaseline&& Baseline);
+
 protected:
 	virtual void BeginPlay() override;
 
 	/** Configura as árvores de habilidades por personagem */
 	UFUNCTION(BlueprintCallable, Category="Skill Trees")
 	void SetupSkillTrees();
+
+private:
+	static uint32 MakeEnemyAttributeBaselineKey(ECharacterClass CharacterClass, int32 Level);
+
+	TMap<uint32, FEnemyAttributeBaseline> EnemyAttributeBaselines;
 };
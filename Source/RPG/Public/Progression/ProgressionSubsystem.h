@@ -7,6 +7,7 @@
 #include "ProgressionSubsystem.generated.h"
 
 class ARPGCharacter;
+class UCurveTable;
 
 // Delegate para level up
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCharacterLevelUp, ARPGCharacter*, Character, int32, NewLevel);
@@ -55,6 +56,26 @@ class RPG_API UProgressionSubsystem : public UGameInstanceSubsystem
 	GENERATED_BODY()
 
 public:
+	// Inicializa o subsistema e pré-calcula as tabelas de progressão
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// Finaliza o subsistema
+	virtual void Deinitialize() override;
+
+	// === CURVAS DE PROGRESSÃO ===
+
+	/**
+	 * Define a CurveTable com as curvas de progressão e reconstrói as tabelas.
+	 * Linhas reconhecidas: BaseXP, XPMultiplier, AttributePointsReward, SpellPointsReward.
+	 * Linhas ausentes usam os valores padrão hardcoded.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Progression")
+	void SetProgressionCurveTable(UCurveTable* InCurveTable);
+
+	// Obtém a CurveTable de progressão atual
+	UFUNCTION(BlueprintPure, Category = "Progression")
+	UCurveTable* GetProgressionCurveTable() const { return ProgressionCurveTable; }
+
 	// === GETTERS ===
 	
 	// Obtém o nível de um personagem.
@@ -121,6 +142,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Progression")
 	void AddGroupXPViaGAS(int32 XPToAdd);
 
+	/**
+	 * Adiciona XP para todos os personagens do grupo pelo caminho nativo em lote.
+	 * Várias chamadas no mesmo frame são acumuladas e aplicadas em uma única passada
+	 * no próximo tick, com um único conjunto de eventos de level up/XP por personagem.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Progression")
+	void AddGroupXPBatched(int32 XPToAdd);
+
 	// === CÁLCULOS DE PROGRESSÃO ===
 	
 	// Calcula o nível baseado no XP usando multiplicadores dinâmicos
@@ -181,6 +210,58 @@ private:
 	
 	// Pontos de magia base por nível
 	const int32 BASE_SPELL_POINTS = 1;
+
+	// Nível máximo suportado pelas tabelas de progressão
+	const int32 MAX_LEVEL = 999;
+
+	// OTIMIZAÇÃO: tabelas pré-calculadas indexadas por nível (0..MAX_LEVEL + 1)
+	// XP acumulado necessário para atingir cada nível (saturado em MAX_int32)
+	TArray<int32> XPThresholdTable;
+
+	// Soma dos pontos de atributo/magia recebidos do nível 1 até cada nível
+	TArray<int32> CumulativeAttributePointsTable;
+	TArray<int32> CumulativeSpellPointsTable;
+
+	// CurveTable com as curvas de progressão (opcional)
+	UPROPERTY()
+	TObjectPtr<UCurveTable> ProgressionCurveTable;
+
+	// Constrói as tabelas de XP e recompensas a partir da curva
+	void BuildProgressionTables();
+
+	// Avalia uma linha da CurveTable. Retorna false se a linha não existir.
+	bool EvaluateProgressionCurve(FName RowName, int32 Level, float& OutValue) const;
+
+	// XP base para o nível 1 (da CurveTable ou BASE_XP)
+	float GetBaseXP() const;
+
+#if WITH_EDITOR
+	// Hot reload: reconstrói as tabelas quando a CurveTable é editada
+	void HandleProgressionCurveTableChanged();
+
+	FDelegateHandle CurveTableChangedHandle;
+#endif
+
+	// Verifica se as tabelas já foram construídas
+	bool AreProgressionTablesBuilt() const { return XPThresholdTable.Num() == MAX_LEVEL + 2; }
+
+	// Personagens registrados via EnsureCharacterDataExists (usado pelo XP em lote)
+	TMap<FName, TWeakObjectPtr<ARPGCharacter>> RegisteredCharacters;
+
+	// XP de grupo acumulado aguardando aplicação no próximo tick
+	int32 PendingGroupXP = 0;
+
+	// Handle do flush agendado para o próximo tick
+	FTimerHandle GroupXPFlushTimerHandle;
+
+	// Aplica o XP de grupo acumulado em uma única passada
+	void FlushPendingGroupXP();
+
+	// Avalia a curva de XP diretamente (usado para montar a tabela)
+	int32 EvaluateXPCurve(int32 Level) const;
+
+	// Aplica todos os level ups pendentes de uma só vez. Retorna quantos níveis foram ganhos.
+	int32 ResolveLevelUps(FCharacterProgressionData& Data) const;
 	
 	UPROPERTY()
 	TMap<FName, FCharacterProgressionData> ProgressionDataMap;
@@ -7,6 +7,7 @@
 #include "GameplayTagContainer.h"
 #include "RPGBlueprintLibrary.generated.h"
 
+class UAbilitySystemComponent;
 struct FGameplayEventData;
 struct FOverlapResult;
 
@@ -56,8 +57,14 @@ public:
 	static TArray<AActor*> HitBoxOverlapTest(AActor* AvatarActor, float HitBoxRadius, float HitBoxForwardOffset = 0.f, float HitBoxElevationOffset = 0.f, bool bDrawDebugs = false);
 
 	static void DrawHitBoxOverlapDebugs(const UObject* WorldContextObject, const TArray<FOverlapResult>& OverlapResults, const FVector& HitBoxLocation, float HitBoxRadius);
+	static void DrawHitBoxActorDebugs(const UObject* WorldContextObject, const TArray<AActor*>& HitActors, const FVector& HitBoxLocation, float HitBoxRadius);
 
 	UFUNCTION(BlueprintCallable, Category = "RPG|Abilities")
 	static TArray<AActor*> ApplyKnockback(AActor* AvatarActor, const TArray<AActor*>& HitActors, float InnerRadius, float OuterRadius, float LaunchForceMagnitude, float RotationAngle = 45.f, bool bDrawDebugs = false);
+
+private:
+
+	/** Envia o evento de dano ao alvo e retorna o seu ASC (nullptr se o alvo for inválido ou estiver morto) */
+	static UAbilitySystemComponent* SendDamageEventOnly(AActor* Target, FGameplayEventData& Payload, float Damage, const FGameplayTag& EventTagOverride, UObject* OptionalParticleSystem);
 };
 